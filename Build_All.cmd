@@ -4,6 +4,8 @@ MSBuild.exe FanControlComponent\FanControlComponent.sln /p:Configuration=Release
 MSBuild.exe FanControlComponent\FanControlComponent.sln /p:Configuration=Debug /t:Clean
 MSBuild.exe FanControlComponent_Gtest\FanControlComponent.sln /p:Configuration=Release /t:Clean
 MSBuild.exe FanControlComponent_Gtest\FanControlComponent.sln /p:Configuration=Debug /t:Clean
+MSBuild.exe FanControlComponent_Bench\FanControlComponent.sln /p:Configuration=Release /t:Clean
+MSBuild.exe FanControlComponent_Bench\FanControlComponent.sln /p:Configuration=Debug /t:Clean
 MSBuild.exe FanControlComponent_UI\FanControlComponent.sln /p:Configuration=Release /t:Clean
 MSBuild.exe FanControlComponent_UI\FanControlComponent.sln /p:Configuration=Debug /t:Clean
 MSBuild.exe FanControlComponent_Lib\FanControlComponent.sln /p:Configuration=Release /t:Clean
@@ -13,6 +15,8 @@ MSBuild.exe FanControlComponent\FanControlComponent.sln /p:Configuration=Release
 MSBuild.exe FanControlComponent\FanControlComponent.sln /p:Configuration=Debug /t:Rebuild
 MSBuild.exe FanControlComponent_Gtest\FanControlComponent.sln /p:Configuration=Release /t:Rebuild
 MSBuild.exe FanControlComponent_Gtest\FanControlComponent.sln /p:Configuration=Debug /t:Rebuild
+MSBuild.exe FanControlComponent_Bench\FanControlComponent.sln /p:Configuration=Release /t:Rebuild
+MSBuild.exe FanControlComponent_Bench\FanControlComponent.sln /p:Configuration=Debug /t:Rebuild
 MSBuild.exe FanControlComponent_UI\FanControlComponent.sln /p:Configuration=Release /t:Rebuild
 MSBuild.exe FanControlComponent_UI\FanControlComponent.sln /p:Configuration=Debug /t:Rebuild
 MSBuild.exe FanControlComponent_Lib\FanControlComponent.sln /p:Configuration=Release /t:Rebuild
@@ -0,0 +1,2 @@
+MSBuild.exe .\FanControlComponent_Bench\FanControlComponent.sln /p:Configuration=Release /t:Rebuild
+MSBuild.exe .\FanControlComponent_Bench\FanControlComponent.sln /p:Configuration=Debug /t:Rebuild
\ No newline at end of file
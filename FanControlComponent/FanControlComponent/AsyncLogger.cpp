@@ -0,0 +1,271 @@
+#include "AsyncLogger.h"
+
+#include <algorithm>
+#include <iostream>
+
+//
+// Name: Ring
+//
+// Description: Single producer (the owning thread), single consumer (the
+//    drainer) ring of records. The owning thread's thread_local and the
+//    logger share it, so records logged just before a thread exits are
+//    still drained.
+//
+class AsyncLogger::Ring
+{
+   static constexpr size_t MASK{ RING_CAPACITY - 1 };
+   static_assert(0 == (RING_CAPACITY & MASK), "AsyncLogger::RING_CAPACITY must be a power of two.");
+
+   std::unique_ptr<Record[]> records{ new Record[RING_CAPACITY] };
+   alignas(64) std::atomic<size_t> head{ 0 }; // Next write, producer only.
+   alignas(64) std::atomic<size_t> tail{ 0 }; // Next read, consumer only.
+
+public:
+   std::atomic<uint64_t> dropped{ 0 };
+
+   bool tryPush(const Record& record)
+   {
+      const auto pos{ head.load(std::memory_order_relaxed) };
+      if ((pos - tail.load(std::memory_order_acquire)) >= RING_CAPACITY)
+      {
+         return false;
+      }
+      records[pos & MASK] = record;
+      head.store(pos + 1, std::memory_order_release);
+      return true;
+   }
+
+   bool tryPop(Record& record)
+   {
+      const auto pos{ tail.load(std::memory_order_relaxed) };
+      if (pos == head.load(std::memory_order_acquire))
+      {
+         return false;
+      }
+      record = records[pos & MASK];
+      tail.store(pos + 1, std::memory_order_release);
+      return true;
+   }
+
+   bool empty() const
+   {
+      return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+   }
+};
+
+//
+// Name: instance
+//
+// Return: AsyncLogger& - The process wide logger, created on first use.
+//
+AsyncLogger& AsyncLogger::instance()
+{
+   static AsyncLogger logger;
+   return logger;
+}
+
+//
+// Name: AsyncLogger (ctor)
+//
+// Description: Starts the drainThread, writing to std::cout.
+//
+AsyncLogger::AsyncLogger()
+   : sink(&std::cout)
+{
+   batch.reserve(RING_CAPACITY);
+   drainThread = std::thread(&AsyncLogger::drainThreadMain, this);
+}
+
+//
+// Name: ~AsyncLogger (dtor)
+//
+// Description: Stops the drainThread, which drains whatever is left.
+//
+AsyncLogger::~AsyncLogger()
+{
+   {
+      std::lock_guard<std::mutex> guard(drainThreadMux);
+      drainThreadKeepAlive = false;
+   }
+   drainThreadCond.notify_one();
+
+   if (drainThread.joinable())
+   {
+      drainThread.join();
+   }
+}
+
+//
+// Name: push
+//
+// Description: Copies the record into the calling thread's ring, or counts
+//    it as dropped if the ring is full.
+//
+void AsyncLogger::push(const Record& record)
+{
+   auto& ring{ getThreadRing() };
+   if (!ring.tryPush(record))
+   {
+      ring.dropped.fetch_add(1, std::memory_order_relaxed);
+   }
+}
+
+//
+// Name: getThreadRing
+//
+// Description: The calling thread's ring, registered with the logger the
+//    first time the thread logs (the only time a log call takes a lock).
+//
+AsyncLogger::Ring& AsyncLogger::getThreadRing()
+{
+   thread_local std::shared_ptr<Ring> threadRing;
+
+   if (nullptr == threadRing)
+   {
+      threadRing = std::make_shared<Ring>();
+
+      std::lock_guard<std::mutex> guard(ringsMux);
+      rings.push_back(threadRing);
+   }
+   return *threadRing;
+}
+
+//
+// Name: flush
+//
+// Description: Drains and writes every queued record now. Records logged
+//    by the calling thread before the call are guaranteed to be written.
+//
+void AsyncLogger::flush()
+{
+   drain();
+}
+
+//
+// Name: setSink
+//
+// Description: Redirects the output, e.g. for tests. The stream must
+//    outlive the logger or be replaced before it is destroyed.
+//
+void AsyncLogger::setSink(std::ostream& newSink)
+{
+   std::lock_guard<std::mutex> guard(drainMux);
+   sink->flush();
+   sink = &newSink;
+}
+
+//
+// Name: drainThreadMain
+//
+// Description: Drains every DRAIN_INTERVAL_MS until the logger is destroyed.
+//
+void AsyncLogger::drainThreadMain()
+{
+   std::unique_lock<std::mutex> guard(drainThreadMux);
+   while (drainThreadKeepAlive)
+   {
+      drainThreadCond.wait_for(guard, std::chrono::milliseconds(DRAIN_INTERVAL_MS), [this]() { return !drainThreadKeepAlive; });
+
+      guard.unlock();
+      drain();
+      guard.lock();
+   }
+}
+
+//
+// Name: drain
+//
+// Description: Pops every ring, writes the records in timestamp order and
+//    reports dropped records, then flushes the sink once. Rings of threads
+//    that have exited are released once empty.
+//
+void AsyncLogger::drain()
+{
+   std::lock_guard<std::mutex> guard(drainMux);
+
+   std::vector<std::shared_ptr<Ring>> currentRings;
+   {
+      std::lock_guard<std::mutex> ringsGuard(ringsMux);
+      currentRings = rings;
+   }
+
+   uint64_t dropped{ 0 };
+   Record   record;
+   batch.clear();
+   for (const auto& ring : currentRings)
+   {
+      while (ring->tryPop(record))
+      {
+         batch.push_back(record);
+      }
+      dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+   }
+
+   std::stable_sort(batch.begin(), batch.end(), [](const Record& lhs, const Record& rhs) { return lhs.timestampNs < rhs.timestampNs; });
+
+   for (const auto& queued : batch)
+   {
+      format(queued);
+   }
+
+   if (0 != dropped)
+   {
+      totalDropped.fetch_add(dropped, std::memory_order_relaxed);
+      *sink << "AsyncLogger - WARNING: [" << dropped << "] log records dropped, log ring full.\n";
+   }
+
+   if (!batch.empty() || (0 != dropped))
+   {
+      sink->flush();
+   }
+
+   currentRings.clear();
+   {
+      // Once its thread has exited, rings holds the only reference to a ring.
+      std::lock_guard<std::mutex> ringsGuard(ringsMux);
+      rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::shared_ptr<Ring>& ring)
+      {
+         return (1 == ring.use_count()) && ring->empty();
+      }), rings.end());
+   }
+}
+
+//
+// Name: format
+//
+// Description: Writes one record, substituting its arguments for the "{}"
+//    in the site's format, in order.
+//
+void AsyncLogger::format(const Record& record)
+{
+   size_t argIdx{ 0 };
+
+   for (auto fmt{ record.site->format }; '\0' != *fmt; ++fmt)
+   {
+      if (('{' == fmt[0]) && ('}' == fmt[1]) && (argIdx < record.numArgs))
+      {
+         const auto& arg{ record.args[argIdx++] };
+         switch (arg.type)
+         {
+         case Arg::Type::INT:    *sink << arg.i; break;
+         case Arg::Type::UINT:   *sink << arg.u; break;
+         case Arg::Type::FLOAT:  *sink << arg.d; break;
+         case Arg::Type::BOOL:   *sink << ((0 != arg.u) ? "true" : "false"); break;
+         case Arg::Type::STRING: *sink << arg.s; break;
+         case Arg::Type::CHAR:   *sink << static_cast<char>(arg.i); break;
+         default: break;
+         }
+         ++fmt;
+      }
+      else
+      {
+         *sink << *fmt;
+      }
+   }
+
+   if (0 != record.suppressed)
+   {
+      *sink << " [" << record.suppressed << " similar messages suppressed]";
+   }
+   *sink << '\n';
+}
\ No newline at end of file
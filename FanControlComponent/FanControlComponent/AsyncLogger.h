@@ -0,0 +1,227 @@
+/*
+* Class: AsyncLogger
+*
+* Description: Logging that never blocks the caller. A log call copies a
+*     fixed-size binary Record (call site, timestamp, up to MAX_ARGS scalar
+*     or string literal arguments) into a ring owned by the calling thread
+*     and returns; no formatting, locking, allocation or I/O happens on the
+*     caller's thread. A background thread drains every thread's ring,
+*     orders the records by timestamp, formats them and writes them to the
+*     sink (std::cout by default).
+*
+*     When a thread's ring is full the record is dropped and counted, and
+*     the drop count is reported with the next drained batch.
+*
+*     Every call site is a static Site holding its format and level. A site
+*     with a minimum interval logs at most once per interval and counts the
+*     records it suppressed in between, so one misbehaving sender cannot
+*     flood the log. Levels below LOG_MIN_LEVEL are compiled out, see log.h.
+*
+*     Format strings use "{}" for each argument. String arguments must be
+*     literals (their pointer is stored, not their text).
+*
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+enum class LogLevel : int
+{
+     DBG   = 0
+   , INFO  = 1
+   , WARN  = 2
+   , ERR   = 3
+};
+
+class AsyncLogger final
+{
+public:
+   static constexpr size_t MAX_ARGS{ 4 };
+   static constexpr size_t RING_CAPACITY{ 512 };        // Records per thread, power of two.
+   static constexpr int    DRAIN_INTERVAL_MS{ 10 };
+
+   //
+   // Name: Site
+   //
+   // Description: One per log call site (function local static).
+   //
+   struct Site
+   {
+      const char*           format;
+      LogLevel              level;
+      int64_t               minIntervalNs;
+      std::atomic<int64_t>  nextAllowedNs{ 0 };
+      std::atomic<uint64_t> suppressed{ 0 };
+
+      Site(const char* fmt, LogLevel lvl, int minIntervalMs)
+         : format(fmt)
+         , level(lvl)
+         , minIntervalNs(static_cast<int64_t>(minIntervalMs) * 1'000'000)
+      {}
+   };
+
+   struct Arg
+   {
+      enum class Type : uint8_t
+      {
+           INT
+         , UINT
+         , FLOAT
+         , BOOL
+         , STRING
+         , CHAR
+      };
+
+      Type type{ Type::INT };
+      union
+      {
+         int64_t     i;
+         uint64_t    u;
+         double      d;
+         const char* s;
+      };
+
+      Arg() : i(0) {}
+   };
+
+   struct Record
+   {
+      const Site* site{ nullptr };
+      int64_t     timestampNs{ 0 };
+      uint64_t    suppressed{ 0 };   // Records the site suppressed since its previous record.
+      uint8_t     numArgs{ 0 };
+      Arg         args[MAX_ARGS];
+   };
+
+   static AsyncLogger& instance();
+
+   ~AsyncLogger();
+
+   AsyncLogger(const AsyncLogger&) = delete;
+   AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+   //
+   // Name: log
+   //
+   // Description: Queues a record for site with args, unless the site is
+   //    rate limited. Never blocks.
+   //
+   template <typename... Args>
+   static void log(Site& site, const Args&... args)
+   {
+      static_assert(sizeof...(Args) <= MAX_ARGS, "AsyncLogger: too many log arguments.");
+
+      const auto now{ nowNs() };
+      uint64_t suppressed{ 0 };
+      if (0 != site.minIntervalNs)
+      {
+         auto nextAllowed{ site.nextAllowedNs.load(std::memory_order_relaxed) };
+         if ((now < nextAllowed) ||
+             !site.nextAllowedNs.compare_exchange_strong(nextAllowed, now + site.minIntervalNs, std::memory_order_relaxed))
+         {
+            site.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return;
+         }
+         suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+      }
+
+      Record record;
+      record.site        = &site;
+      record.timestampNs = now;
+      record.suppressed  = suppressed;
+      record.numArgs     = static_cast<uint8_t>(sizeof...(Args));
+
+      size_t idx{ 0 };
+      (setArg(record.args[idx++], args), ...);
+
+      instance().push(record);
+   }
+
+   void flush();
+   void setSink(std::ostream& sink);
+   uint64_t getDropped() const { return totalDropped.load(std::memory_order_relaxed); }
+
+private:
+   class Ring;
+
+   std::mutex                         ringsMux;    // Guards rings.
+   std::vector<std::shared_ptr<Ring>> rings;
+
+   std::mutex                         drainMux;    // One drainer at a time, guards sink and batch.
+   std::ostream*                      sink;
+   std::vector<Record>                batch;
+   std::atomic<uint64_t>              totalDropped{ 0 };
+
+   std::thread                        drainThread;
+   std::mutex                         drainThreadMux;
+   std::condition_variable            drainThreadCond;
+   bool                               drainThreadKeepAlive{ true };
+
+   AsyncLogger();
+
+   static int64_t nowNs()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+   template <typename T>
+   static void setArg(Arg& arg, const T& value)
+   {
+      if constexpr (std::is_same_v<T, bool>)
+      {
+         arg.type = Arg::Type::BOOL;
+         arg.u    = value ? 1 : 0;
+      }
+      else if constexpr (std::is_same_v<T, char>)
+      {
+         arg.type = Arg::Type::CHAR;
+         arg.i    = value;
+      }
+      else if constexpr (std::is_enum_v<T>)
+      {
+         arg.type = Arg::Type::INT;
+         arg.i    = static_cast<int64_t>(value);
+      }
+      else if constexpr (std::is_floating_point_v<T>)
+      {
+         arg.type = Arg::Type::FLOAT;
+         arg.d    = static_cast<double>(value);
+      }
+      else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+      {
+         arg.type = Arg::Type::INT;
+         arg.i    = static_cast<int64_t>(value);
+      }
+      else if constexpr (std::is_integral_v<T>)
+      {
+         arg.type = Arg::Type::UINT;
+         arg.u    = static_cast<uint64_t>(value);
+      }
+      else if constexpr (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>)
+      {
+         arg.type = Arg::Type::STRING;
+         arg.s    = value;
+      }
+      else
+      {
+         static_assert(std::is_arithmetic_v<T>, "AsyncLogger: arguments must be scalars or string literals.");
+      }
+   }
+
+   void push(const Record& record);
+   Ring& getThreadRing();
+   void drainThreadMain();
+   void drain();
+   void format(const Record& record);
+};
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "AsyncTempSender.h"
+#include "log.h"
+
+#include <chrono>
+#include <optional>
+
+//
+// Name: Call
+//
+// Description: State of one outstanding RPC; the slot itself is the
+//    completion queue tag. A ClientContext cannot be reused, so it is
+//    re-created in place for every RPC.
+//
+struct AsyncTempSender::Call
+{
+   std::optional<grpc::ClientContext>  context;
+   TempMonitorSink::SubSysIdAndTemp    request;
+   TempMonitorSink::empty_param        response;
+   grpc::Status                        status;
+   std::unique_ptr<grpc::ClientAsyncResponseReader<TempMonitorSink::empty_param>> reader;
+};
+
+//
+// Name: AsyncTempSender (ctor)
+//
+// Description: Preallocates the call slots and starts the reaperThread.
+//
+// Params: channel - The gRPC Channel to the TempMonitor server.
+//         maxInFlight - Most RPCs outstanding at once, at least one.
+//         deadlineMs - Per RPC deadline.
+//
+AsyncTempSender::AsyncTempSender(std::shared_ptr<grpc::Channel> channel, size_t maxInFlight, int deadlineMs)
+   : stub(TempMonitorSink::TempMonitorServer::NewStub(channel))
+   , rpcDeadlineMs(deadlineMs)
+{
+   const auto numCalls{ (0 == maxInFlight) ? size_t{ 1 } : maxInFlight };
+
+   calls.reserve(numCalls);
+   freeCalls.reserve(numCalls);
+   for (size_t idx{ 0 }; idx < numCalls; ++idx)
+   {
+      calls.push_back(std::make_unique<Call>());
+      freeCalls.push_back(calls.back().get());
+   }
+
+   reaperThread = std::thread(&AsyncTempSender::reaperThreadMain, this);
+}
+
+//
+// Name: ~AsyncTempSender (dtor)
+//
+// Description: Shuts the completion queue down; the reaperThread drains
+//    the outstanding RPCs (bounded by their deadline) and exits.
+//
+AsyncTempSender::~AsyncTempSender()
+{
+   cq.Shutdown();
+
+   if (reaperThread.joinable())
+   {
+      reaperThread.join();
+   }
+}
+
+//
+// Name: send
+//
+// Description: Starts an UpdateSubSystemTemp RPC and returns without
+//    waiting for the reply.
+//
+// Params: subSystemId - The SubSystem ID to send.
+//         temp - The temperature to send.
+//         sequenceNum - The sender's sample sequence number.
+//         sampleTimeNs - When the temp was read (SampleTrace::nowNs), 0 if not traced.
+//
+// Return: bool - False if maxInFlight RPCs are already outstanding; the
+//    temp is not sent.
+//
+bool AsyncTempSender::send(int subSystemId, float temp, uint64_t sequenceNum, int64_t sampleTimeNs)
+{
+   Call*  call{ nullptr };
+   size_t inFlight{ 0 };
+   {
+      const std::lock_guard<std::mutex> lock(freeCallsMux);
+      if (!freeCalls.empty())
+      {
+         call = freeCalls.back();
+         freeCalls.pop_back();
+         inFlight = calls.size() - freeCalls.size();
+      }
+   }
+
+   if (nullptr == call)
+   {
+      numRejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+   }
+
+   auto maxSeen{ maxInFlightSeen.load(std::memory_order_relaxed) };
+   while ((inFlight > maxSeen) && !maxInFlightSeen.compare_exchange_weak(maxSeen, inFlight, std::memory_order_relaxed))
+   {
+      // Retry with the updated maxSeen.
+   }
+
+   call->request.set_subsysid(subSystemId);
+   call->request.set_temp(temp);
+   call->request.set_sampletimens(static_cast<uint64_t>(sampleTimeNs));
+   call->request.set_sequencenum(sequenceNum);
+   call->context.emplace();
+   call->context->set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(rpcDeadlineMs));
+
+   call->reader = stub->PrepareAsyncUpdateSubSystemTemp(&*call->context, call->request, &cq);
+   call->reader->StartCall();
+   call->reader->Finish(&call->response, &call->status, call);
+
+   numSent.fetch_add(1, std::memory_order_relaxed);
+   return true;
+}
+
+//
+// Name: reaperThreadMain
+//
+// Description: Collects RPC replies and returns their slots until the
+//    completion queue is shut down and empty.
+//
+void AsyncTempSender::reaperThreadMain()
+{
+   void* tag{ nullptr };
+   bool  ok{ false };
+
+   while (cq.Next(&tag, &ok))
+   {
+      auto call{ static_cast<Call*>(tag) };
+
+      if (ok && call->status.ok())
+      {
+         numCompleted.fetch_add(1, std::memory_order_relaxed);
+      }
+      else
+      {
+         numFailed.fetch_add(1, std::memory_order_relaxed);
+         LOG_RATE_LIMITED( LogLevel::ERR, LOG_DEFAULT_RATE_LIMIT_MS, "AsyncTempSender::reaperThreadMain() - ERROR: SSID=[{}] - RPC failed, code=[{}]", call->request.subsysid(), call->status.error_code() );
+      }
+
+      call->reader.reset();
+      call->context.reset();
+
+      const std::lock_guard<std::mutex> lock(freeCallsMux);
+      freeCalls.push_back(call);
+   }
+}
+
+//
+// Name: getStats
+//
+// Return: AsyncTempSender::Stats - Totals since construction.
+//
+AsyncTempSender::Stats AsyncTempSender::getStats() const
+{
+   Stats rVal;
+   rVal.sent        = numSent.load(std::memory_order_relaxed);
+   rVal.completed   = numCompleted.load(std::memory_order_relaxed);
+   rVal.failed      = numFailed.load(std::memory_order_relaxed);
+   rVal.rejected    = numRejected.load(std::memory_order_relaxed);
+   rVal.maxInFlight = maxInFlightSeen.load(std::memory_order_relaxed);
+   return rVal;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+* Class: AsyncTempSender
+*
+* Description: This is not used or needed by the FanControl. Sends
+*     UpdateSubSystemTemp RPCs without waiting for their replies, for any
+*     number of SubSystems (SubSystem::SendMode::ASYNC) sharing one channel.
+*
+*     send() starts the RPC on a CompletionQueue and returns. At most
+*     maxInFlight RPCs are outstanding: each one uses a preallocated call
+*     slot, and when none is free the temp is rejected (and counted) rather
+*     than queued, so a slow server never stalls the caller. One reaper
+*     thread collects the replies and frees the slots. Every RPC has a
+*     deadline, so a dead server cannot hold a slot forever.
+*
+*     {RISK}: RPCs in flight are independent, so two temps of the same
+*             subsystem sent back to back may be applied out of order.
+*
+*     send() is thread safe.
+*
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+#include "TempMonitor.grpc.pb.h"
+
+class AsyncTempSender final
+{
+public:
+   static constexpr size_t DEFAULT_MAX_IN_FLIGHT{ 64 };
+   static constexpr int    DEFAULT_RPC_DEADLINE_MS{ 1000 };
+
+   struct Stats
+   {
+      uint64_t sent{ 0 };        // RPCs started.
+      uint64_t completed{ 0 };   // RPCs that returned OK.
+      uint64_t failed{ 0 };      // RPCs that returned an error (including deadline exceeded).
+      uint64_t rejected{ 0 };    // Temps not sent, maxInFlight RPCs were outstanding.
+      size_t   maxInFlight{ 0 }; // Highest number of outstanding RPCs seen.
+   };
+
+private:
+   struct Call;
+
+   std::unique_ptr<TempMonitorSink::TempMonitorServer::Stub> stub;
+   grpc::CompletionQueue                                     cq;
+   const int                                                 rpcDeadlineMs;
+
+   std::vector<std::unique_ptr<Call>> calls;
+   std::mutex                         freeCallsMux; // Guards freeCalls.
+   std::vector<Call*>                 freeCalls;
+
+   std::atomic<uint64_t> numSent{ 0 };
+   std::atomic<uint64_t> numCompleted{ 0 };
+   std::atomic<uint64_t> numFailed{ 0 };
+   std::atomic<uint64_t> numRejected{ 0 };
+   std::atomic<size_t>   maxInFlightSeen{ 0 };
+
+   std::thread reaperThread;
+   void reaperThreadMain();
+
+public:
+   AsyncTempSender(std::shared_ptr<grpc::Channel> channel,
+                   size_t maxInFlight = DEFAULT_MAX_IN_FLIGHT,
+                   int deadlineMs = DEFAULT_RPC_DEADLINE_MS);
+   ~AsyncTempSender();
+
+   AsyncTempSender(const AsyncTempSender&) = delete;
+   AsyncTempSender& operator=(const AsyncTempSender&) = delete;
+
+   bool send(int subSystemId, float temp, uint64_t sequenceNum = 0, int64_t sampleTimeNs = 0);
+
+   Stats getStats() const;
+};
\ No newline at end of file
@@ -0,0 +1,186 @@
+/*
+* Class: CoalescingTempTable
+*
+* Description: Fixed size, latest-value-per-subsystem temperature table.
+*     Each subsystem owns one slot guarded by a seqlock; a sample simply
+*     overwrites the previous one, so memory is O(subsystems) no matter how
+*     fast the senders are. Writing a slot also sets its bit in a dirty
+*     bitmap, which lets the consumer sweep only the slots that changed.
+*
+*     Producers (gRPC handler threads) call store(). A single consumer
+*     thread calls sweep() / anyDirty().
+*
+*/
+
+#pragma once
+
+#include "GeneralConstants.h"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+class CoalescingTempTable final
+{
+   static constexpr size_t CACHE_LINE_SIZE{ GeneralConstants::CACHE_LINE_SIZE };
+   static constexpr size_t BITS_PER_WORD{ 64 };
+
+   struct alignas(CACHE_LINE_SIZE) Slot
+   {
+      std::atomic<uint32_t> sequence{ 0 }; // Odd while a writer is inside.
+      std::atomic<float>    temp{ 0.0f };
+   };
+
+   const size_t                            numSlots;
+   const size_t                            numWords;
+   std::unique_ptr<Slot[]>                 slots;
+   std::unique_ptr<std::atomic<uint64_t>[]> dirty;
+
+public:
+   //
+   // Name: CoalescingTempTable (ctor)
+   //
+   // Params: slotCount - Number of subsystems (slots) in the table.
+   //
+   explicit CoalescingTempTable(size_t slotCount)
+      : numSlots(slotCount)
+      , numWords((slotCount + BITS_PER_WORD - 1) / BITS_PER_WORD)
+      , slots(new Slot[slotCount])
+      , dirty(new std::atomic<uint64_t>[numWords])
+   {
+      for (size_t idx{ 0 }; idx < numWords; ++idx)
+      {
+         dirty[idx].store(0, std::memory_order_relaxed);
+      }
+   }
+
+   CoalescingTempTable(const CoalescingTempTable&) = delete;
+   CoalescingTempTable& operator=(const CoalescingTempTable&) = delete;
+
+   //
+   // Name: store
+   //
+   // Description: Producer API. Overwrites the slot with the latest temp
+   //    and marks it dirty. Concurrent writers of the same slot are
+   //    serialized by the seqlock.
+   //
+   // Params: slot - Slot index, [0, getSize()).
+   //         temp - Latest temperature for the slot.
+   //
+   // Return: bool - True if the slot was clean, i.e. the consumer needs
+   //    to be signalled. False if a sweep is already pending for it.
+   //
+   bool store(size_t slot, float temp)
+   {
+      auto& entry{ slots[slot] };
+
+      auto seq{ entry.sequence.load(std::memory_order_relaxed) };
+      for (;;)
+      {
+         if ((0 == (seq & 1)) &&
+             entry.sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+         {
+            break;
+         }
+         std::this_thread::yield();
+         seq = entry.sequence.load(std::memory_order_relaxed);
+      }
+
+      entry.temp.store(temp, std::memory_order_relaxed);
+      entry.sequence.store(seq + 2, std::memory_order_release);
+
+      const auto bit{ uint64_t{ 1 } << (slot % BITS_PER_WORD) };
+      const auto prev{ dirty[slot / BITS_PER_WORD].fetch_or(bit, std::memory_order_acq_rel) };
+      return 0 == (prev & bit);
+   }
+
+   //
+   // Name: load
+   //
+   // Description: Consistent read of a slot.
+   //
+   // Params: slot - Slot index, [0, getSize()).
+   //
+   // Return: float - Latest temp written to the slot.
+   //
+   float load(size_t slot) const
+   {
+      const auto& entry{ slots[slot] };
+      float rVal{ 0.0f };
+
+      for (;;)
+      {
+         const auto seqBefore{ entry.sequence.load(std::memory_order_acquire) };
+         if (0 != (seqBefore & 1))
+         {
+            std::this_thread::yield();
+            continue;
+         }
+
+         rVal = entry.temp.load(std::memory_order_relaxed);
+         std::atomic_thread_fence(std::memory_order_acquire);
+
+         if (seqBefore == entry.sequence.load(std::memory_order_relaxed))
+         {
+            break;
+         }
+      }
+      return rVal;
+   }
+
+   //
+   // Name: sweep
+   //
+   // Description: Consumer API. Clears the dirty bitmap one word at a time
+   //    and calls func(slot, temp) for every slot that was dirty.
+   //
+   // Params: func - Callable taking (size_t slot, float temp).
+   //
+   // Return: size_t - Number of slots visited.
+   //
+   template <typename Func>
+   size_t sweep(Func&& func)
+   {
+      size_t rVal{ 0 };
+
+      for (size_t word{ 0 }; word < numWords; ++word)
+      {
+         if (0 == dirty[word].load(std::memory_order_relaxed))
+         {
+            continue;
+         }
+
+         auto bits{ dirty[word].exchange(0, std::memory_order_acq_rel) };
+         while (0 != bits)
+         {
+            const auto slot{ (word * BITS_PER_WORD) + static_cast<size_t>(std::countr_zero(bits)) };
+            func(slot, load(slot));
+            bits &= (bits - 1);
+            ++rVal;
+         }
+      }
+      return rVal;
+   }
+
+   //
+   // Name: anyDirty
+   //
+   // Description: Consumer API. True if at least one slot awaits a sweep.
+   //
+   bool anyDirty() const
+   {
+      for (size_t word{ 0 }; word < numWords; ++word)
+      {
+         if (0 != dirty[word].load(std::memory_order_acquire))
+         {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   size_t getSize() const { return numSlots; }
+};
@@ -0,0 +1,159 @@
+/*
+* Class: CowSnapshot
+*
+* Description: Copy-on-write holder of an immutable T, for data that is
+*     read on a hot path and rarely changed (e.g. the listener list).
+*
+*     Readers never lock: read() protects the current snapshot with a hazard
+*     pointer and calls func(const T&) on it. Writers serialize on a mutex,
+*     copy the snapshot, modify the copy, swap it in atomically and then wait
+*     until no hazard pointer references the old snapshot before deleting it.
+*     A writer may therefore wait for in-flight readers, but a reader never
+*     waits for a writer.
+*
+*     At most MaxReaders threads may be inside read() at the same time; any
+*     more yield until a hazard slot frees up.
+*
+*/
+
+#pragma once
+
+#include "GeneralConstants.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+template <typename T, size_t MaxReaders = 8>
+class CowSnapshot final
+{
+   static constexpr size_t CACHE_LINE_SIZE{ GeneralConstants::CACHE_LINE_SIZE };
+
+   struct alignas(CACHE_LINE_SIZE) HazardSlot
+   {
+      std::atomic<bool>     inUse{ false };
+      std::atomic<const T*> ptr{ nullptr };
+   };
+
+   std::atomic<const T*> current;
+   mutable HazardSlot    hazards[MaxReaders];
+   std::mutex            writerMux;
+
+   //
+   // Name: acquireSlot
+   //
+   // Description: Claims a free hazard slot, yielding if all are taken.
+   //
+   HazardSlot& acquireSlot() const
+   {
+      for (;;)
+      {
+         for (auto& slot : hazards)
+         {
+            if (!slot.inUse.load(std::memory_order_relaxed) &&
+                !slot.inUse.exchange(true, std::memory_order_acquire))
+            {
+               return slot;
+            }
+         }
+         std::this_thread::yield();
+      }
+   }
+
+   //
+   // Name: isProtected
+   //
+   // Description: True if any reader still holds a hazard pointer to snapshot.
+   //
+   bool isProtected(const T* snapshot) const
+   {
+      for (const auto& slot : hazards)
+      {
+         if (snapshot == slot.ptr.load(std::memory_order_seq_cst))
+         {
+            return true;
+         }
+      }
+      return false;
+   }
+
+public:
+   CowSnapshot()
+      : current(new T())
+   {}
+
+   ~CowSnapshot()
+   {
+      delete current.load(std::memory_order_relaxed);
+   }
+
+   CowSnapshot(const CowSnapshot&) = delete;
+   CowSnapshot& operator=(const CowSnapshot&) = delete;
+
+   //
+   // Name: read
+   //
+   // Description: Lock-free. Calls func with the current snapshot, which
+   //    stays alive (and unchanged) until func returns.
+   //
+   // Params: func - Callable taking (const T&).
+   //
+   template <typename Func>
+   void read(Func&& func) const
+   {
+      auto& slot{ acquireSlot() };
+
+      auto snapshot{ current.load(std::memory_order_seq_cst) };
+      for (;;)
+      {
+         slot.ptr.store(snapshot, std::memory_order_seq_cst);
+         const auto latest{ current.load(std::memory_order_seq_cst) };
+         if (latest == snapshot)
+         {
+            break;
+         }
+         snapshot = latest;
+      }
+
+      func(*snapshot);
+
+      slot.ptr.store(nullptr, std::memory_order_release);
+      slot.inUse.store(false, std::memory_order_release);
+   }
+
+   //
+   // Name: update
+   //
+   // Description: Copies the current snapshot, lets mutate modify the copy
+   //    and publishes it. Returns once the old snapshot has been reclaimed,
+   //    so no reader can still see it.
+   //
+   // Params: mutate - Callable taking (T&), returning false to discard the
+   //            copy and leave the current snapshot in place.
+   //
+   // Return: bool - Result of mutate.
+   //
+   template <typename Func>
+   bool update(Func&& mutate)
+   {
+      const std::lock_guard<std::mutex> lock(writerMux);
+
+      const auto oldSnapshot{ current.load(std::memory_order_relaxed) };
+      auto newSnapshot{ std::make_unique<T>(*oldSnapshot) };
+
+      if (!mutate(*newSnapshot))
+      {
+         return false;
+      }
+
+      current.store(newSnapshot.release(), std::memory_order_seq_cst);
+      while (isProtected(oldSnapshot))
+      {
+         std::this_thread::yield();
+      }
+      delete oldSnapshot;
+      return true;
+   }
+};
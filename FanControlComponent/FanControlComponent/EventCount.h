@@ -0,0 +1,93 @@
+/*
+* Class: EventCount
+*
+* Description: Lightweight wake-up primitive for a single consumer thread that
+*     polls a lock-free structure. Producers only pay for an atomic fence
+*     and load unless the consumer is actually asleep, in which case the
+*     consumer is woken through std::atomic::wait/notify (a futex on Linux,
+*     WaitOnAddress on Windows).
+*
+*     Consumer usage:
+*        auto key{ ec.prepareWait() };
+*        if( <work available> ) { ec.cancelWait(); } else { ec.commitWait(key); }
+*
+*     Producer usage:
+*        <publish work>
+*        ec.notify();
+*
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+class EventCount final
+{
+   std::atomic<uint32_t> epoch{ 0 };
+   std::atomic<uint32_t> sleeping{ 0 };
+
+public:
+   EventCount() {};
+   EventCount(const EventCount&) = delete;
+   EventCount& operator=(const EventCount&) = delete;
+
+   //
+   // Name: prepareWait
+   //
+   // Description: Announces the intent to sleep. The caller must re-check
+   //    its wake condition after this call and then either cancelWait()
+   //    or commitWait() with the returned key.
+   //
+   // Return: uint32_t - Key to pass to commitWait.
+   //
+   uint32_t prepareWait()
+   {
+      sleeping.store(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return epoch.load(std::memory_order_seq_cst);
+   }
+
+   //
+   // Name: cancelWait
+   //
+   // Description: Withdraws a prepareWait when work was found.
+   //
+   void cancelWait()
+   {
+      sleeping.store(0, std::memory_order_relaxed);
+   }
+
+   //
+   // Name: commitWait
+   //
+   // Description: Sleeps until a notify happens after prepareWait returned key.
+   //
+   // Params: key - Value returned from prepareWait.
+   //
+   void commitWait(uint32_t key)
+   {
+      while (epoch.load(std::memory_order_acquire) == key)
+      {
+         epoch.wait(key, std::memory_order_acquire);
+      }
+   }
+
+   //
+   // Name: notify
+   //
+   // Description: Wakes the waiting thread, if any. Must be called after
+   //    the work has been published. Only the first notify after a
+   //    prepareWait pays for the wake; the rest see sleeping == 0 and return.
+   //
+   void notify()
+   {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if ((0 != sleeping.load(std::memory_order_relaxed)) &&
+          (0 != sleeping.exchange(0, std::memory_order_acq_rel)))
+      {
+         epoch.fetch_add(1, std::memory_order_seq_cst);
+         epoch.notify_all();
+      }
+   }
+};
@@ -0,0 +1,256 @@
+/*
+* Class: FanActuationPlan
+*
+* Description: Per-fan register pointer, register shadow and PWMC row
+*     (duty cycle -> PWM counts, see FanPwmcTables), resolved once by
+*     compile() (FanControl::initialize) and stored contiguously, so applying
+*     a duty cycle to every fan is a tight loop of one indexed load per fan,
+*     with no hashing and no arithmetic. The register is only written when
+*     the value differs from its FanRegisters shadow.
+*
+*     Entries are kept in register address order, so apply() walks the
+*     register bank sequentially and ends with a single fence for the whole
+*     batch (as FanRegisters::writeRegisters does).
+*
+*     The rows come from the compile-time FanPwmcTables, or are generated
+*     when compiling against an explicit multiplier map.
+*
+* WARNING: Not thread safe. compile() must complete before apply() is called.
+*     Plans over disjoint fans may be applied from different threads.
+*
+*/
+
+#pragma once
+
+#include "FanRegisters.h"
+#include "FanPwmcTables.h"
+#include "GeneralConstants.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class FanActuationPlan final
+{
+   struct Entry
+   {
+      volatile uint32_t*             reg{ nullptr };
+      uint64_t*                      shadow{ nullptr };
+      const FanPwmcTables::PwmcRow*  pwmc{ nullptr };
+   };
+
+   const FanRegisters*                 fanRegisters{ nullptr }; // Write counters.
+
+   std::vector<Entry>                  entries;
+   std::vector<int>                    fanIds;     // Parallel to entries, for reporting only.
+   std::vector<FanPwmcTables::PwmcRow> ownedRows;  // Rows generated from a multiplier map.
+
+   //
+   // Name: compileRows
+   //
+   // Description: Shared by the compile overloads. findRow(fanId) returns
+   //    the fan's PWMC row or nullptr.
+   //
+   template <typename FindRow>
+   GeneralConstants::ReturnCodes compileRows(const std::vector<int>& ids, const FanRegisters& registers, FindRow&& findRow)
+   {
+      auto rVal{ GeneralConstants::ReturnCodes::SUCCESS };
+
+      entries.clear();
+      fanIds.clear();
+      fanRegisters = &registers;
+      entries.reserve(ids.size());
+      fanIds.reserve(ids.size());
+
+      for (auto fanId : ids)
+      {
+         auto reg{ registers.getFanRegAddr(fanId) };
+         if (nullptr == reg)
+         {
+            rVal = GeneralConstants::ReturnCodes::UNKNOWN_FAN_ID;
+            break;
+         }
+
+         auto pwmc{ findRow(fanId) };
+         if (nullptr == pwmc)
+         {
+            rVal = GeneralConstants::ReturnCodes::NO_FAN_MULTIPLIER;
+            break;
+         }
+
+         entries.push_back({ reg, registers.getFanShadow(fanId), pwmc });
+         fanIds.push_back(fanId);
+      }
+
+      if (GeneralConstants::ReturnCodes::SUCCESS != rVal)
+      {
+         entries.clear();
+         fanIds.clear();
+      }
+      else
+      {
+         sortByRegister();
+      }
+      return rVal;
+   }
+
+   //
+   // Name: sortByRegister
+   //
+   // Description: Orders entries (and the parallel fanIds) by register address.
+   //
+   void sortByRegister()
+   {
+      std::vector<size_t> order(entries.size());
+      for (size_t idx{ 0 }; idx < order.size(); ++idx)
+      {
+         order[idx] = idx;
+      }
+      std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs)
+      {
+         return reinterpret_cast<uintptr_t>(entries[lhs].reg) < reinterpret_cast<uintptr_t>(entries[rhs].reg);
+      });
+
+      std::vector<Entry> sortedEntries;
+      std::vector<int>   sortedFanIds;
+      sortedEntries.reserve(order.size());
+      sortedFanIds.reserve(order.size());
+      for (auto idx : order)
+      {
+         sortedEntries.push_back(entries[idx]);
+         sortedFanIds.push_back(fanIds[idx]);
+      }
+      entries.swap(sortedEntries);
+      fanIds.swap(sortedFanIds);
+   }
+
+public:
+   //
+   // Name: compile
+   //
+   // Description: Resolves the register address of every fan and its row
+   //    in the compile-time FanPwmcTables. On failure the plan is left empty.
+   //
+   // Params: ids - Fan ids. They are written in register address order.
+   //         registers - Fan register addresses.
+   //
+   // Return: GeneralConstants::ReturnCodes - UNKNOWN_FAN_ID if a fan has no
+   //       register, NO_FAN_MULTIPLIER if it has no proportionality constant.
+   //
+   GeneralConstants::ReturnCodes compile(const std::vector<int>& ids, const FanRegisters& registers)
+   {
+      ownedRows.clear();
+      return compileRows(ids, registers, [](int fanId) { return FanPwmcTables::findPwmcRow(fanId); });
+   }
+
+   //
+   // Name: compile
+   //
+   // Description: As above, generating the PWMC rows from multipliers
+   //    instead of FanConstants.
+   //
+   // Params: multipliers - Map of <FanId, PWMC proportionality constant>.
+   //
+   GeneralConstants::ReturnCodes compile( const std::vector<int>& ids,
+                                          const FanRegisters& registers,
+                                          const std::unordered_map<int, int>& multipliers )
+   {
+      ownedRows.clear();
+      ownedRows.reserve(ids.size()); // Entries point into ownedRows, it must not reallocate.
+
+      // Fans sharing a multiplier share a row, keeping the rows cache resident.
+      std::unordered_map<int, const FanPwmcTables::PwmcRow*> rowByMultiplier;
+
+      return compileRows(ids, registers, [this, &multipliers, &rowByMultiplier](int fanId) -> const FanPwmcTables::PwmcRow*
+      {
+         auto multiplier{ multipliers.find(fanId) };
+         if (multipliers.end() == multiplier)
+         {
+            return nullptr;
+         }
+
+         auto& row{ rowByMultiplier[multiplier->second] };
+         if (nullptr == row)
+         {
+            ownedRows.push_back(FanPwmcTables::makePwmcRow(multiplier->second));
+            row = &ownedRows.back();
+         }
+         return row;
+      });
+   }
+
+   //
+   // Name: apply
+   //
+   // Description: Writes every fan's PWMC for dutyCycle to its register,
+   //    in address order, skipping registers whose shadow already holds it.
+   //    One fence follows the batch if anything was written.
+   //
+   // Params: dutyCycle - Rounded duty cycle, FanPwmcTables::DC_MIN..DC_MAX.
+   //
+   void apply(int dutyCycle) const
+   {
+      const auto idx{ static_cast<size_t>(dutyCycle - FanPwmcTables::DC_MIN) };
+      uint64_t written{ 0 };
+
+      for (const auto& entry : entries)
+      {
+         const auto pwmc{ (*entry.pwmc)[idx] };
+         if (*entry.shadow != pwmc)
+         {
+            *entry.reg    = pwmc;
+            *entry.shadow = pwmc;
+            ++written;
+         }
+      }
+
+      if (0 != written)
+      {
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+      }
+
+      if (nullptr != fanRegisters)
+      {
+         fanRegisters->countWrites(written, entries.size() - written);
+      }
+   }
+
+   //
+   // Name: refresh
+   //
+   // Description: Rewrites the register of every fan in the plan that has
+   //    been written before from its shadow (FanRegisters::refresh, limited
+   //    to this plan's fans), followed by one fence.
+   //
+   void refresh() const
+   {
+      uint64_t written{ 0 };
+
+      for (const auto& entry : entries)
+      {
+         const auto shadow{ *entry.shadow };
+         if (FanRegisters::NO_SHADOW != shadow)
+         {
+            *entry.reg = static_cast<uint32_t>(shadow);
+            ++written;
+         }
+      }
+
+      if (0 != written)
+      {
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+      }
+
+      if (nullptr != fanRegisters)
+      {
+         fanRegisters->countWrites(written, 0);
+      }
+   }
+
+   size_t size() const { return entries.size(); }
+   int    getFanId(size_t idx) const { return fanIds[idx]; }
+   int    getPwmc(size_t idx, int dutyCycle) const { return static_cast<int>((*entries[idx].pwmc)[static_cast<size_t>(dutyCycle - FanPwmcTables::DC_MIN)]); }
+};
@@ -8,12 +8,19 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <unordered_map>
+#include <utility>
 
 namespace FanConstants
 {
    const int INITIAL_FAN_DUTY_CYCLE{ 25 };
 
+   // Unchanged register writes are elided (FanRegisters shadow), so the
+   // registers are rewritten from their shadows at least this often.
+   constexpr int FAN_REGISTER_REFRESH_MS{ 1000 };
+
    // Fan ID, Register Address
    const std::unordered_map<int, uint64_t> FAN_REGISTER_ADDRESSES
    {
@@ -41,8 +48,8 @@ namespace FanConstants
    };
 
    // Fan ID, Proportionality Const.
-   const std::unordered_map<int, int> FAN_PWMC_PROPORTIONALITY
-   {
+   constexpr std::array<std::pair<int, int>, 21> FAN_PWMC_PROPORTIONALITY_TABLE
+   {{
         { 1, 5 }
       , { 2, 2 }
       , { 3, 2 }
@@ -64,5 +71,11 @@ namespace FanConstants
       , {19, 4 }
       , {20, 6 }
       , {21, 2 }
+   }};
+
+   // Fan ID, Proportionality Const. (lookup by id, built from the table above).
+   const std::unordered_map<int, int> FAN_PWMC_PROPORTIONALITY
+   {
+      FAN_PWMC_PROPORTIONALITY_TABLE.begin(), FAN_PWMC_PROPORTIONALITY_TABLE.end()
    };
 };
\ No newline at end of file
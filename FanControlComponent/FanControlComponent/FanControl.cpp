@@ -1,8 +1,30 @@
 #include "FanControl.h"
 #include "TempToDutyCycle.h"
 #include "FanConstants.h"
+#include "FanPwmcTables.h"
 #include "log.h"
 
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+
+namespace
+{
+   //
+   // Name: makeTempMonitorConfig
+   //
+   // Description: The TempMonitor tracks the max temp of every ThermalZone.
+   //
+   TempMonitorConfig makeTempMonitorConfig(const FanControlConfig& config)
+   {
+      TempMonitorConfig rVal;
+      rVal.thermalZones    = config.thermalZones;
+      rVal.serverMode      = config.serverMode;
+      rVal.sharedTableName = config.sharedTableName;
+      return rVal;
+   }
+}
+
 //
 // Name: FanControl
 //
@@ -11,12 +33,19 @@
 // Params: ssIds - Vector of supported SubSystemIDs
 //         fanIds - Vector of fanIds which the FanControl will control.
 //         updater - Callback to the UI, to update the fan related Temps.
+//         cfg - Control loop tunables.
+//         registerBackend - Resolves the register addresses, nullptr for raw pointers.
 //
-FanControl::FanControl(const std::vector<int>& ssIds, const std::vector<int>& fanIds, UiUpdater* updater)
-   : fanIds(fanIds)
+FanControl::FanControl( const std::vector<int>& ssIds,
+                        const std::vector<int>& fanIds,
+                        UiUpdater* updater,
+                        const FanControlConfig& cfg,
+                        std::shared_ptr<RegisterBackend> registerBackend )
+   : config(cfg)
+   , fanIds(fanIds)
    , uiUpdater(updater)
-   , fanRegisters(FanConstants::FAN_REGISTER_ADDRESSES)
-   , tempMonitor(ssIds)
+   , fanRegisters(FanConstants::FAN_REGISTER_ADDRESSES, std::move(registerBackend))
+   , tempMonitor(ssIds, makeTempMonitorConfig(cfg))
 {
    DEBUG_STD_OUT("FanControl::ctor() - EXIT");
 }
@@ -31,15 +60,20 @@ FanControl::FanControl(const std::vector<int>& ssIds, const std::vector<int>& fa
 //         fanAddresses - Map of <FanId, Memory Addresses>, allowing the FanControl
 //             to use passed in memory addresses instead of hard-coded ones.
 //         updater - Callback to the UI, to update the fan related Temps.
+//         cfg - Control loop tunables.
+//         registerBackend - Resolves the register addresses, nullptr for raw pointers.
 //
 FanControl::FanControl( const std::vector<int>& ssIds,
                         const std::vector<int>& fanIds, 
                         const std::unordered_map<int, uint64_t>& fanAddresses,
-                        UiUpdater* updater )
-   : fanIds(fanIds)
+                        UiUpdater* updater,
+                        const FanControlConfig& cfg,
+                        std::shared_ptr<RegisterBackend> registerBackend )
+   : config(cfg)
+   , fanIds(fanIds)
    , uiUpdater(updater)
-   , fanRegisters(fanAddresses)
-   , tempMonitor(ssIds)
+   , fanRegisters(fanAddresses, std::move(registerBackend))
+   , tempMonitor(ssIds, makeTempMonitorConfig(cfg))
 {
    PRINT_STD_OUT("FanControl::ctor() - USING MOCK MEMORY ADDRESSES FOR REGISTERS")
 }
@@ -53,6 +87,14 @@ FanControl::~FanControl()
 {
    DEBUG_STD_OUT("FanControl::dtor() - ENTER");
 
+   // The TempMonitor outlives this object's members, stop its callbacks first.
+   tempMonitor.unregisterListener(*this);
+   for (auto& fanGroup : fanGroups)
+   {
+      tempMonitor.unregisterZoneListener(fanGroup->getZoneId(), *fanGroup);
+   }
+   fanGroups.clear();
+
    if(fanThread.joinable() )
    {
       {
@@ -71,17 +113,36 @@ FanControl::~FanControl()
 // Name: initialize
 //
 // Description: 
-//    1. Check to make sure all provided FanIds have a PWMC Multiplier and Fan Register.
+//    1. Check the config, and make sure all provided FanIds have a PWMC Multiplier
+//       and Fan Register, compiling the fans in no ThermalZone into the actuationPlan.
+//       With ThermalZones, the UI fan data is merged from the fanThread and FanGroups.
 //    2. Set all fans to default speeds.
 //    3. Register with TempMonitor as a listener.
-//    4. Start Listener thread so it is ready to process new temps.
-//    4. Initialize the TempMonitor.
+//    4. Start a FanGroup per ThermalZone, registered as that zone's listener.
+//    5. Start Listener thread so it is ready to process new temps.
+//    6. Initialize the TempMonitor.
 //
 // Return: GeneralConstants::ReturnCodes
 //
 GeneralConstants::ReturnCodes FanControl::initialize()
 {
-   auto rVal{ fanRegisters.checkFanIds( fanIds ) };
+   auto rVal{ checkConfig() };
+
+   if (GeneralConstants::ReturnCodes::SUCCESS == rVal)
+   {
+      rVal = fanRegisters.checkFanIds( fanIds );
+   }
+
+   if (GeneralConstants::ReturnCodes::SUCCESS == rVal)
+   {
+      rVal = actuationPlan.compile( getUngroupedFanIds(), fanRegisters );
+   }
+
+   if ((GeneralConstants::ReturnCodes::SUCCESS == rVal) && uiUpdater && !config.thermalZones.empty())
+   {
+      uiMerger  = std::make_unique<UiFanDataMerger>(*uiUpdater);
+      uiUpdater = uiMerger->addRegion(actuationPlan.size(), true);
+   }
 
    if (GeneralConstants::ReturnCodes::SUCCESS == rVal)
    {
@@ -93,6 +154,11 @@ GeneralConstants::ReturnCodes FanControl::initialize()
       rVal = tempMonitor.registerListener(*this);
    }
 
+   if (GeneralConstants::ReturnCodes::SUCCESS == rVal)
+   {
+      rVal = startFanGroups();
+   }
+
    if (GeneralConstants::ReturnCodes::SUCCESS == rVal)
    {
       fanThreadKeepAlive.store(true);
@@ -107,6 +173,110 @@ GeneralConstants::ReturnCodes FanControl::initialize()
    return rVal;
 }
 
+//
+// Name: checkConfig
+//
+// Description: A FIXED_RATE period and the register refresh period must be
+//    non zero. Every ThermalZone must
+//    have a unique id and at least one fan, and zone fans must be FanControl
+//    fans that are in no other zone.
+//
+// Return: GeneralConstants::ReturnCodes - FAN_CONTROL_INVALID_CONFIG on error.
+//
+GeneralConstants::ReturnCodes FanControl::checkConfig() const
+{
+   auto rVal{ GeneralConstants::ReturnCodes::SUCCESS };
+
+   if (((FanControlConfig::ControlMode::FIXED_RATE == config.controlMode) && (0 == config.controlPeriodMs)) ||
+       (0 == config.registerRefreshMs))
+   {
+      rVal = GeneralConstants::ReturnCodes::FAN_CONTROL_INVALID_CONFIG;
+   }
+
+   const std::unordered_set<int> knownFans(fanIds.begin(), fanIds.end());
+   std::unordered_set<int>       zoneIds;
+   std::unordered_set<int>       zoneFans;
+
+   for (const auto& zone : config.thermalZones)
+   {
+      if (zone.fanIds.empty() || !zoneIds.insert(zone.zoneId).second)
+      {
+         rVal = GeneralConstants::ReturnCodes::FAN_CONTROL_INVALID_CONFIG;
+      }
+
+      for (auto fanId : zone.fanIds)
+      {
+         if ((0 == knownFans.count(fanId)) || !zoneFans.insert(fanId).second)
+         {
+            rVal = GeneralConstants::ReturnCodes::FAN_CONTROL_INVALID_CONFIG;
+         }
+      }
+   }
+
+   if (GeneralConstants::ReturnCodes::SUCCESS != rVal)
+   {
+      PRINT_STD_OUT("FanControl::checkConfig() - ERROR: Invalid control period or thermal zones.");
+   }
+   return rVal;
+}
+
+//
+// Name: getUngroupedFanIds
+//
+// Return: std::vector<int> - The fanIds that are in no ThermalZone, in order.
+//
+std::vector<int> FanControl::getUngroupedFanIds() const
+{
+   std::unordered_set<int> zoneFans;
+   for (const auto& zone : config.thermalZones)
+   {
+      zoneFans.insert(zone.fanIds.begin(), zone.fanIds.end());
+   }
+
+   std::vector<int> rVal;
+   for (auto fanId : fanIds)
+   {
+      if (0 == zoneFans.count(fanId))
+      {
+         rVal.push_back(fanId);
+      }
+   }
+   return rVal;
+}
+
+//
+// Name: startFanGroups
+//
+// Description: Creates, initializes and registers a FanGroup for every
+//    ThermalZone, so each zone's max temp drives its own fans. Each group
+//    reports its fans to the UI through a region of the uiMerger.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes FanControl::startFanGroups()
+{
+   auto rVal{ GeneralConstants::ReturnCodes::SUCCESS };
+
+   for (const auto& zone : config.thermalZones)
+   {
+      auto groupUiUpdater{ uiMerger ? uiMerger->addRegion(zone.fanIds.size()) : nullptr };
+      fanGroups.push_back(std::make_unique<FanGroup>(zone, &tempMonitor.getLatencyRecorder(), config.registerRefreshMs, groupUiUpdater));
+
+      rVal = fanGroups.back()->initialize(fanRegisters);
+      if (GeneralConstants::ReturnCodes::SUCCESS == rVal)
+      {
+         rVal = tempMonitor.registerZoneListener(zone.zoneId, *fanGroups.back());
+      }
+
+      if (GeneralConstants::ReturnCodes::SUCCESS != rVal)
+      {
+         fanGroups.pop_back(); // Never registered, nothing to unregister.
+         break;
+      }
+   }
+   return rVal;
+}
+
 //
 // Name: setFansToDefault
 //
@@ -126,84 +296,207 @@ GeneralConstants::ReturnCodes FanControl::setFansToDefault()
 // Name: updateFans
 //
 // Description: 
-//    1. Calculate the new duty cycle using the given temp.
-//    2. Loop over all fans.
-//    3. Calculate the PWM Count for the current fan.
-//    4. write the new pwm count to the fan register.
-//    5. Repeat for all fan in the FanPwmcMultiplier LUT.
+//    1. Look up the rounded duty cycle for the given temp (FanPwmcTables).
+//    2. Write every fan's PWMC for that duty cycle to its register (actuationPlan),
+//       as one batch in register address order with a single fence.
+//    3. Report the PWM counts to the UI, if there is one.
 //
-// Note: If there is no multiplier, don't adjust the fan. 
-//       The Ctor does an initial check and there should 
-//       be a multiplier for each pwmc.
+// Note: Every fan in the actuationPlan has a register and a multiplier,
+//       initialize() fails with UNKNOWN_FAN_ID / NO_FAN_MULTIPLIER otherwise.
 //
 // Params: temp - The temperature used to calculate the duty cycle for all fans.
 //
-// {RISK}: The duty cycle is rounded-to-zero for translation to PWMCs.
-//
-// {HAZARD}: Proper error handling needs to be implemented in case a
-//           multiplier is not found. At this point, the component (and system) 
-//           is running. The fan in question cannot be safely adjusted.
-//
-// {HAZARD_MEDIATION}: Implement proper error handling for the given system.
-//
-// {HAZARD_TODO}: Hazard Mediation.
+// {RISK}: The temp is quantized to 1/16 of a degree and the duty cycle is
+//         rounded to the nearest percent for translation to PWMCs.
 //
 void FanControl::updateFans( float temp ) const
 {
-   UiUpdater::FanData fanData;
+   auto roundedDc{ FanPwmcTables::getDutyCycle(temp) };
 
-   auto dutyCycle{ TempToDutyCycle::getDutyCycle(temp) };
+   LOG_INFO( "FanControl::updateFans(): CurTemp=[{}], DC=[{}]", temp, roundedDc );
 
-   fanData.temp = temp;
-   fanData.dutyCycle = dutyCycle;
+   actuationPlan.apply( roundedDc );
 
-   PRINT_STD_OUT( "FanControl::updateFans(): CurTemp=[" << temp << "], DC=[" << dutyCycle << "]" )
-
-   for( auto fanId : fanIds )
+   if (uiUpdater)
    {
-      auto pwmcMultiplier{ FanConstants::FAN_PWMC_PROPORTIONALITY.find(fanId) };
-      if( FanConstants::FAN_PWMC_PROPORTIONALITY.end() != pwmcMultiplier)
+      UiUpdater::FanData fanData;
+      fanData.temp = temp;
+      fanData.dutyCycle = TempToDutyCycle::getDutyCycle(temp);
+      fanData.numFans = std::min( actuationPlan.size(), UiUpdater::FanData::MAX_FANS );
+
+      for( size_t idx{ 0 }; idx < fanData.numFans; ++idx )
       {
-         auto roundedDc{ static_cast<int>( std::round(dutyCycle) ) };
-         auto pwmc{ roundedDc * pwmcMultiplier->second };
-         fanRegisters.writeRegister( fanId, pwmc );
-         fanData.fans.push_back( std::make_pair( fanId, pwmc ));
+         fanData.fans[idx] = { actuationPlan.getFanId(idx), actuationPlan.getPwmc(idx, roundedDc) };
       }
-   }
-
-   if (uiUpdater)
-   {
       uiUpdater->updateFanData(fanData);
    }
-
 }
 
 //
 // Name: updateFansThread
 //
 // Description: FanControl main thread for updating Fan duty cycles.
+//    Every config.registerRefreshMs the fan registers are rewritten from
+//    their shadows (forced refresh), whether or not temps arrive: a steady
+//    stream of temps with the same duty cycle elides every write. FanGroup
+//    fans are refreshed by their own group.
 //
 void FanControl::updateFansThread()
 {
+   if (FanControlConfig::ControlMode::FIXED_RATE == config.controlMode)
+   {
+      updateFansFixedRate();
+      return;
+   }
+
+   using Clock = std::chrono::steady_clock;
+
+   const auto refreshPeriod{ std::chrono::milliseconds(config.registerRefreshMs) };
+   auto nextRefresh{ Clock::now() + refreshPeriod };
+
    while( fanThreadKeepAlive.load() )
    {
       std::unique_lock<std::mutex> guard( fanThreadMux );
-      fanThreadCond.wait( guard, [this](){ return haveNewCurrentTemp; } );
-      
-      auto localCopyTemp = currentTemp;
-      haveNewCurrentTemp = false;
+      if( fanThreadCond.wait_until( guard, nextRefresh, [this](){ return haveNewCurrentTemp; } ) )
+      {
+         auto localCopyTemp = currentTemp;
+         const auto trace{ currentTrace };
+         haveNewCurrentTemp = false;
 
-      guard.unlock();
+         guard.unlock();
+
+         if( !fanThreadKeepAlive.load() )
+         {
+            break;
+         }
+
+         updateFans(localCopyTemp);
+         tempMonitor.getLatencyRecorder().recordFanWrite( trace );
+      }
+      else
+      {
+         guard.unlock();
+      }
 
+      const auto now{ Clock::now() };
+      if( now >= nextRefresh )
+      {
+         actuationPlan.refresh();
+         nextRefresh = now + refreshPeriod;
+      }
+   }
+}
+
+//
+// Name: updateFansFixedRate
+//
+// Description: FIXED_RATE control loop. Sleeps until the next absolute tick
+//    deadline (so lateness does not accumulate into drift), then actuates
+//    once with the latest temp notified since the previous tick, if any.
+//    A tick that overruns skips the deadlines it missed rather than firing
+//    them back to back. Registers are refreshed from their shadows every
+//    config.registerRefreshMs, whether or not the ticks actuate.
+//
+void FanControl::updateFansFixedRate()
+{
+   using Clock = std::chrono::steady_clock;
+
+   const auto period{ std::chrono::duration_cast<Clock::duration>(std::chrono::milliseconds(config.controlPeriodMs)) };
+   const auto refreshPeriod{ std::chrono::milliseconds(config.registerRefreshMs) };
+
+   auto deadline{ Clock::now() + period };
+   auto lastRefresh{ Clock::now() };
+
+   while( fanThreadKeepAlive.load() )
+   {
+      std::unique_lock<std::mutex> guard( fanThreadMux );
+      fanThreadCond.wait_until( guard, deadline, [this](){ return !fanThreadKeepAlive.load(); } );
+
+      const auto now{ Clock::now() };
       if( !fanThreadKeepAlive.load() )
       {
          break;
       }
+      if( now < deadline )
+      {
+         continue; // Spurious wake up.
+      }
 
-      updateFans(localCopyTemp);
+      const auto haveTemp{ haveNewCurrentTemp };
+      const auto localCopyTemp{ currentTemp };
+      const auto trace{ currentTrace };
+      const auto notifications{ pendingNotifications };
+      haveNewCurrentTemp = false;
+      pendingNotifications = 0;
+
+      guard.unlock();
+
+      const auto lateness{ now - deadline };
+      const auto missed{ static_cast<uint64_t>(lateness / period) };
+      deadline += period * (missed + 1);
+
+      recordTick( lateness, notifications, missed );
+
+      if( haveTemp )
+      {
+         updateFans( localCopyTemp );
+         tempMonitor.getLatencyRecorder().recordFanWrite( trace );
+      }
+
+      if( (now - lastRefresh) >= refreshPeriod )
+      {
+         actuationPlan.refresh();
+         lastRefresh = now;
+      }
    }
 }
 
+//
+// Name: recordTick
+//
+// Description: Accumulates the FIXED_RATE control loop stats for one tick.
+//
+// Params: lateness - How far past its deadline the tick woke up.
+//         notifications - Max temp notifications received since the previous tick.
+//         missed - Deadlines skipped because of the lateness.
+//
+void FanControl::recordTick(std::chrono::steady_clock::duration lateness, uint64_t notifications, uint64_t missed)
+{
+   const auto latenessUs{ static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(lateness).count()) };
+
+   ticks.fetch_add( 1, std::memory_order_relaxed );
+   missedTicks.fetch_add( missed, std::memory_order_relaxed );
+   totalLatenessUs.fetch_add( latenessUs, std::memory_order_relaxed );
+   maxLatenessUs.store( std::max(maxLatenessUs.load(std::memory_order_relaxed), latenessUs), std::memory_order_relaxed ); // Single writer.
+
+   if( 0 != notifications )
+   {
+      actuations.fetch_add( 1, std::memory_order_relaxed );
+      coalescedNotifications.fetch_add( notifications - 1, std::memory_order_relaxed );
+   }
+}
+
+//
+// Name: getControlLoopStats
+//
+// Description: Snapshot of the FIXED_RATE control loop stats (all zero in
+//    EVENT mode). Counters are read individually, so they may be mutually
+//    inconsistent while the loop is running.
+//
+// Return: FanControl::ControlLoopStats
+//
+FanControl::ControlLoopStats FanControl::getControlLoopStats() const
+{
+   ControlLoopStats rVal;
+   rVal.ticks                  = ticks.load( std::memory_order_relaxed );
+   rVal.missedTicks            = missedTicks.load( std::memory_order_relaxed );
+   rVal.actuations             = actuations.load( std::memory_order_relaxed );
+   rVal.coalescedNotifications = coalescedNotifications.load( std::memory_order_relaxed );
+   rVal.maxLatenessUs          = maxLatenessUs.load( std::memory_order_relaxed );
+   rVal.meanLatenessUs         = (0 == rVal.ticks) ? 0 : (totalLatenessUs.load( std::memory_order_relaxed ) / rVal.ticks);
+   return rVal;
+}
+
 //
 // Name: notifyNewMaxTemp
 //
@@ -213,10 +506,32 @@ void FanControl::updateFansThread()
 // Params: temp - The temperature being notified.
 //
 void FanControl::notifyNewMaxTemp(float temp)
+{
+   notifyNewMaxTemp( temp, SampleTrace() );
+}
+
+//
+// Name: notifyNewMaxTemp
+//
+// Description: TempMonitorListener API - as above, with the trace of the
+//       sample that produced the temp, recorded once its fans are written.
+//
+// Params: temp - The temperature being notified.
+//         trace - The sample that produced it, if traced.
+//
+void FanControl::notifyNewMaxTemp(float temp, const SampleTrace& trace)
 {
    std::lock_guard<std::mutex> guard(fanThreadMux);
    currentTemp = temp;
+   currentTrace = trace;
    haveNewCurrentTemp = true;
 
-   fanThreadCond.notify_one();
+   if (FanControlConfig::ControlMode::FIXED_RATE == config.controlMode)
+   {
+      ++pendingNotifications; // Picked up on the next tick, no wake up.
+   }
+   else
+   {
+      fanThreadCond.notify_one();
+   }
 }
\ No newline at end of file
@@ -9,7 +9,30 @@
 * 
 *     It uses a FanRegister object to write to Fan registers, setting the PWM counts
 *     for every fan. The PWM Counts is calculated by multiplying the duty cycle by 
-*     the fan's proportionality constant.
+*     the fan's proportionality constant. The register pointer and constant of
+*     every fan are resolved once, in initialize(), into a FanActuationPlan.
+*     Register addresses are resolved by an optional RegisterBackend (e.g. a
+*     MappedRegisterBackend), raw pointers by default.
+*
+*     By default the fans are updated on every new max temp. In FIXED_RATE
+*     control mode (FanControlConfig) the fanThread instead wakes on absolute
+*     steady_clock deadlines and actuates once per tick with the latest temp,
+*     coalescing any notifications in between. Tick lateness and coalescing
+*     counts are reported by getControlLoopStats().
+*
+*     For traced samples the latency of every stage up to the fan register
+*     write is reported by getLatencyRecorder().
+*
+*     Sensors in the same process can feed temps through getTempMonitor().submit()
+*     instead of gRPC; FanControlConfig::serverMode NONE then drops the server.
+*     Daemons in other processes can write to a SharedTempTable instead
+*     (FanControlConfig::sharedTableName).
+*
+*     With ThermalZones configured, each zone's fans are handed to a FanGroup
+*     driven by that zone's max temp on its own thread; the fanThread only
+*     handles the fans that are in no zone. The fanThread and every FanGroup
+*     then report to the UiUpdater through a UiFanDataMerger, so the UI
+*     still shows every fan.
 *
 */
 
@@ -17,49 +40,96 @@
 
 #include "TempMonitorListener.h"
 #include "FanRegisters.h"
+#include "FanActuationPlan.h"
+#include "FanControlConfig.h"
+#include "FanGroup.h"
 #include "GeneralConstants.h"
 #include "TempMonitor.h"
 #include "UiUpdater.h"
+#include "UiFanDataMerger.h"
 
 #include <unordered_map>   
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <memory>
+#include <chrono>
+#include <cstdint>
 
 class FanControl final : public TempMonitorListener
 {
+   friend struct FanControlBenchAccess; // Benchmarks of updateFans.
+
+   const FanControlConfig  config;
    const std::vector<int>  fanIds;
-   UiUpdater*              uiUpdater{ nullptr };
+   UiUpdater*              uiUpdater{ nullptr };   // Replaced by a uiMerger region, if there is one.
+   std::unique_ptr<UiFanDataMerger> uiMerger;      // With ThermalZones and a UiUpdater.
 
    bool                    haveNewCurrentTemp{ false };
    float                   currentTemp{ 0.0 };
+   SampleTrace             currentTrace;              // Of currentTemp, if traced.
+   uint64_t                pendingNotifications{ 0 }; // Since the last tick, FIXED_RATE only.
 
    FanRegisters            fanRegisters;
+   FanActuationPlan        actuationPlan;   // Fans in no ThermalZone.
    TempMonitor             tempMonitor;
 
+   std::vector<std::unique_ptr<FanGroup>> fanGroups; // One per ThermalZone.
+
    std::thread             fanThread;
    std::condition_variable fanThreadCond;
    std::mutex              fanThreadMux;
    std::atomic<bool>       fanThreadKeepAlive{ false };
 
+   std::atomic<uint64_t>   ticks{ 0 };
+   std::atomic<uint64_t>   missedTicks{ 0 };
+   std::atomic<uint64_t>   actuations{ 0 };
+   std::atomic<uint64_t>   coalescedNotifications{ 0 };
+   std::atomic<uint64_t>   totalLatenessUs{ 0 };
+   std::atomic<uint64_t>   maxLatenessUs{ 0 };
+
    void updateFansThread();
+   void updateFansFixedRate();
+   void recordTick(std::chrono::steady_clock::duration lateness, uint64_t notifications, uint64_t missed);
    void updateFans( float temp ) const;
 
    GeneralConstants::ReturnCodes setFansToDefault();
+   GeneralConstants::ReturnCodes checkConfig() const;
+   GeneralConstants::ReturnCodes startFanGroups();
+   std::vector<int> getUngroupedFanIds() const;
 
 public:
+   struct ControlLoopStats
+   {
+      uint64_t ticks{ 0 };
+      uint64_t missedTicks{ 0 };            // Deadlines skipped because a tick overran.
+      uint64_t actuations{ 0 };
+      uint64_t coalescedNotifications{ 0 }; // Notifications folded into another tick's actuation.
+      uint64_t meanLatenessUs{ 0 };         // Wake up time past the tick deadline.
+      uint64_t maxLatenessUs{ 0 };
+   };
+
    FanControl( const std::vector<int>& subSystemIds,
                const std::vector<int>& fanIds,
-               UiUpdater* updater = nullptr);
+               UiUpdater* updater = nullptr,
+               const FanControlConfig& config = FanControlConfig(),
+               std::shared_ptr<RegisterBackend> registerBackend = nullptr );
 
    FanControl( const std::vector<int>& ssIds,
                const std::vector<int>& fanIds,
                const std::unordered_map<int, uint64_t>& fanAddresses,
-               UiUpdater* updater = nullptr);
+               UiUpdater* updater = nullptr,
+               const FanControlConfig& config = FanControlConfig(),
+               std::shared_ptr<RegisterBackend> registerBackend = nullptr );
    
    ~FanControl();
 
    GeneralConstants::ReturnCodes initialize();
-   void notifyNewMaxTemp(float temp);
+   void notifyNewMaxTemp(float temp) override;
+   void notifyNewMaxTemp(float temp, const SampleTrace& trace) override;
+
+   ControlLoopStats getControlLoopStats() const;
+   const LatencyRecorder& getLatencyRecorder() const { return tempMonitor.getLatencyRecorder(); }
+   TempMonitor& getTempMonitor() { return tempMonitor; }
 };
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+* Struct: FanControlConfig
+*
+* Description: Tunables for the FanControl. Default constructed values
+*     reproduce the standard behaviour.
+*
+*/
+
+#pragma once
+
+#include "FanConstants.h"
+#include "TempMonitorConfig.h"
+#include "ThermalZone.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct FanControlConfig
+{
+   enum class ControlMode
+   {
+        EVENT       // The fans are updated on every notifyNewMaxTemp.
+      , FIXED_RATE  // The fans are updated once per controlPeriodMs tick, with
+                    // the latest max temp notified since the previous tick.
+   };
+
+   ControlMode controlMode{ ControlMode::EVENT };
+
+   // FIXED_RATE: tick period, e.g. 50ms for 20Hz. Must be non zero.
+   size_t controlPeriodMs{ 50 };
+
+   // The fan registers are rewritten from their shadows at least this
+   // often, also while every actuation is elided (unchanged duty cycle).
+   // Must be non zero.
+   size_t registerRefreshMs{ FanConstants::FAN_REGISTER_REFRESH_MS };
+
+   // Each zone's fans are driven by the max temp of the zone's subsystems,
+   // by a FanGroup of their own. Zone fans must be disjoint and part of
+   // the FanControl fanIds; the remaining fans follow the global max temp
+   // (with controlMode).
+   std::vector<ThermalZone> thermalZones;
+
+   // How the TempMonitor receives temps. NONE when every sensor is in
+   // process and calls TempMonitor::submit().
+   TempMonitorConfig::ServerMode serverMode{ TempMonitorConfig::ServerMode::SYNC };
+
+   // Shared memory telemetry table for sensor daemons on the same host,
+   // empty for none. See TempMonitorConfig::sharedTableName.
+   std::string sharedTableName;
+};
\ No newline at end of file
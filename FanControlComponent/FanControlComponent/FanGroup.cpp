@@ -0,0 +1,191 @@
+#include "FanGroup.h"
+#include "FanConstants.h"
+#include "FanPwmcTables.h"
+#include "TempToDutyCycle.h"
+#include "log.h"
+
+#include <algorithm>
+#include <chrono>
+
+//
+// Name: FanGroup (ctor)
+//
+// Params: thermalZone - The zone, only its id and fanIds are used.
+//         latencyRecorder - Records traced samples' latency, nullptr for none.
+//         refreshMs - Register refresh period, non zero.
+//         updater - Callback to the UI for the zone's fan data, nullptr for none.
+//
+FanGroup::FanGroup(const ThermalZone& thermalZone, LatencyRecorder* latencyRecorder, size_t refreshMs, UiUpdater* updater)
+   : zone(thermalZone)
+   , latency(latencyRecorder)
+   , registerRefreshMs(refreshMs)
+   , uiUpdater(updater)
+{
+   // Empty
+}
+
+//
+// Name: ~FanGroup (dtor)
+//
+// Description: Stops the groupThread. The group must already be
+//    unregistered from the TempMonitor.
+//
+FanGroup::~FanGroup()
+{
+   stop();
+}
+
+//
+// Name: initialize
+//
+// Description: Compiles the zone's fans into the actuationPlan, sets them
+//    to the default duty cycle and starts the groupThread.
+//
+// Params: fanRegisters - Registers of every fan, shared with the other groups.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes FanGroup::initialize(const FanRegisters& fanRegisters)
+{
+   auto rVal{ actuationPlan.compile( zone.fanIds, fanRegisters ) };
+
+   if (GeneralConstants::ReturnCodes::SUCCESS == rVal)
+   {
+      updateFans( FanConstants::INITIAL_FAN_DUTY_CYCLE );
+
+      groupThreadKeepAlive.store(true);
+      groupThread = std::thread(&FanGroup::updateFansThread, this);
+   }
+
+   DEBUG_STD_OUT("FanGroup::initialize() - zone[" << zone.zoneId << "], fans[" << actuationPlan.size() << "]");
+   return rVal;
+}
+
+//
+// Name: stop
+//
+// Description: Causes the groupThread to exit and waits for it.
+//
+void FanGroup::stop()
+{
+   if (groupThread.joinable())
+   {
+      {
+         std::lock_guard<std::mutex> guard(groupThreadMux);
+         groupThreadKeepAlive.store(false);
+      }
+
+      groupThreadCond.notify_one();
+      groupThread.join();
+   }
+}
+
+//
+// Name: updateFans
+//
+// Description: Writes the zone's fans for the duty cycle of temp and
+//    reports their PWM counts to the UI, if there is one.
+//
+void FanGroup::updateFans(float temp)
+{
+   const auto roundedDc{ FanPwmcTables::getDutyCycle(temp) };
+
+   actuationPlan.apply( roundedDc );
+   actuations.fetch_add( 1, std::memory_order_relaxed );
+
+   if( uiUpdater )
+   {
+      UiUpdater::FanData fanData;
+      fanData.temp = temp;
+      fanData.dutyCycle = TempToDutyCycle::getDutyCycle(temp);
+      fanData.numFans = std::min( actuationPlan.size(), UiUpdater::FanData::MAX_FANS );
+
+      for( size_t idx{ 0 }; idx < fanData.numFans; ++idx )
+      {
+         fanData.fans[idx] = { actuationPlan.getFanId(idx), actuationPlan.getPwmc(idx, roundedDc) };
+      }
+      uiUpdater->updateFanData(fanData);
+   }
+}
+
+//
+// Name: updateFansThread
+//
+// Description: Applies the latest zone max temp. Every registerRefreshMs
+//    the zone's registers are rewritten from their shadows, whether or not
+//    temps arrive.
+//
+void FanGroup::updateFansThread()
+{
+   using Clock = std::chrono::steady_clock;
+
+   const auto refreshPeriod{ std::chrono::milliseconds(registerRefreshMs) };
+   auto nextRefresh{ Clock::now() + refreshPeriod };
+
+   while( groupThreadKeepAlive.load() )
+   {
+      std::unique_lock<std::mutex> guard( groupThreadMux );
+      if( groupThreadCond.wait_until( guard, nextRefresh,
+                                      [this](){ return haveNewCurrentTemp || !groupThreadKeepAlive.load(); } ) )
+      {
+         auto localCopyTemp{ currentTemp };
+         const auto trace{ currentTrace };
+         haveNewCurrentTemp = false;
+
+         guard.unlock();
+
+         if( !groupThreadKeepAlive.load() )
+         {
+            break;
+         }
+
+         updateFans( localCopyTemp );
+         if( latency )
+         {
+            latency->recordFanWrite( trace );
+         }
+      }
+      else
+      {
+         guard.unlock();
+      }
+
+      const auto now{ Clock::now() };
+      if( now >= nextRefresh )
+      {
+         actuationPlan.refresh();
+         nextRefresh = now + refreshPeriod;
+      }
+   }
+}
+
+//
+// Name: notifyNewMaxTemp
+//
+// Description: TempMonitorListener API - the zone has a new max temp.
+//
+// Params: temp - The zone's max temp.
+//
+void FanGroup::notifyNewMaxTemp(float temp)
+{
+   notifyNewMaxTemp( temp, SampleTrace() );
+}
+
+//
+// Name: notifyNewMaxTemp
+//
+// Description: TempMonitorListener API - as above, with the trace of the
+//    sample that produced the temp.
+//
+// Params: temp - The zone's max temp.
+//         trace - The sample that produced it, if traced.
+//
+void FanGroup::notifyNewMaxTemp(float temp, const SampleTrace& trace)
+{
+   std::lock_guard<std::mutex> guard(groupThreadMux);
+   currentTemp = temp;
+   currentTrace = trace;
+   haveNewCurrentTemp = true;
+
+   groupThreadCond.notify_one();
+}
\ No newline at end of file
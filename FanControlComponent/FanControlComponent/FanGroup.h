@@ -0,0 +1,80 @@
+/*
+* Class: FanGroup
+*
+* Description: Drives the fans of one ThermalZone from that zone's max
+*     temp. It registers with the TempMonitor as a zone listener and has its
+*     own FanActuationPlan and thread, so every zone actuates independently
+*     of (and in parallel with) the others and the FanControl's global fans.
+*
+*     The fans of different groups must be disjoint: a group only writes the
+*     registers and shadows of its own fans, which is what makes it safe for
+*     groups to share one FanRegisters across threads.
+*
+*     Like the FanControl fanThread, the group thread rewrites its fans'
+*     registers from their shadows every registerRefreshMs, also while a
+*     steady stream of temps elides every write.
+*
+*     Given a LatencyRecorder, the group records the latency of traced
+*     samples up to its fan register write. Given a UiUpdater (a
+*     UiFanDataMerger region, see FanControl), it reports its fans' PWM counts
+*     on every actuation.
+*
+*/
+
+#pragma once
+
+#include "TempMonitorListener.h"
+#include "FanActuationPlan.h"
+#include "FanConstants.h"
+#include "FanRegisters.h"
+#include "ThermalZone.h"
+#include "GeneralConstants.h"
+#include "LatencyRecorder.h"
+#include "UiUpdater.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class FanGroup final : public TempMonitorListener
+{
+   const ThermalZone       zone;
+   FanActuationPlan        actuationPlan;
+   LatencyRecorder*        latency{ nullptr };
+   const size_t            registerRefreshMs;
+   UiUpdater*              uiUpdater{ nullptr };
+
+   bool                    haveNewCurrentTemp{ false };
+   float                   currentTemp{ 0.0f };
+   SampleTrace             currentTrace;          // Of currentTemp, if traced.
+
+   std::thread             groupThread;
+   std::condition_variable groupThreadCond;
+   std::mutex              groupThreadMux;
+   std::atomic<bool>       groupThreadKeepAlive{ false };
+
+   std::atomic<uint64_t>   actuations{ 0 };
+
+   void updateFansThread();
+   void updateFans(float temp);
+
+public:
+   explicit FanGroup(const ThermalZone& thermalZone, LatencyRecorder* latencyRecorder = nullptr,
+                     size_t refreshMs = FanConstants::FAN_REGISTER_REFRESH_MS, UiUpdater* updater = nullptr);
+   ~FanGroup();
+
+   FanGroup(const FanGroup&) = delete;
+   FanGroup& operator=(const FanGroup&) = delete;
+
+   GeneralConstants::ReturnCodes initialize(const FanRegisters& fanRegisters);
+   void stop();
+
+   void notifyNewMaxTemp(float temp) override;
+   void notifyNewMaxTemp(float temp, const SampleTrace& trace) override;
+
+   int      getZoneId() const { return zone.zoneId; }
+   uint64_t getActuations() const { return actuations.load(std::memory_order_relaxed); }
+};
\ No newline at end of file
@@ -0,0 +1,127 @@
+/*
+* File: FanPwmcTables
+*
+* Description: Compile-time lookup tables for the fan control computation,
+*     generated from TempToDutyCycle and FanConstants.
+*
+*     The temperature is quantized to 1/TEMP_STEPS_PER_DEGREE of a degree
+*     across [TEMP_MIN, TEMP_MAX]. DUTY_CYCLE_BY_TEMP_STEP maps a step to the
+*     rounded duty cycle (DC_MIN..DC_MAX percent), and each PWMC_BY_FAN row
+*     maps a rounded duty cycle to that fan's PWM counts. Setting every fan
+*     is then one indexed load per fan.
+*
+*/
+
+#pragma once
+
+#include "TempToDutyCycle.h"
+#include "FanConstants.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace FanPwmcTables
+{
+   constexpr int    DC_MIN{ static_cast<int>(TempToDutyCycle::DC_MIN) };
+   constexpr int    DC_MAX{ static_cast<int>(TempToDutyCycle::DC_MAX) };
+   constexpr size_t NUM_DUTY_CYCLES{ static_cast<size_t>(DC_MAX - DC_MIN + 1) };
+
+   // The duty cycle moves 1.6% per degree, so a 1/16 degree step shifts a
+   // rounding boundary by at most 1/32 of a degree.
+   constexpr int    TEMP_STEPS_PER_DEGREE{ 16 };
+   constexpr size_t NUM_TEMP_STEPS{ static_cast<size_t>(TempToDutyCycle::DIVISOR) * TEMP_STEPS_PER_DEGREE + 1 };
+
+   using PwmcRow = std::array<uint32_t, NUM_DUTY_CYCLES>;
+
+   //
+   // Name: getTempStep
+   //
+   // Description: Quantizes temp to the nearest step, clamped to the table.
+   //    NaN maps to the last step (max duty cycle), failing safe.
+   //
+   constexpr size_t getTempStep(float temp)
+   {
+      size_t rVal{ 0 };
+
+      if (!(temp < TempToDutyCycle::TEMP_MAX))
+      {
+         rVal = NUM_TEMP_STEPS - 1;
+      }
+      else if (temp > TempToDutyCycle::TEMP_MIN)
+      {
+         rVal = static_cast<size_t>(((temp - TempToDutyCycle::TEMP_MIN) * TEMP_STEPS_PER_DEGREE) + 0.5f);
+      }
+      return rVal;
+   }
+
+   constexpr std::array<uint8_t, NUM_TEMP_STEPS> makeDutyCycleTable()
+   {
+      std::array<uint8_t, NUM_TEMP_STEPS> rVal{};
+      for (size_t step{ 0 }; step < NUM_TEMP_STEPS; ++step)
+      {
+         const auto temp{ TempToDutyCycle::TEMP_MIN + (static_cast<float>(step) / TEMP_STEPS_PER_DEGREE) };
+         rVal[step] = static_cast<uint8_t>(TempToDutyCycle::getDutyCycle(temp) + 0.5f);
+      }
+      return rVal;
+   }
+
+   constexpr PwmcRow makePwmcRow(int multiplier)
+   {
+      PwmcRow rVal{};
+      for (size_t idx{ 0 }; idx < NUM_DUTY_CYCLES; ++idx)
+      {
+         rVal[idx] = static_cast<uint32_t>((DC_MIN + static_cast<int>(idx)) * multiplier);
+      }
+      return rVal;
+   }
+
+   constexpr std::array<PwmcRow, FanConstants::FAN_PWMC_PROPORTIONALITY_TABLE.size()> makePwmcTables()
+   {
+      std::array<PwmcRow, FanConstants::FAN_PWMC_PROPORTIONALITY_TABLE.size()> rVal{};
+      for (size_t fan{ 0 }; fan < rVal.size(); ++fan)
+      {
+         rVal[fan] = makePwmcRow(FanConstants::FAN_PWMC_PROPORTIONALITY_TABLE[fan].second);
+      }
+      return rVal;
+   }
+
+   // Temp step -> rounded duty cycle.
+   inline constexpr auto DUTY_CYCLE_BY_TEMP_STEP{ makeDutyCycleTable() };
+
+   // Parallel to FanConstants::FAN_PWMC_PROPORTIONALITY_TABLE: (duty cycle - DC_MIN) -> PWMC.
+   inline constexpr auto PWMC_BY_FAN{ makePwmcTables() };
+
+   static_assert(DC_MIN == DUTY_CYCLE_BY_TEMP_STEP.front());
+   static_assert(DC_MAX == DUTY_CYCLE_BY_TEMP_STEP.back());
+
+   //
+   // Name: getDutyCycle
+   //
+   // Return: int - Rounded duty cycle for temp, DC_MIN..DC_MAX.
+   //
+   constexpr int getDutyCycle(float temp)
+   {
+      return DUTY_CYCLE_BY_TEMP_STEP[getTempStep(temp)];
+   }
+
+   //
+   // Name: findPwmcRow
+   //
+   // Return: const PwmcRow* - The fan's PWMC row, nullptr if the fan has no
+   //       proportionality constant.
+   //
+   constexpr const PwmcRow* findPwmcRow(int fanId)
+   {
+      for (size_t fan{ 0 }; fan < PWMC_BY_FAN.size(); ++fan)
+      {
+         if (fanId == FanConstants::FAN_PWMC_PROPORTIONALITY_TABLE[fan].first)
+         {
+            return &PWMC_BY_FAN[fan];
+         }
+      }
+      return nullptr;
+   }
+
+   static_assert(95 * 8 == (*findPwmcRow(6))[95 - DC_MIN]);
+};
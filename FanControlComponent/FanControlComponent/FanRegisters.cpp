@@ -1,16 +1,47 @@
 #include "FanRegisters.h"
 #include "log.h"
 
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
 //
 // Name: FanRegister (ctor)
 //
 // Description: Constructor
 //
 // Params: fanAddresses - map of pairs (FanId, register address)
+//         registerBackend - Resolves the register addresses, nullptr for
+//             RawRegisterBackend (the address is the pointer).
 //
-FanRegisters::FanRegisters( const std::unordered_map<int, uint64_t>& fanAddresses )
+FanRegisters::FanRegisters( const std::unordered_map<int, uint64_t>& fanAddresses,
+                            std::shared_ptr<RegisterBackend> registerBackend )
    : fanAddressLut(fanAddresses)
+   , backend(registerBackend ? std::move(registerBackend) : std::make_shared<RawRegisterBackend>())
+   , shadows(new uint64_t[fanAddresses.size()])
+   , pending(new uint64_t[fanAddresses.size()])
 {
+   std::vector<std::pair<volatile uint32_t*, int>> registers;
+   registers.reserve( fanAddressLut.size() );
+   for( const auto& [fanId, fanAddress] : fanAddressLut )
+   {
+      registers.emplace_back( backend->resolve(fanAddress), fanId );
+   }
+
+   // Slots are in register address order, so walking the slots (refresh,
+   // writeRegisters) walks the register bank sequentially.
+   std::sort( registers.begin(), registers.end(), [](const auto& lhs, const auto& rhs)
+   {
+      return reinterpret_cast<uintptr_t>(lhs.first) < reinterpret_cast<uintptr_t>(rhs.first);
+   });
+
+   for( const auto& [reg, fanId] : registers )
+   {
+      shadows[registersBySlot.size()] = NO_SHADOW;
+      pending[registersBySlot.size()] = NO_SHADOW;
+      shadowSlots.emplace( fanId, registersBySlot.size() );
+      registersBySlot.push_back( reg );
+   }
    DEBUG_STD_OUT("FanRegisters::ctor() - EXIT");
 }
 
@@ -27,18 +58,91 @@ FanRegisters::~FanRegisters()
 //
 // Name: WriteRegister
 //
-// Description: Writes the pwmc value to the fanId register.
+// Description: Writes the pwmc value to the fanId register, unless the
+//    shadow shows the register already holds it.
 //
 // Params: fanId - Fan ID to be used for address lookup.
 //         pwmc  - PWM Counts to be written into the address.
+//         force - Write even if the shadow matches.
 //
-void FanRegisters::writeRegister(int fanId, unsigned int pwmc) const
+void FanRegisters::writeRegister(int fanId, unsigned int pwmc, bool force) const
 {
-   auto fanAddr{ getFanRegAddr(fanId) };
-   if( nullptr != fanAddr )
+   auto slotItr{ shadowSlots.find(fanId) };
+   if( (shadowSlots.end() != slotItr) && (nullptr != registersBySlot[slotItr->second]) )
+   {
+      auto& shadow{ shadows[slotItr->second] };
+      if( force || (shadow != pwmc) )
+      {
+         *registersBySlot[slotItr->second] = pwmc;
+         shadow = pwmc;
+         countWrites( 1, 0 );
+      }
+      else
+      {
+         countWrites( 0, 1 );
+      }
+   }
+}
+
+//
+// Name: writeRegisters
+//
+// Description: Writes a batch of PWMCs. Each write is staged in its fan's
+//    slot, and since slots are in register address order, sweeping the
+//    staged slots writes the registers in ascending address order without
+//    a sort. Registers whose shadow already holds the value are skipped,
+//    then a single fence orders the whole batch before anything that
+//    follows it. If a fan appears more than once, its last write wins.
+//
+// Params: writes - FanId and PWMC pairs, unknown fans are ignored.
+//         force - Write even if the shadow matches.
+//
+void FanRegisters::writeRegisters(std::span<const FanWrite> writes, bool force) const
+{
+   auto firstSlot{ registersBySlot.size() };
+   size_t endSlot{ 0 };
+
+   for( const auto& write : writes )
    {
-      *fanAddr = pwmc;
+      auto slotItr{ shadowSlots.find(write.fanId) };
+      if( (shadowSlots.end() != slotItr) && (nullptr != registersBySlot[slotItr->second]) )
+      {
+         const auto slot{ slotItr->second };
+         pending[slot] = write.pwmc;
+         firstSlot = std::min( firstSlot, slot );
+         endSlot   = std::max( endSlot, slot + 1 );
+      }
    }
+
+   uint64_t written{ 0 };
+   uint64_t elided{ 0 };
+   for( auto slot{ firstSlot }; slot < endSlot; ++slot )
+   {
+      const auto pwmc{ pending[slot] };
+      if( NO_SHADOW == pwmc )
+      {
+         continue;
+      }
+      pending[slot] = NO_SHADOW;
+
+      auto& shadow{ shadows[slot] };
+      if( force || (shadow != pwmc) )
+      {
+         *registersBySlot[slot] = static_cast<uint32_t>(pwmc);
+         shadow = pwmc;
+         ++written;
+      }
+      else
+      {
+         ++elided;
+      }
+   }
+
+   if( 0 != written )
+   {
+      std::atomic_thread_fence( std::memory_order_seq_cst );
+   }
+   countWrites( written, elided );
 }
 
 //
@@ -64,54 +168,123 @@ int FanRegisters::readRegister(int fanId) const
 //
 // Name: clearRegister
 //
-// Description: sets the FanID register to zero
+// Description: sets the FanID register to zero (always written).
 //
 // Params: fanId - Fan ID to be used for address lookup and clearing.
 //
 void FanRegisters::clearRegister(int fanId) const
 {
-   writeRegister( fanId );
+   writeRegister( fanId, 0, true );
 }
 
 //
-// Name: getFanRegAddr
+// Name: getFanShadow
 //
-// Description: Returns a pointer to the FanID register.
+// Description: Returns a pointer to the FanID register's shadow, for
+//    callers that write registers directly (FanActuationPlan). Such callers
+//    must keep the shadow up to date and report through countWrites.
 //
 // Params: fanId - Fan ID to be used for address lookup.
 //
-// Return: uin32_t* - Pointer to the FanID register address.
+// Return: uint64_t* - Shadow of the register, NO_SHADOW until first written.
 //
-volatile uint32_t* FanRegisters::getFanRegAddr(int fanId) const
+uint64_t* FanRegisters::getFanShadow(int fanId) const
 {
-   volatile uint32_t* rVal{ nullptr };
+   uint64_t* rVal{ nullptr };
+
+   auto slotItr{ shadowSlots.find(fanId) };
+   if( shadowSlots.end() != slotItr )
+   {
+      rVal = &shadows[slotItr->second];
+   }
+   return rVal;
+}
 
-   auto fanAddrItr = fanAddressLut.find(fanId);
-   if(fanAddressLut.end() != fanAddrItr)
+//
+// Name: refresh
+//
+// Description: Forced refresh. Rewrites every register that has been
+//    written before with its shadow value, whether or not it changed,
+//    in register address order, followed by a single fence.
+//
+void FanRegisters::refresh() const
+{
+   uint64_t written{ 0 };
+
+   for( size_t slot{ 0 }; slot < registersBySlot.size(); ++slot )
+   {
+      if( (NO_SHADOW != shadows[slot]) && (nullptr != registersBySlot[slot]) )
+      {
+         *registersBySlot[slot] = static_cast<uint32_t>(shadows[slot]);
+         ++written;
+      }
+   }
+
+   if( 0 != written )
+   {
+      std::atomic_thread_fence( std::memory_order_seq_cst );
+   }
+   countWrites( written, 0 );
+}
+
+//
+// Name: countWrites
+//
+// Description: Adds to the real / elided write counters.
+//
+void FanRegisters::countWrites(uint64_t written, uint64_t elided) const
+{
+   if( 0 != written )
+   {
+      realWrites.fetch_add( written, std::memory_order_relaxed );
+   }
+   if( 0 != elided )
    {
-      rVal = fanRegAddr( fanAddrItr->second );
+      elidedWrites.fetch_add( elided, std::memory_order_relaxed );
    }
+}
+
+//
+// Name: getWriteStats
+//
+// Return: FanRegisters::WriteStats - Real and elided register writes so far.
+//
+FanRegisters::WriteStats FanRegisters::getWriteStats() const
+{
+   WriteStats rVal;
+   rVal.written = realWrites.load( std::memory_order_relaxed );
+   rVal.elided  = elidedWrites.load( std::memory_order_relaxed );
    return rVal;
 }
 
 //
-// Name: fanRegAddr
+// Name: getFanRegAddr
 //
-// Description: Converts the numeric address to an actual ponter.
+// Description: Returns a pointer to the FanID register, as resolved by
+//    the RegisterBackend.
 //
-// Params: fanAddress - Numeric address
+// Params: fanId - Fan ID to be used for address lookup.
 //
-// Return: uin32_t* - Pointer versoin of the provided numeric address.
+// Return: uin32_t* - Pointer to the FanID register, nullptr if the fan is
+//       unknown or the backend has no register at its address.
 //
-inline volatile uint32_t* FanRegisters::fanRegAddr(uint64_t fanAddress) const
+volatile uint32_t* FanRegisters::getFanRegAddr(int fanId) const
 {
-   return reinterpret_cast<volatile uint32_t*>(fanAddress);
+   volatile uint32_t* rVal{ nullptr };
+
+   auto slotItr{ shadowSlots.find(fanId) };
+   if( shadowSlots.end() != slotItr )
+   {
+      rVal = registersBySlot[slotItr->second];
+   }
+   return rVal;
 }
 
 //
 // Name: checkFanIds
 //
-// Description: Checks that the FanIds provided all have fan addresses.
+// Description: Checks that the FanIds provided all have fan addresses,
+//    and that the RegisterBackend resolved them to registers.
 //
 // Params: fanIds - Vector of FanIds to be checked.
 //
@@ -136,6 +309,12 @@ GeneralConstants::ReturnCodes FanRegisters::checkFanIds(const std::vector<int>&
             break;
          }
 
+         if (nullptr == getFanRegAddr(fanId))
+         {
+            rVal = GeneralConstants::ReturnCodes::NO_FAN_REGISTER;
+            break;
+         }
+
          auto fanMultItr{ fanAddressLut.find(fanId) };
          if (fanMultItr == fanAddressLut.end())
          {
@@ -2,7 +2,20 @@
 * Class: FanRegisters
 *
 * Description: Provides read, write and clearing to the memory addresses
-*     provided in the map of [FanIds, Fan Memory Address].
+*     provided in the map of [FanIds, Fan Memory Address]. The addresses are
+*     resolved to registers once, at construction, by a RegisterBackend
+*     (raw pointers by default).
+*
+*     Keeps a shadow copy of the last value written to each register and
+*     skips writes that would not change it (register writes over MMIO or
+*     a slow bus are the expensive part of a fan update). refresh()
+*     rewrites every register from its shadow, so a register that lost
+*     its value is corrected periodically. Real and elided writes are
+*     counted, see getWriteStats().
+*
+*     writeRegisters() writes a batch of fans in ascending register address
+*     order followed by a single memory fence, instead of one lookup per
+*     write. Registers are always written 32 bits at a time.
 *
 * WARNING: Not thread safe. 
 * 
@@ -11,24 +24,58 @@
 #pragma once
 
 #include "GeneralConstants.h"
+#include "RegisterBackend.h"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 class FanRegisters final
 {
    const std::unordered_map<int,uint64_t> fanAddressLut;
+   const std::shared_ptr<RegisterBackend> backend;
 
-   inline volatile uint32_t* fanRegAddr(uint64_t fanAddress) const;
-   volatile uint32_t* getFanRegAddr(int fanId) const;
+   std::unordered_map<int, size_t>     shadowSlots;       // FanId -> slot.
+   std::vector<volatile uint32_t*>     registersBySlot;
+   std::unique_ptr<uint64_t[]>         shadows;           // Last value written, by slot.
+   std::unique_ptr<uint64_t[]>         pending;           // writeRegisters staging by slot, NO_SHADOW when empty.
+
+   mutable std::atomic<uint64_t>       realWrites{ 0 };
+   mutable std::atomic<uint64_t>       elidedWrites{ 0 };
 
 public:
+   static constexpr uint64_t NO_SHADOW{ UINT64_MAX }; // Register not written yet.
+
+   struct FanWrite
+   {
+      int      fanId{ 0 };
+      uint32_t pwmc{ 0 };
+   };
 
-   FanRegisters(const std::unordered_map<int, uint64_t>& fanAddresses );
+   struct WriteStats
+   {
+      uint64_t written{ 0 };  // Register writes performed.
+      uint64_t elided{ 0 };   // Writes skipped because the shadow matched.
+   };
+
+   FanRegisters(const std::unordered_map<int, uint64_t>& fanAddresses,
+                std::shared_ptr<RegisterBackend> registerBackend = nullptr );
    ~FanRegisters();
 
-   void writeRegister( int fanId, unsigned int pwmc = 0 ) const;
+   void writeRegister( int fanId, unsigned int pwmc = 0, bool force = false ) const;
+   void writeRegisters( std::span<const FanWrite> writes, bool force = false ) const;
    int  readRegister ( int fanId ) const;
    void clearRegister( int fanId ) const;
 
+   volatile uint32_t* getFanRegAddr(int fanId) const;
+   uint64_t*          getFanShadow(int fanId) const;
+
+   void       refresh() const;
+   void       countWrites(uint64_t written, uint64_t elided) const;
+   WriteStats getWriteStats() const;
+
    GeneralConstants::ReturnCodes checkFanIds(const std::vector<int>& fanIds) const;
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <string>
 #include <unordered_map>
 
 namespace GeneralConstants
@@ -14,6 +16,13 @@ namespace GeneralConstants
 
    const std::string GRPC_SERVER_ADDRESS{"0.0.0.0:50051"};
 
+   // Long-lived client streams never finish on their own; after this long
+   // server Shutdown cancels them.
+   constexpr int GRPC_SERVER_SHUTDOWN_DEADLINE_MS{ 500 };
+
+   // Used to keep data written by different threads on separate cache lines.
+   constexpr size_t CACHE_LINE_SIZE{ 64 };
+
    enum class ReturnCodes
    {
         RETURN_CODE_NOT_SET
@@ -24,9 +33,17 @@ namespace GeneralConstants
       , NO_FAN_MULTIPLIER
       , FAN_CONTROL_INIT_FAILED
       , FAN_CONTROL_TOO_MANY_FAN_IDS_ERROR
+      , FAN_CONTROL_INVALID_CONFIG
+      , REGISTER_BACKEND_OPEN_FAILED
+      , SHARED_TEMP_TABLE_OPEN_FAILED
+      , LOAD_GENERATOR_INVALID_CONFIG
       , TEMP_MONITOR_INIT_FAILED
+      , TEMP_MONITOR_INVALID_CONFIG
       , TEMP_MONITOR_LISTENER_REG_FAILED
       , TEMP_MONITOR_LISTENER_UNREG_FAILED
+      , TEMP_MONITOR_QUEUE_FULL
+      , TEMP_MONITOR_INVALID_BATCH
+      , TEMP_MONITOR_BATCH_PARTIAL
       , UNKNOWN_ERROR
       , UNKNOWN_RETURN_CODE
    };
@@ -41,9 +58,17 @@ namespace GeneralConstants
       , { ReturnCodes::NO_FAN_MULTIPLIER                  , "No fan PWMC Multiplier was found." }
       , { ReturnCodes::FAN_CONTROL_INIT_FAILED            , "Fan Control Initialization failed." }
       , { ReturnCodes::FAN_CONTROL_TOO_MANY_FAN_IDS_ERROR , "Fan Control was given more fan Ids than are supported." }
+      , { ReturnCodes::FAN_CONTROL_INVALID_CONFIG         , "Fan Control configuration is invalid." }
+      , { ReturnCodes::REGISTER_BACKEND_OPEN_FAILED       , "Register backend could not map its registers." }
+      , { ReturnCodes::SHARED_TEMP_TABLE_OPEN_FAILED      , "Shared temp table could not be created or mapped." }
+      , { ReturnCodes::LOAD_GENERATOR_INVALID_CONFIG      , "Load generator configuration is invalid." }
       , { ReturnCodes::TEMP_MONITOR_INIT_FAILED           , "TempMonitor initialization failed." }
+      , { ReturnCodes::TEMP_MONITOR_INVALID_CONFIG        , "TempMonitor configuration is invalid." }
       , { ReturnCodes::TEMP_MONITOR_LISTENER_REG_FAILED   , "TempMonitor was unable to register the listener (possible duplicate)." }
       , { ReturnCodes::TEMP_MONITOR_LISTENER_UNREG_FAILED , "TempMonitor was unable to unregister the listener becaues it could not be found." }
+      , { ReturnCodes::TEMP_MONITOR_QUEUE_FULL            , "TempMonitor ingestion queue is full." }
+      , { ReturnCodes::TEMP_MONITOR_INVALID_BATCH         , "TempMonitor batch subsystem ids and temps differ in size." }
+      , { ReturnCodes::TEMP_MONITOR_BATCH_PARTIAL         , "TempMonitor ingestion queue is full, part of the batch was dropped." }
       , { ReturnCodes::UNKNOWN_ERROR                      , "Unknown Error occured." }
       , { ReturnCodes::UNKNOWN_RETURN_CODE                , "Unknown Return Code" }
    };
@@ -0,0 +1,173 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+//
+// Name: LatencyHistogram (ctor)
+//
+// Description: Allocates the (zeroed) counters.
+//
+LatencyHistogram::LatencyHistogram()
+   : counts(std::make_unique<std::atomic<uint64_t>[]>(NUM_COUNTS))
+{
+   // Empty
+}
+
+//
+// Name: getIndex
+//
+// Description: The counter of valueNs. Below SUB_BUCKET_COUNT the value is
+//    its own index; above, the value is shifted right until it falls in the
+//    upper half of the sub-buckets, and each shift moves on by half a
+//    sub-bucket range.
+//
+size_t LatencyHistogram::getIndex(uint64_t valueNs)
+{
+   const auto value{ std::min(valueNs, MAX_VALUE_NS) };
+   const auto msb{ static_cast<uint32_t>(std::bit_width(value | 1)) - 1 };
+   const auto shift{ (msb < SUB_BUCKET_BITS) ? 0u : (msb - SUB_BUCKET_BITS + 1) };
+
+   return static_cast<size_t>((shift * SUB_BUCKET_HALF) + (value >> shift));
+}
+
+//
+// Name: getHighestValue
+//
+// Description: Inverse of getIndex, the largest value counted by index.
+//
+uint64_t LatencyHistogram::getHighestValue(size_t index)
+{
+   const auto shift{ (index < SUB_BUCKET_COUNT) ? uint64_t{ 0 } : ((index / SUB_BUCKET_HALF) - 1) };
+   const auto subBucket{ index - (shift * SUB_BUCKET_HALF) };
+
+   return ((subBucket + 1) << shift) - 1;
+}
+
+//
+// Name: record
+//
+// Description: Counts one latency. Lock-free, callable from any thread.
+//
+// Params: valueNs - Latency in nanoseconds, clamped to MAX_VALUE_NS.
+//
+void LatencyHistogram::record(uint64_t valueNs)
+{
+   const auto value{ std::min(valueNs, MAX_VALUE_NS) };
+
+   counts[getIndex(value)].fetch_add(1, std::memory_order_relaxed);
+   totalCount.fetch_add(1, std::memory_order_relaxed);
+   totalNs.fetch_add(value, std::memory_order_relaxed);
+
+   auto curMin{ minNs.load(std::memory_order_relaxed) };
+   while ((value < curMin) && !minNs.compare_exchange_weak(curMin, value, std::memory_order_relaxed))
+   {
+      // Retry with the updated min.
+   }
+
+   auto curMax{ maxNs.load(std::memory_order_relaxed) };
+   while ((value > curMax) && !maxNs.compare_exchange_weak(curMax, value, std::memory_order_relaxed))
+   {
+      // Retry with the updated max.
+   }
+}
+
+//
+// Name: reset
+//
+// Description: Clears every counter. Samples recorded concurrently may be
+//    partially kept.
+//
+void LatencyHistogram::reset()
+{
+   for (size_t idx{ 0 }; idx < NUM_COUNTS; ++idx)
+   {
+      counts[idx].store(0, std::memory_order_relaxed);
+   }
+   totalCount.store(0, std::memory_order_relaxed);
+   totalNs.store(0, std::memory_order_relaxed);
+   minNs.store(UINT64_MAX, std::memory_order_relaxed);
+   maxNs.store(0, std::memory_order_relaxed);
+}
+
+//
+// Name: getMin
+//
+// Return: uint64_t - Smallest latency recorded, 0 if none.
+//
+uint64_t LatencyHistogram::getMin() const
+{
+   const auto rVal{ minNs.load(std::memory_order_relaxed) };
+   return (UINT64_MAX == rVal) ? 0 : rVal;
+}
+
+//
+// Name: getMean
+//
+// Return: uint64_t - Mean latency, 0 if none recorded.
+//
+uint64_t LatencyHistogram::getMean() const
+{
+   const auto count{ getCount() };
+   return (0 == count) ? 0 : (totalNs.load(std::memory_order_relaxed) / count);
+}
+
+//
+// Name: getPercentile
+//
+// Description: The latency that percentile percent of the samples do not
+//    exceed, to within the bucket precision (never above getMax()).
+//
+// Params: percentile - 0 to 100, e.g. 99.9.
+//
+// Return: uint64_t - Latency in nanoseconds, 0 if none recorded.
+//
+uint64_t LatencyHistogram::getPercentile(double percentile) const
+{
+   uint64_t total{ 0 };
+   for (size_t idx{ 0 }; idx < NUM_COUNTS; ++idx)
+   {
+      total += counts[idx].load(std::memory_order_relaxed);
+   }
+
+   uint64_t rVal{ 0 };
+   if (0 != total)
+   {
+      const auto clamped{ std::clamp(percentile, 0.0, 100.0) };
+      const auto target{ std::max(uint64_t{ 1 }, static_cast<uint64_t>(std::ceil((clamped / 100.0) * static_cast<double>(total)))) };
+
+      uint64_t seen{ 0 };
+      for (size_t idx{ 0 }; idx < NUM_COUNTS; ++idx)
+      {
+         seen += counts[idx].load(std::memory_order_relaxed);
+         if (seen >= target)
+         {
+            rVal = std::min(getHighestValue(idx), getMax());
+            break;
+         }
+      }
+   }
+   return rVal;
+}
+
+//
+// Name: dump
+//
+// Description: Writes a one line summary, in microseconds, e.g.
+//    "count=1000 min=12.3 p50=40.1 p90=55.0 p99=80.2 p99.9=120.7 max=130.0 mean=42.0 (us)"
+//
+void LatencyHistogram::dump(std::ostream& os) const
+{
+   const auto toUs{ [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; } };
+
+   os << "count=" << getCount()
+      << " min="   << toUs(getMin())
+      << " p50="   << toUs(getPercentile(50.0))
+      << " p90="   << toUs(getPercentile(90.0))
+      << " p99="   << toUs(getPercentile(99.0))
+      << " p99.9=" << toUs(getPercentile(99.9))
+      << " max="   << toUs(getMax())
+      << " mean="  << toUs(getMean())
+      << " (us)";
+}
\ No newline at end of file
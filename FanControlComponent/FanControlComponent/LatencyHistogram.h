@@ -0,0 +1,62 @@
+/*
+* Class: LatencyHistogram
+*
+* Description: HDR style histogram of latencies in nanoseconds. Values
+*     below 2^SUB_BUCKET_BITS are counted exactly; above that every power of
+*     two is split into 2^(SUB_BUCKET_BITS - 1) linear sub-buckets, so any
+*     value is reported within 1/64 (about 1.6%) of what was recorded, from
+*     nanoseconds up to MAX_VALUE_NS, in a fixed array of counters.
+*
+*     record() is lock-free (relaxed atomic increments) and may be called
+*     from any number of threads. The queries scan the counters without
+*     stopping the writers, so while samples are being recorded they see an
+*     approximate snapshot.
+*
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+
+class LatencyHistogram final
+{
+public:
+   static constexpr uint32_t SUB_BUCKET_BITS{ 7 };
+   static constexpr uint32_t MAX_VALUE_BITS{ 40 };
+   static constexpr uint64_t MAX_VALUE_NS{ (uint64_t{ 1 } << MAX_VALUE_BITS) - 1 }; // ~18 minutes, larger values are clamped.
+
+private:
+   static constexpr uint64_t SUB_BUCKET_COUNT{ uint64_t{ 1 } << SUB_BUCKET_BITS };
+   static constexpr uint64_t SUB_BUCKET_HALF{ SUB_BUCKET_COUNT / 2 };
+   static constexpr size_t   NUM_COUNTS{ (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) * SUB_BUCKET_HALF };
+
+   std::unique_ptr<std::atomic<uint64_t>[]> counts; // Heap, ~18KB.
+   std::atomic<uint64_t> totalCount{ 0 };
+   std::atomic<uint64_t> totalNs{ 0 };
+   std::atomic<uint64_t> minNs{ UINT64_MAX };
+   std::atomic<uint64_t> maxNs{ 0 };
+
+   static size_t getIndex(uint64_t valueNs);
+   static uint64_t getHighestValue(size_t index);
+
+public:
+   LatencyHistogram();
+
+   LatencyHistogram(const LatencyHistogram&) = delete;
+   LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+   void record(uint64_t valueNs);
+   void reset();
+
+   uint64_t getCount() const { return totalCount.load(std::memory_order_relaxed); }
+   uint64_t getMin() const;
+   uint64_t getMax() const { return maxNs.load(std::memory_order_relaxed); }
+   uint64_t getMean() const;
+   uint64_t getPercentile(double percentile) const;
+
+   void dump(std::ostream& os) const;
+};
\ No newline at end of file
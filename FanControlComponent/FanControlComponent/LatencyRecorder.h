@@ -0,0 +1,105 @@
+/*
+* Class: LatencyRecorder
+*
+* Description: One LatencyHistogram per stage of the sensor to fan register
+*     path of traced samples (see SampleTrace). Owned by the TempMonitor,
+*     which records the ingestion stages of every traced sample; listeners
+*     that write fan registers (FanControl, FanGroup) record the remaining
+*     stages once per actuation, for the sample that triggered it.
+*
+*     A notification is attributed to the newest traced sample applied by
+*     the tempThread before it, and only actuated samples reach the later
+*     stages, so their counts are lower than the ingestion ones.
+*
+*     Thread safe: recording is lock-free, see LatencyHistogram.
+*
+*/
+
+#pragma once
+
+#include "LatencyHistogram.h"
+#include "SampleTrace.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+enum class LatencyStage
+{
+     SENSOR_TO_INGEST   // Sensor read to RPC handler: sender, network, gRPC.
+   , INGEST_TO_PROCESS  // RPC handler to tempThread: time in the ingestion ring.
+   , PROCESS_TO_NOTIFY  // tempThread to listener: ListenerDispatcher.
+   , NOTIFY_TO_WRITE    // Listener to fan registers written: fan thread wake up, actuation.
+   , END_TO_END         // Sensor read to fan registers written.
+   , NUM_STAGES
+};
+
+class LatencyRecorder final
+{
+   static constexpr size_t NUM_STAGES{ static_cast<size_t>(LatencyStage::NUM_STAGES) };
+
+   std::array<LatencyHistogram, NUM_STAGES> histograms;
+
+public:
+   static const char* getStageName(LatencyStage stage)
+   {
+      static constexpr std::array<const char*, NUM_STAGES> NAMES{ "SENSOR_TO_INGEST", "INGEST_TO_PROCESS", "PROCESS_TO_NOTIFY", "NOTIFY_TO_WRITE", "END_TO_END" };
+      return NAMES[static_cast<size_t>(stage)];
+   }
+
+   //
+   // Name: record
+   //
+   // Description: Records toNs - fromNs for stage. A negative difference
+   //    (clock skew between sender and receiver) is recorded as zero.
+   //
+   void record(LatencyStage stage, int64_t fromNs, int64_t toNs)
+   {
+      histograms[static_cast<size_t>(stage)].record((toNs > fromNs) ? static_cast<uint64_t>(toNs - fromNs) : 0);
+   }
+
+   //
+   // Name: recordFanWrite
+   //
+   // Description: Called once the fan registers were written for a
+   //    notification carrying trace. Records PROCESS_TO_NOTIFY,
+   //    NOTIFY_TO_WRITE and END_TO_END; nothing if the sample is not traced.
+   //
+   void recordFanWrite(const SampleTrace& trace)
+   {
+      if (trace.isTraced())
+      {
+         const auto writeTimeNs{ SampleTrace::nowNs() };
+
+         record(LatencyStage::PROCESS_TO_NOTIFY, trace.processTimeNs, trace.notifyTimeNs);
+         record(LatencyStage::NOTIFY_TO_WRITE, trace.notifyTimeNs, writeTimeNs);
+         record(LatencyStage::END_TO_END, trace.sampleTimeNs, writeTimeNs);
+      }
+   }
+
+   const LatencyHistogram& getHistogram(LatencyStage stage) const { return histograms[static_cast<size_t>(stage)]; }
+
+   void reset()
+   {
+      for (auto& histogram : histograms)
+      {
+         histogram.reset();
+      }
+   }
+
+   //
+   // Name: dump
+   //
+   // Description: Writes one summary line per stage.
+   //
+   void dump(std::ostream& os) const
+   {
+      for (size_t idx{ 0 }; idx < NUM_STAGES; ++idx)
+      {
+         os << getStageName(static_cast<LatencyStage>(idx)) << ": ";
+         histograms[idx].dump(os);
+         os << "\n";
+      }
+   }
+};
\ No newline at end of file
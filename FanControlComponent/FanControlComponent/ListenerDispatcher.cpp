@@ -0,0 +1,220 @@
+#include "ListenerDispatcher.h"
+#include "EventCount.h"
+#include "TripleBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+//
+// Name: Mailbox
+//
+// Description: Latest-value slot plus dispatch thread for one listener.
+//
+class ListenerDispatcher::Mailbox final
+{
+   struct Post
+   {
+      float       temp{ 0.0f };
+      SampleTrace trace;
+   };
+
+   TempMonitorListener& listener;
+
+   TripleBuffer<Post> latest;
+   std::atomic<bool>  pending{ false };
+   std::atomic<bool>  keepAlive{ true };
+   EventCount         signal;
+   std::thread        thread;
+
+   //
+   // Name: dispatchThread
+   //
+   // Description: Delivers the latest temp whenever the mailbox is
+   //    pending and sleeps on signal otherwise. A temp equal to the last
+   //    one delivered is skipped: the temps in between were overwritten,
+   //    so for the listener nothing changed. A traced
+   //    temp is stamped with its notify time just before delivery.
+   //
+   void dispatchThread()
+   {
+      auto  delivered{ false };
+      float lastTemp{ 0.0f };
+
+      while (keepAlive.load(std::memory_order_acquire))
+      {
+         if (pending.exchange(false, std::memory_order_acq_rel))
+         {
+            if (latest.update())
+            {
+               auto post{ latest.getReadBuffer() };
+               if (!delivered || (post.temp != lastTemp))
+               {
+                  if (post.trace.isTraced())
+                  {
+                     post.trace.notifyTimeNs = SampleTrace::nowNs();
+                  }
+                  listener.notifyNewMaxTemp(post.temp, post.trace);
+                  delivered = true;
+                  lastTemp  = post.temp;
+               }
+            }
+            continue;
+         }
+
+         auto key{ signal.prepareWait() };
+         if (pending.load(std::memory_order_acquire) || !keepAlive.load(std::memory_order_acquire))
+         {
+            signal.cancelWait();
+            continue;
+         }
+         signal.commitWait(key);
+      }
+   }
+
+public:
+   explicit Mailbox(TempMonitorListener& tml)
+      : listener(tml)
+   {
+      thread = std::thread(&Mailbox::dispatchThread, this);
+   }
+
+   //
+   // Name: ~Mailbox (dtor)
+   //
+   // Description: Stops the dispatch thread. Blocks until an in-flight
+   //    notifyNewMaxTemp returns, so the listener is not called afterwards.
+   //
+   ~Mailbox()
+   {
+      keepAlive.store(false, std::memory_order_release);
+      signal.notify();
+      thread.join();
+   }
+
+   //
+   // Name: post
+   //
+   // Description: Overwrites the latest temp, waking the dispatch thread
+   //    only if the mailbox was empty. Single writer (see publish).
+   //
+   void post(float temp, const SampleTrace& trace)
+   {
+      latest.getWriteBuffer() = { temp, trace };
+      latest.publish();
+      if (!pending.exchange(true, std::memory_order_acq_rel))
+      {
+         signal.notify();
+      }
+   }
+
+   const TempMonitorListener* getListener() const { return &listener; }
+};
+
+//
+// Name: ListenerDispatcher (ctor)
+//
+ListenerDispatcher::ListenerDispatcher()
+{
+   // Empty
+}
+
+//
+// Name: ~ListenerDispatcher (dtor)
+//
+// Description: Stops every dispatch thread.
+//
+ListenerDispatcher::~ListenerDispatcher()
+{
+   std::vector<std::unique_ptr<Mailbox>> removed;
+
+   mailboxes.update([&removed](std::vector<Mailbox*>& boxes)
+   {
+      for (auto mailbox : boxes)
+      {
+         removed.emplace_back(mailbox);
+      }
+      boxes.clear();
+      return true;
+   });
+}
+
+//
+// Name: add
+//
+// Description: Creates a mailbox (and dispatch thread) for the listener
+//    and publishes a new mailbox list containing it.
+//
+// Return: bool - False if the listener is already registered.
+//
+bool ListenerDispatcher::add(TempMonitorListener& listener)
+{
+   return mailboxes.update([&listener](std::vector<Mailbox*>& boxes)
+   {
+      auto Itr{ std::find_if(boxes.begin(), boxes.end(),
+                             [&listener](const Mailbox* mailbox) { return mailbox->getListener() == &listener; }) };
+      if (boxes.end() != Itr)
+      {
+         return false;
+      }
+
+      auto mailbox{ std::make_unique<Mailbox>(listener) };
+      boxes.push_back(mailbox.get());
+      mailbox.release();
+      return true;
+   });
+}
+
+//
+// Name: remove
+//
+// Description: Publishes a mailbox list without the listener, then
+//    destroys its mailbox once no publish() can still reach it. Any pending
+//    temp is dropped and, once this returns, the listener will not be
+//    called again.
+//
+// Return: bool - False if the listener was not registered.
+//
+bool ListenerDispatcher::remove(TempMonitorListener& listener)
+{
+   std::unique_ptr<Mailbox> removed;
+
+   mailboxes.update([&listener, &removed](std::vector<Mailbox*>& boxes)
+   {
+      auto Itr{ std::find_if(boxes.begin(), boxes.end(),
+                             [&listener](const Mailbox* mailbox) { return mailbox->getListener() == &listener; }) };
+      if (boxes.end() == Itr)
+      {
+         return false;
+      }
+
+      removed.reset(*Itr);
+      boxes.erase(Itr);
+      return true;
+   });
+
+   // Joined after update() returned, i.e. after the old list was reclaimed.
+   return nullptr != removed;
+}
+
+//
+// Name: publish
+//
+// Description: Posts temp to every mailbox. Lock-free and never calls a
+//    listener. Must not be called concurrently (the tempThread is the only
+//    publisher): a mailbox hands temp and trace over in a TripleBuffer.
+//
+// Params: temp - New max temp.
+//         trace - The sample that produced it, if traced.
+//
+void ListenerDispatcher::publish(float temp, const SampleTrace& trace)
+{
+   mailboxes.read([temp, &trace](const std::vector<Mailbox*>& boxes)
+   {
+      for (auto mailbox : boxes)
+      {
+         mailbox->post(temp, trace);
+      }
+   });
+}
@@ -0,0 +1,44 @@
+/*
+* Class: ListenerDispatcher
+*
+* Description: Delivers new max temps to TempMonitorListeners without
+*     running listener code on the publishing (tempThread) thread.
+*
+*     Every registered listener gets a Mailbox which holds only the latest
+*     max temp, and a dispatch thread of its own. publish() overwrites each
+*     mailbox and wakes its thread only if it was empty, so it never blocks
+*     on a listener. A slow listener simply sees the most recent value when
+*     it gets around to it (intermediate values are skipped) and never
+*     delays the other listeners. The mailbox also carries the SampleTrace
+*     of the temp, for latency measurement.
+*
+*     The mailbox list is a CowSnapshot: publish() reads it without taking a
+*     lock, and add()/remove() swap in a new list, so registering or
+*     unregistering a listener never blocks a notification.
+*
+*/
+
+#pragma once
+
+#include "TempMonitorListener.h"
+#include "CowSnapshot.h"
+
+#include <vector>
+
+class ListenerDispatcher final
+{
+   class Mailbox;
+
+   CowSnapshot<std::vector<Mailbox*>> mailboxes; // Owns the mailboxes.
+
+public:
+   ListenerDispatcher();
+   ~ListenerDispatcher();
+
+   ListenerDispatcher(const ListenerDispatcher&) = delete;
+   ListenerDispatcher& operator=(const ListenerDispatcher&) = delete;
+
+   bool add(TempMonitorListener& listener);
+   bool remove(TempMonitorListener& listener);
+   void publish(float temp, const SampleTrace& trace = SampleTrace());
+};
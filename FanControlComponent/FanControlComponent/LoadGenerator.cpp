@@ -0,0 +1,494 @@
+#include "LoadGenerator.h"
+#include "Prng.h"
+#include "TimerWheel.h"
+#include "log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "TempMonitor.grpc.pb.h"
+
+namespace
+{
+   constexpr float TWO_PI{ 6.283185307f };
+
+   //
+   // Name: Sensor
+   //
+   // Description: Runtime state of one simulated subsystem.
+   //
+   struct Sensor
+   {
+      SimulatedSubSystem config;
+      Prng               prng;
+      float              temp;
+      uint32_t           phaseMs;     // Periodic waveforms start at a random point of their period.
+      uint64_t           periodTicks;
+
+      Sensor(const SimulatedSubSystem& cfg, uint32_t tickMs)
+         : config(cfg)
+         , prng(cfg.seed ^ (static_cast<uint64_t>(static_cast<uint32_t>(cfg.subSystemId)) << 32))
+         , temp(cfg.baseTemp)
+         , phaseMs(prng.nextBelow(cfg.wavePeriodMs))
+         , periodTicks(std::max<uint64_t>(1, cfg.periodMs / tickMs))
+      {}
+
+      float noise()
+      {
+         return (0.0f < config.noise) ? (((2.0f * prng.nextFloat()) - 1.0f) * config.noise) : 0.0f;
+      }
+
+      //
+      // Name: nextTemp
+      //
+      // Params: timeMs - Time since the generator started.
+      //
+      // Return: float - The subsystem's temp at timeMs.
+      //
+      float nextTemp(uint64_t timeMs)
+      {
+         const auto wavePos{ static_cast<float>((timeMs + phaseMs) % config.wavePeriodMs) / static_cast<float>(config.wavePeriodMs) };
+
+         switch (config.waveform)
+         {
+         case SimulatedSubSystem::Waveform::SINE:
+         {
+            temp = config.baseTemp + (config.amplitude * std::sin(TWO_PI * wavePos)) + noise();
+            break;
+         }
+         case SimulatedSubSystem::Waveform::SQUARE:
+         {
+            temp = config.baseTemp + ((wavePos < 0.5f) ? config.amplitude : -config.amplitude) + noise();
+            break;
+         }
+         case SimulatedSubSystem::Waveform::SAWTOOTH:
+         {
+            temp = config.baseTemp - config.amplitude + (2.0f * config.amplitude * wavePos) + noise();
+            break;
+         }
+         case SimulatedSubSystem::Waveform::RANDOM_WALK: // Fallthrough
+         default:
+         {
+            switch (prng.nextBelow(3))
+            {
+            case 0:  temp -= config.stepSize; break;
+            case 1:  temp += config.stepSize; break;
+            default: break; // No change
+            }
+            temp = std::clamp(temp, config.baseTemp - config.amplitude, config.baseTemp + config.amplitude);
+            break;
+         }
+         }
+         return temp;
+      }
+   };
+}
+
+//
+// Name: Engine
+//
+// Description: One engine thread and the subsystems it drives. Timer ids
+//    are indexes into sensors.
+//
+class LoadGenerator::Engine
+{
+   const LoadGeneratorConfig& config;
+   Counters&                  counters;
+   const SampleSink&          sink;
+
+   std::vector<Sensor> sensors;
+   TimerWheel          wheel;
+
+   // Temps due on the current tick, sized for every sensor up front.
+   std::vector<int>   dueIds;
+   std::vector<float> dueTemps;
+
+   std::unique_ptr<TempMonitorSink::TempMonitorServer::Stub> stub;
+   TempMonitorSink::SubSysIdsAndTemps                        batch;
+   std::unique_ptr<grpc::ClientContext>                      streamContext;
+   TempMonitorSink::empty_param                              streamResponse;
+   std::unique_ptr<grpc::ClientWriter<TempMonitorSink::SubSysIdAndTemp>> streamWriter;
+
+   std::thread             engineThread;
+   std::mutex              engineThreadMux;
+   std::condition_variable engineThreadCond;
+   bool                    engineThreadKeepAlive{ false };
+
+public:
+   Engine(const LoadGeneratorConfig& cfg, Counters& loadCounters, const SampleSink& sampleSink,
+          const std::shared_ptr<grpc::Channel>& channel, std::vector<SimulatedSubSystem> subSystems)
+      : config(cfg)
+      , counters(loadCounters)
+      , sink(sampleSink)
+      , wheel(subSystems.size())
+   {
+      sensors.reserve(subSystems.size());
+      for (const auto& subSystem : subSystems)
+      {
+         sensors.emplace_back(subSystem, config.tickMs);
+      }
+      dueIds.reserve(sensors.size());
+      dueTemps.reserve(sensors.size());
+
+      if (nullptr != channel)
+      {
+         stub = TempMonitorSink::TempMonitorServer::NewStub(channel);
+      }
+
+      // Stagger the first temps over one period, so subsystems with the
+      // same period are not all due on the same tick.
+      for (TimerWheel::TimerId id{ 0 }; id < sensors.size(); ++id)
+      {
+         auto& sensor{ sensors[id] };
+         wheel.schedule(id, 1 + sensor.prng.nextBelow(static_cast<uint32_t>(sensor.periodTicks)));
+      }
+   }
+
+   ~Engine()
+   {
+      stop();
+      closeStream();
+   }
+
+   void start()
+   {
+      engineThreadKeepAlive = true;
+      engineThread = std::thread(&Engine::engineThreadMain, this);
+   }
+
+   void stop()
+   {
+      {
+         std::lock_guard<std::mutex> guard(engineThreadMux);
+         engineThreadKeepAlive = false;
+      }
+      engineThreadCond.notify_one();
+
+      if (engineThread.joinable())
+      {
+         engineThread.join();
+      }
+   }
+
+private:
+   //
+   // Name: engineThreadMain
+   //
+   // Description: Sleeps until the next tick's deadline, expires whatever
+   //    is due up to the current tick and sends it. Deadlines are absolute,
+   //    so a late wake up catches up instead of drifting. The wheel's tick
+   //    count carries over a stop() / start().
+   //
+   void engineThreadMain()
+   {
+      const auto tick{ std::chrono::milliseconds(config.tickMs) };
+      const auto startTime{ std::chrono::steady_clock::now() - (tick * wheel.getNow()) };
+
+      std::unique_lock<std::mutex> guard(engineThreadMux);
+      while (engineThreadKeepAlive)
+      {
+         const auto nextTick{ wheel.getNow() + 1 };
+         if (engineThreadCond.wait_until(guard, startTime + (tick * nextTick), [this]() { return !engineThreadKeepAlive; }))
+         {
+            break;
+         }
+         guard.unlock();
+
+         const auto curTick{ static_cast<uint64_t>((std::chrono::steady_clock::now() - startTime) / tick) };
+         if (curTick > nextTick)
+         {
+            counters.lateTicks.fetch_add(curTick - nextTick, std::memory_order_relaxed);
+         }
+
+         wheel.advance(std::max(curTick, nextTick), [this](TimerWheel::TimerId id) { expire(id); });
+         send();
+
+         guard.lock();
+      }
+   }
+
+   //
+   // Name: expire
+   //
+   // Description: Queues the subsystem's next temp and re-arms its timer one
+   //    period after the tick it was due on.
+   //
+   void expire(TimerWheel::TimerId id)
+   {
+      auto& sensor{ sensors[id] };
+      const auto dueTick{ wheel.getNow() };
+
+      dueIds.push_back(sensor.config.subSystemId);
+      dueTemps.push_back(sensor.nextTemp(dueTick * config.tickMs));
+      wheel.schedule(id, dueTick + sensor.periodTicks);
+   }
+
+   //
+   // Name: send
+   //
+   // Description: Sends the temps queued by expire() to the sink or the
+   //    TempMonitor, then clears them.
+   //
+   void send()
+   {
+      if (dueIds.empty())
+      {
+         return;
+      }
+      counters.samplesGenerated.fetch_add(dueIds.size(), std::memory_order_relaxed);
+
+      if (sink)
+      {
+         sink(dueIds, dueTemps);
+         counters.samplesSent.fetch_add(dueIds.size(), std::memory_order_relaxed);
+      }
+      else if (LoadGeneratorConfig::SendMode::STREAMING == config.sendMode)
+      {
+         sendStream();
+      }
+      else
+      {
+         sendBatches();
+      }
+
+      dueIds.clear();
+      dueTemps.clear();
+   }
+
+   void sendBatches()
+   {
+      for (size_t first{ 0 }; first < dueIds.size(); first += config.maxBatchSize)
+      {
+         const auto last{ std::min(dueIds.size(), first + config.maxBatchSize) };
+
+         // clear() keeps the repeated fields' capacity, so steady state
+         // batches do not allocate.
+         batch.mutable_subsysids()->Clear();
+         batch.mutable_temps()->Clear();
+         batch.mutable_subsysids()->Add(dueIds.begin() + first, dueIds.begin() + last);
+         batch.mutable_temps()->Add(dueTemps.begin() + first, dueTemps.begin() + last);
+
+         TempMonitorSink::empty_param emptyRVal;
+         grpc::ClientContext          context;
+
+         const auto status{ stub->UpdateSubSystemTempsBatch(&context, batch, &emptyRVal) };
+         if (status.ok())
+         {
+            counters.samplesSent.fetch_add(last - first, std::memory_order_relaxed);
+         }
+         else
+         {
+            counters.sendFailures.fetch_add(1, std::memory_order_relaxed);
+            LOG_RATE_LIMITED( LogLevel::ERR, LOG_DEFAULT_RATE_LIMIT_MS, "LoadGenerator::sendBatches() - ERROR: batch RPC failed, code=[{}]", status.error_code() );
+         }
+      }
+   }
+
+   void sendStream()
+   {
+      TempMonitorSink::SubSysIdAndTemp data;
+
+      for (size_t idx{ 0 }; idx < dueIds.size(); ++idx)
+      {
+         data.set_subsysid(dueIds[idx]);
+         data.set_temp(dueTemps[idx]);
+
+         // A failed Write means the stream is broken (e.g. server restarted),
+         // reopen it once for the remaining temps.
+         if (!openStream() || !streamWriter->Write(data))
+         {
+            closeStream();
+            if (!openStream() || !streamWriter->Write(data))
+            {
+               counters.sendFailures.fetch_add(1, std::memory_order_relaxed);
+               LOG_RATE_LIMITED( LogLevel::ERR, LOG_DEFAULT_RATE_LIMIT_MS, "LoadGenerator::sendStream() - ERROR: Unable to write to the temp stream." );
+               closeStream();
+               return;
+            }
+         }
+         counters.samplesSent.fetch_add(1, std::memory_order_relaxed);
+      }
+   }
+
+   bool openStream()
+   {
+      if (nullptr == streamWriter)
+      {
+         streamContext = std::make_unique<grpc::ClientContext>();
+         streamWriter  = stub->StreamSubSystemTemps(streamContext.get(), &streamResponse);
+      }
+      return nullptr != streamWriter;
+   }
+
+   void closeStream()
+   {
+      if (nullptr != streamWriter)
+      {
+         streamWriter->WritesDone();
+         streamWriter->Finish();
+         streamWriter.reset();
+         streamContext.reset();
+      }
+   }
+};
+
+//
+// Name: LoadGenerator (ctor)
+//
+// Params: cfg - The simulated subsystems and how to send their temps.
+//         grpcChannel - Channel to the TempMonitor gRPC server.
+//
+LoadGenerator::LoadGenerator(const LoadGeneratorConfig& cfg, std::shared_ptr<grpc::Channel> grpcChannel)
+   : config(cfg)
+   , channel(std::move(grpcChannel))
+{
+   // Empty
+}
+
+//
+// Name: LoadGenerator (ctor)
+//
+// Params: cfg - The simulated subsystems (sendMode is ignored).
+//         sampleSink - Receives the temps in process instead of gRPC.
+//
+LoadGenerator::LoadGenerator(const LoadGeneratorConfig& cfg, SampleSink sampleSink)
+   : config(cfg)
+   , sink(std::move(sampleSink))
+{
+   // Empty
+}
+
+//
+// Name: ~LoadGenerator (dtor)
+//
+// Description: Stops and joins the engine threads.
+//
+LoadGenerator::~LoadGenerator()
+{
+   stop();
+}
+
+//
+// Name: initialize
+//
+// Description: Checks the config and spreads the subsystems over the
+//    engines, round robin.
+//
+// Return: GeneralConstants::ReturnCodes - LOAD_GENERATOR_INVALID_CONFIG if
+//    the config is invalid or there is neither a channel nor a sink.
+//
+GeneralConstants::ReturnCodes LoadGenerator::initialize()
+{
+   auto rVal{ checkConfig() };
+
+   if ((GeneralConstants::ReturnCodes::SUCCESS == rVal) && engines.empty())
+   {
+      std::vector<std::vector<SimulatedSubSystem>> shares(std::min(config.numThreads, config.subSystems.size()));
+      for (size_t idx{ 0 }; idx < config.subSystems.size(); ++idx)
+      {
+         shares[idx % shares.size()].push_back(config.subSystems[idx]);
+      }
+
+      for (auto& share : shares)
+      {
+         engines.push_back(std::make_unique<Engine>(config, counters, sink, channel, std::move(share)));
+      }
+   }
+
+   return rVal;
+}
+
+//
+// Name: checkConfig
+//
+// Return: GeneralConstants::ReturnCodes - LOAD_GENERATOR_INVALID_CONFIG if
+//    a count, tick or period is zero, an amplitude is negative or there is
+//    nowhere to send the temps.
+//
+GeneralConstants::ReturnCodes LoadGenerator::checkConfig() const
+{
+   auto rVal{ GeneralConstants::ReturnCodes::SUCCESS };
+
+   if ((0 == config.numThreads) || (0 == config.tickMs) || (0 == config.maxBatchSize) ||
+       config.subSystems.empty() || ((nullptr == channel) && !sink))
+   {
+      rVal = GeneralConstants::ReturnCodes::LOAD_GENERATOR_INVALID_CONFIG;
+   }
+
+   for (const auto& subSystem : config.subSystems)
+   {
+      if ((0 == subSystem.periodMs) || (0 == subSystem.wavePeriodMs) || (0.0f > subSystem.amplitude))
+      {
+         rVal = GeneralConstants::ReturnCodes::LOAD_GENERATOR_INVALID_CONFIG;
+      }
+   }
+
+   if (GeneralConstants::ReturnCodes::SUCCESS != rVal)
+   {
+      PRINT_STD_OUT("LoadGenerator::checkConfig() - ERROR: Invalid load generator config.");
+   }
+   return rVal;
+}
+
+//
+// Name: start
+//
+// Description: Starts the engine threads. Subsystems carry on where they
+//    were stopped.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes LoadGenerator::start()
+{
+   auto rVal{ GeneralConstants::ReturnCodes::SUCCESS };
+
+   if (engines.empty())
+   {
+      rVal = GeneralConstants::ReturnCodes::LOAD_GENERATOR_INVALID_CONFIG; // Not initialized.
+   }
+   else if (!running)
+   {
+      for (auto& engine : engines)
+      {
+         engine->start();
+      }
+      running = true;
+   }
+   return rVal;
+}
+
+//
+// Name: stop
+//
+// Description: Stops and joins the engine threads.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes LoadGenerator::stop()
+{
+   for (auto& engine : engines)
+   {
+      engine->stop();
+   }
+   running = false;
+   return GeneralConstants::ReturnCodes::SUCCESS;
+}
+
+//
+// Name: getStats
+//
+// Return: LoadGenerator::Stats - Totals across all engines since construction.
+//
+LoadGenerator::Stats LoadGenerator::getStats() const
+{
+   Stats rVal;
+   rVal.samplesGenerated = counters.samplesGenerated.load(std::memory_order_relaxed);
+   rVal.samplesSent      = counters.samplesSent.load(std::memory_order_relaxed);
+   rVal.sendFailures     = counters.sendFailures.load(std::memory_order_relaxed);
+   rVal.lateTicks        = counters.lateTicks.load(std::memory_order_relaxed);
+   return rVal;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*
+* Class: LoadGenerator
+*
+* Description: This is not used or needed by the FanControl. Drives
+*     thousands of simulated subsystems against the TempMonitor, for stress
+*     testing and benchmarks, where SubSystem (one thread per subsystem)
+*     does not scale.
+*
+*     A few engine threads (LoadGeneratorConfig::numThreads) each own a
+*     share of the subsystems, a TimerWheel with one timer per subsystem and
+*     their own gRPC stub. Every tick the engine expires the subsystems that
+*     are due, computes their next temp (own Prng and waveform, see
+*     SimulatedSubSystem), re-arms them one period later and sends all the
+*     temps of that tick together (one batch RPC, or Writes on one stream).
+*     Engines share nothing but the channel and the stats counters.
+*
+*     Instead of a gRPC channel a SampleSink can be given, which receives
+*     the temps in process (e.g. to measure the generator itself).
+*
+*/
+
+#pragma once
+
+#include "GeneralConstants.h"
+#include "LoadGeneratorConfig.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+class LoadGenerator final
+{
+public:
+   // Called on the engine threads (concurrently if numThreads > 1) with the
+   // temps due on one tick; temps[i] is the temp of ssIds[i].
+   using SampleSink = std::function<void(std::span<const int> ssIds, std::span<const float> temps)>;
+
+   struct Stats
+   {
+      uint64_t samplesGenerated{ 0 };
+      uint64_t samplesSent{ 0 };      // Accepted by the server (or given to the sink).
+      uint64_t sendFailures{ 0 };     // RPCs or stream Writes that failed.
+      uint64_t lateTicks{ 0 };        // Ticks an engine only reached after their deadline.
+   };
+
+private:
+   class Engine;
+
+   struct Counters
+   {
+      std::atomic<uint64_t> samplesGenerated{ 0 };
+      std::atomic<uint64_t> samplesSent{ 0 };
+      std::atomic<uint64_t> sendFailures{ 0 };
+      std::atomic<uint64_t> lateTicks{ 0 };
+   };
+
+   const LoadGeneratorConfig            config;
+   std::shared_ptr<grpc::Channel>       channel;
+   SampleSink                           sink;
+   std::vector<std::unique_ptr<Engine>> engines;
+   Counters                             counters;
+   bool                                 running{ false };
+
+   GeneralConstants::ReturnCodes checkConfig() const;
+
+public:
+   LoadGenerator(const LoadGeneratorConfig& config, std::shared_ptr<grpc::Channel> channel);
+   LoadGenerator(const LoadGeneratorConfig& config, SampleSink sink);
+   ~LoadGenerator();
+
+   LoadGenerator(const LoadGenerator&) = delete;
+   LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+   GeneralConstants::ReturnCodes initialize();
+   GeneralConstants::ReturnCodes start();
+   GeneralConstants::ReturnCodes stop();
+
+   Stats getStats() const;
+};
\ No newline at end of file
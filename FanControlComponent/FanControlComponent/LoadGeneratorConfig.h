@@ -0,0 +1,57 @@
+/*
+* Struct: LoadGeneratorConfig
+*
+* Description: The simulated subsystems a LoadGenerator drives, and how it
+*     sends their temps.
+*
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct SimulatedSubSystem
+{
+   enum class Waveform
+   {
+        RANDOM_WALK  // Steps of -stepSize / 0 / +stepSize, kept within baseTemp +/- amplitude.
+      , SINE         // baseTemp + amplitude * sin(2 pi t / wavePeriodMs), plus noise.
+      , SQUARE       // baseTemp +/- amplitude, flipping every half wavePeriodMs, plus noise.
+      , SAWTOOTH     // Ramps from baseTemp - amplitude to baseTemp + amplitude, plus noise.
+   };
+
+   int      subSystemId{ 0 };
+   uint32_t periodMs{ 300 };        // Time between two temps, non zero.
+   Waveform waveform{ Waveform::RANDOM_WALK };
+   float    baseTemp{ 30.0f };
+   float    amplitude{ 5.0f };
+   float    stepSize{ 0.1f };       // RANDOM_WALK step.
+   float    noise{ 0.0f };          // Uniform noise in [-noise, +noise] added to the periodic waveforms.
+   uint32_t wavePeriodMs{ 60'000 }; // SINE, SQUARE, SAWTOOTH; non zero.
+   uint64_t seed{ 0 };              // Mixed with the subsystem id; same seed, same temps.
+};
+
+struct LoadGeneratorConfig
+{
+   enum class SendMode
+   {
+        BATCH      // Temps due on the same tick go in UpdateSubSystemTempsBatch RPCs.
+      , STREAMING  // Every temp is a Write on the engine thread's StreamSubSystemTemps stream.
+   };
+
+   SendMode sendMode{ SendMode::BATCH };
+
+   // BATCH: most temps in one RPC, larger ticks are split.
+   size_t maxBatchSize{ 1024 };
+
+   // Engine threads; the subsystems are spread over them round robin and
+   // each thread has its own timer wheel and gRPC stub.
+   size_t numThreads{ 1 };
+
+   // Timer wheel tick, the granularity of every periodMs.
+   uint32_t tickMs{ 1 };
+
+   std::vector<SimulatedSubSystem> subSystems;
+};
\ No newline at end of file
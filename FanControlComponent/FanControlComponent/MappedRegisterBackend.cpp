@@ -0,0 +1,131 @@
+#include "MappedRegisterBackend.h"
+#include "log.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define REGISTER_BACKEND_HAS_MMAP
+#endif
+
+//
+// Name: MappedRegisterBackend (ctor)
+//
+// Params: path - Device, file or shared memory object to map, e.g. /dev/mem.
+//         baseAddress - Register address of the first byte of the region.
+//         length - Region size in bytes.
+//         fileOffset - Byte offset of the region in the file (e.g. the
+//             physical address of the register block for /dev/mem).
+//         create - Create the file, and grow it to cover the region, if
+//             needed. Only meaningful for regular files.
+//
+MappedRegisterBackend::MappedRegisterBackend( const std::string& filePath,
+                                              uint64_t base,
+                                              size_t regionLength,
+                                              uint64_t offset,
+                                              bool createFile )
+   : path(filePath)
+   , baseAddress(base)
+   , length(regionLength)
+   , fileOffset(offset)
+   , create(createFile)
+{
+   // Empty
+}
+
+//
+// Name: ~MappedRegisterBackend (dtor)
+//
+MappedRegisterBackend::~MappedRegisterBackend()
+{
+   close();
+}
+
+//
+// Name: open
+//
+// Description: Opens path read/write and maps the region. mmap needs a
+//    page aligned offset, so the mapping starts at the page holding
+//    fileOffset and the region pointer is adjusted into it.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes MappedRegisterBackend::open()
+{
+   auto rVal{ GeneralConstants::ReturnCodes::REGISTER_BACKEND_OPEN_FAILED };
+
+#ifdef REGISTER_BACKEND_HAS_MMAP
+   close();
+
+   const auto fd{ ::open(path.c_str(), O_RDWR | O_SYNC | (create ? O_CREAT : 0), 0600) };
+   if (fd >= 0)
+   {
+      const auto pageSize{ static_cast<uint64_t>(::sysconf(_SC_PAGESIZE)) };
+      const auto mapOffset{ fileOffset - (fileOffset % pageSize) };
+      const auto lead{ static_cast<size_t>(fileOffset - mapOffset) };
+
+      struct stat fileStat{};
+      auto sized{ 0 == ::fstat(fd, &fileStat) };
+      if (sized && create && S_ISREG(fileStat.st_mode) && (static_cast<uint64_t>(fileStat.st_size) < (fileOffset + length)))
+      {
+         sized = (0 == ::ftruncate(fd, static_cast<off_t>(fileOffset + length)));
+      }
+
+      if (sized && (0 != length))
+      {
+         auto addr{ ::mmap(nullptr, lead + length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, static_cast<off_t>(mapOffset)) };
+         if (MAP_FAILED != addr)
+         {
+            mapping       = addr;
+            mappingLength = lead + length;
+            region        = static_cast<volatile uint8_t*>(addr) + lead;
+            rVal          = GeneralConstants::ReturnCodes::SUCCESS;
+         }
+      }
+      ::close(fd); // The mapping keeps its own reference.
+   }
+#endif
+
+   DEBUG_STD_OUT("MappedRegisterBackend::open() - path[" << path << "], length[" << length << "], rVal[" << GeneralConstants::ReturnCodesStrings.find(rVal)->second << "]");
+   return rVal;
+}
+
+//
+// Name: close
+//
+// Description: Unmaps the region. Pointers resolved from it become invalid.
+//
+void MappedRegisterBackend::close()
+{
+#ifdef REGISTER_BACKEND_HAS_MMAP
+   if (nullptr != mapping)
+   {
+      ::munmap(mapping, mappingLength);
+   }
+#endif
+   mapping       = nullptr;
+   mappingLength = 0;
+   region        = nullptr;
+}
+
+//
+// Name: resolve
+//
+// Params: address - Register address, [baseAddress, baseAddress + length).
+//
+// Return: volatile uint32_t* - The register in the mapping, nullptr if the
+//       backend is not open or the address is outside the region or unaligned.
+//
+volatile uint32_t* MappedRegisterBackend::resolve(uint64_t address)
+{
+   volatile uint32_t* rVal{ nullptr };
+
+   const auto offset{ address - baseAddress }; // Wraps when below the base.
+   if ((nullptr != region) && (length >= sizeof(uint32_t)) && (address >= baseAddress) &&
+       (offset <= (length - sizeof(uint32_t))) && (0 == (offset % sizeof(uint32_t))))
+   {
+      rVal = reinterpret_cast<volatile uint32_t*>(region + offset);
+   }
+   return rVal;
+}
\ No newline at end of file
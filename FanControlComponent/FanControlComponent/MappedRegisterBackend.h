@@ -0,0 +1,60 @@
+/*
+* Class: MappedRegisterBackend
+*
+* Description: RegisterBackend over an mmap'd (MAP_SHARED) region of a
+*     device, file or shared memory object: /dev/mem for physical registers,
+*     or e.g. a file on tmpfs (/dev/shm) to run a hardware shaped register
+*     bank on a plain Linux box.
+*
+*     Register address baseAddress maps to byte fileOffset of the file, and
+*     the region is length bytes long. Addresses outside the region, or not
+*     4-byte aligned, do not resolve.
+*
+*     open() must succeed before the backend is handed to a FanRegisters.
+*     The mapping is released by the dtor, so the backend must outlive
+*     every FanRegisters using it.
+*
+* {RISK}: POSIX only. On other platforms open() fails with
+*     REGISTER_BACKEND_OPEN_FAILED.
+*
+*/
+
+#pragma once
+
+#include "RegisterBackend.h"
+#include "GeneralConstants.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedRegisterBackend final : public RegisterBackend
+{
+   const std::string path;
+   const uint64_t    baseAddress;
+   const size_t      length;
+   const uint64_t    fileOffset;
+   const bool        create;
+
+   void*             mapping{ nullptr };
+   size_t            mappingLength{ 0 };
+   volatile uint8_t* region{ nullptr };  // baseAddress, inside mapping.
+
+public:
+   MappedRegisterBackend( const std::string& path,
+                          uint64_t baseAddress,
+                          size_t length,
+                          uint64_t fileOffset = 0,
+                          bool create = false );
+   ~MappedRegisterBackend();
+
+   MappedRegisterBackend(const MappedRegisterBackend&) = delete;
+   MappedRegisterBackend& operator=(const MappedRegisterBackend&) = delete;
+
+   GeneralConstants::ReturnCodes open();
+   void close();
+
+   volatile uint32_t* resolve(uint64_t address) override;
+
+   bool isOpen() const { return nullptr != region; }
+};
\ No newline at end of file
@@ -0,0 +1,128 @@
+/*
+* Class: MaxTempTracker
+*
+* Description: Tracks the max temperature across subsystems with a
+*     tournament (max segment) tree laid out in a dense array. Leaves hold the
+*     current temp of each subsystem slot, every internal node holds the max
+*     of its two children, so the root is the max temp.
+*
+*     update() is O(log n) with no allocation, getMax() is O(1). Slots that
+*     have never been updated hold the lowest float and never win.
+*
+*     Not thread safe: owned by the TempMonitor tempThread.
+*
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+class MaxTempTracker final
+{
+   static constexpr float UNSET_TEMP{ std::numeric_limits<float>::lowest() };
+
+   size_t             numSlots{ 0 };
+   size_t             numLeaves{ 1 };
+   std::vector<float> tree; // tree[1] is the root, leaves start at numLeaves.
+
+   //
+   // Name: rebuild
+   //
+   // Description: Resizes the tree so it has room for numSlots leaves,
+   //    keeping the current leaf values, and recomputes every internal node.
+   //    Only called from the ctor and addSlot (when the tree is full).
+   //
+   void rebuild()
+   {
+      auto newLeaves{ numLeaves };
+      while (newLeaves < numSlots)
+      {
+         newLeaves <<= 1;
+      }
+
+      std::vector<float> newTree(2 * newLeaves, UNSET_TEMP);
+      if (!tree.empty())
+      {
+         std::copy(tree.begin() + numLeaves, tree.end(), newTree.begin() + newLeaves);
+      }
+
+      for (auto node{ newLeaves - 1 }; node > 0; --node)
+      {
+         newTree[node] = std::max(newTree[2 * node], newTree[(2 * node) + 1]);
+      }
+
+      numLeaves = newLeaves;
+      tree.swap(newTree);
+   }
+
+public:
+   //
+   // Name: MaxTempTracker (ctor)
+   //
+   // Params: slotCount - Initial number of subsystem slots.
+   //
+   explicit MaxTempTracker(size_t slotCount)
+      : numSlots(slotCount)
+   {
+      rebuild();
+   }
+
+   //
+   // Name: addSlot
+   //
+   // Description: Appends an unset slot (e.g. for an unknown subsystem id).
+   //    Amortized O(1); the tree doubles when it runs out of leaves.
+   //
+   // Return: size_t - Index of the new slot.
+   //
+   size_t addSlot()
+   {
+      const auto rVal{ numSlots++ };
+      if (numSlots > numLeaves)
+      {
+         rebuild();
+      }
+      return rVal;
+   }
+
+   //
+   // Name: update
+   //
+   // Description: Sets the slot's temp and walks up to the root, stopping
+   //    as soon as an ancestor does not change.
+   //
+   // Params: slot - Slot index, [0, getSize()).
+   //         temp - New temperature for the slot.
+   //
+   void update(size_t slot, float temp)
+   {
+      auto node{ numLeaves + slot };
+      tree[node] = temp;
+
+      for (node >>= 1; node > 0; node >>= 1)
+      {
+         const auto newMax{ std::max(tree[2 * node], tree[(2 * node) + 1]) };
+         if (newMax == tree[node])
+         {
+            break;
+         }
+         tree[node] = newMax;
+      }
+   }
+
+   float get(size_t slot) const { return tree[numLeaves + slot]; }
+   bool  isSet(size_t slot) const { return UNSET_TEMP != get(slot); }
+
+   //
+   // Name: getMax
+   //
+   // Return: float - Max temp across all slots (lowest float if none are set).
+   //
+   float getMax() const { return tree[1]; }
+   bool  hasMax() const { return UNSET_TEMP != getMax(); }
+
+   size_t getSize() const { return numSlots; }
+};
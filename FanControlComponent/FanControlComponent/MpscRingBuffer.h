@@ -0,0 +1,306 @@
+/*
+* Class: MpscRingBuffer
+*
+* Description: Fixed capacity, lock-free, multiple-producer / single-consumer
+*     ring buffer. Every slot carries a sequence number which tells producers
+*     and the consumer whether the slot is free for the current lap or holds
+*     published data, so neither side ever takes a lock or allocates after
+*     construction.
+*
+*     Slots, the producer index and the consumer index are each aligned to
+*     their own cache line so producers writing neighbouring slots, and the
+*     consumer draining them, do not false-share.
+*
+*     For drop-oldest overflow handling a producer may evict the oldest
+*     element itself (pushEvictOldest), so the dequeue side claims slots
+*     with a CAS rather than a plain store.
+*
+* WARNING: tryPop/empty may only be called from a single consumer thread
+*          (plus producers evicting through the pushEvictOldest APIs).
+*
+*/
+
+#pragma once
+
+#include "GeneralConstants.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+template <typename T>
+class MpscRingBuffer final
+{
+   static constexpr size_t CACHE_LINE_SIZE{ GeneralConstants::CACHE_LINE_SIZE };
+
+   struct alignas(CACHE_LINE_SIZE) Slot
+   {
+      std::atomic<size_t> sequence{ 0 };
+      T                   data{};
+   };
+
+   const size_t            capacity;
+   const size_t            mask;
+   std::unique_ptr<Slot[]> slots;
+
+   alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueuePos{ 0 };
+   alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeuePos{ 0 };
+
+   //
+   // Name: roundUpPow2
+   //
+   // Description: Rounds the requested capacity up to a power of two (min 2)
+   //    so the slot index can be computed with a mask.
+   //
+   static size_t roundUpPow2(size_t value)
+   {
+      size_t rVal{ 2 };
+      while (rVal < value)
+      {
+         rVal <<= 1;
+      }
+      return rVal;
+   }
+
+public:
+   //
+   // Name: MpscRingBuffer (ctor)
+   //
+   // Params: requestedCapacity - Minimum number of elements the ring can hold.
+   //            Rounded up to the next power of two.
+   //
+   explicit MpscRingBuffer(size_t requestedCapacity)
+      : capacity(roundUpPow2(requestedCapacity))
+      , mask(capacity - 1)
+      , slots(new Slot[capacity])
+   {
+      for (size_t idx{ 0 }; idx < capacity; ++idx)
+      {
+         slots[idx].sequence.store(idx, std::memory_order_relaxed);
+      }
+   }
+
+   MpscRingBuffer(const MpscRingBuffer&) = delete;
+   MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+   //
+   // Name: tryPush
+   //
+   // Description: Producer API. Copies item into the next free slot.
+   //
+   // Return: bool - False if the ring is full.
+   //
+   bool tryPush(const T& item)
+   {
+      auto pos{ enqueuePos.load(std::memory_order_relaxed) };
+      Slot* slot{ nullptr };
+
+      for (;;)
+      {
+         slot = &slots[pos & mask];
+         const auto seq{ slot->sequence.load(std::memory_order_acquire) };
+         const auto diff{ static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos) };
+
+         if (0 == diff)
+         {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+               break;
+            }
+         }
+         else if (0 > diff)
+         {
+            return false; // Full: the consumer has not released this slot yet.
+         }
+         else
+         {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+         }
+      }
+
+      slot->data = item;
+      slot->sequence.store(pos + 1, std::memory_order_release);
+      return true;
+   }
+
+   //
+   // Name: tryPushBatch
+   //
+   // Description: Producer API. Claims count consecutive slots with a single
+   //    CAS and copies items into them, so the batch is contiguous in the
+   //    ring. All or nothing.
+   //
+   // Params: items - Pointer to count elements.
+   //         count - Number of elements.
+   //
+   // Return: bool - False if the ring does not have count free slots.
+   //
+   bool tryPushBatch(const T* items, size_t count)
+   {
+      if (0 == count)
+      {
+         return true;
+      }
+      if (count > capacity)
+      {
+         return false;
+      }
+
+      auto pos{ enqueuePos.load(std::memory_order_relaxed) };
+
+      for (;;)
+      {
+         // Evicting producers pop concurrently with the consumer, so slots
+         // are not freed in order: every slot of the batch must be free for
+         // this lap, or a slow popper may still be reading one of them.
+         // A free slot cannot be taken before enqueuePos passes it, so the
+         // check holds until the CAS below.
+         intptr_t diff{ 0 };
+         for (size_t idx{ 0 }; (idx < count) && (0 == diff); ++idx)
+         {
+            const auto slotPos{ pos + idx };
+            const auto seq{ slots[slotPos & mask].sequence.load(std::memory_order_acquire) };
+            diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(slotPos);
+         }
+
+         if (0 == diff)
+         {
+            if (enqueuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+            {
+               break;
+            }
+         }
+         else if (0 > diff)
+         {
+            return false; // Not enough free slots.
+         }
+         else
+         {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+         }
+      }
+
+      for (size_t idx{ 0 }; idx < count; ++idx)
+      {
+         auto& slot{ slots[(pos + idx) & mask] };
+         slot.data = items[idx];
+         slot.sequence.store(pos + idx + 1, std::memory_order_release);
+      }
+      return true;
+   }
+
+   //
+   // Name: tryPop
+   //
+   // Description: Consumer API. Moves the oldest published element into item.
+   //
+   // Return: bool - False if no published element is available.
+   //
+   bool tryPop(T& item)
+   {
+      auto pos{ dequeuePos.load(std::memory_order_relaxed) };
+      Slot* slot{ nullptr };
+
+      for (;;)
+      {
+         slot = &slots[pos & mask];
+         const auto seq{ slot->sequence.load(std::memory_order_acquire) };
+         const auto diff{ static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) };
+
+         if (0 == diff)
+         {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+               break;
+            }
+         }
+         else if (0 > diff)
+         {
+            return false; // Empty: the next element has not been published.
+         }
+         else
+         {
+            pos = dequeuePos.load(std::memory_order_relaxed); // An evicting producer took it.
+         }
+      }
+
+      item = slot->data;
+      slot->sequence.store(pos + capacity, std::memory_order_release);
+      return true;
+   }
+
+   //
+   // Name: pushEvictOldest
+   //
+   // Description: Producer API. Pushes item, evicting the oldest elements
+   //    for as long as the ring is full.
+   //
+   // Return: size_t - Number of elements evicted.
+   //
+   size_t pushEvictOldest(const T& item)
+   {
+      size_t rVal{ 0 };
+      T evicted{};
+
+      while (!tryPush(item))
+      {
+         if (tryPop(evicted))
+         {
+            ++rVal;
+         }
+      }
+      return rVal;
+   }
+
+   //
+   // Name: pushBatchEvictOldest
+   //
+   // Description: Producer API. tryPushBatch, evicting the oldest elements
+   //    until the batch fits.
+   //
+   // Params: items - Pointer to count elements.
+   //         count - Number of elements, at most getCapacity().
+   //
+   // Return: size_t - Number of elements evicted.
+   //
+   size_t pushBatchEvictOldest(const T* items, size_t count)
+   {
+      size_t rVal{ 0 };
+      T evicted{};
+
+      while ((count <= capacity) && !tryPushBatch(items, count))
+      {
+         if (tryPop(evicted))
+         {
+            ++rVal;
+         }
+      }
+      return rVal;
+   }
+
+   //
+   // Name: empty
+   //
+   // Description: Consumer API. True if the next element has not been published.
+   //
+   bool empty() const
+   {
+      const auto pos{ dequeuePos.load(std::memory_order_relaxed) };
+      return slots[pos & mask].sequence.load(std::memory_order_acquire) != (pos + 1);
+   }
+
+   //
+   // Name: size
+   //
+   // Description: Approximate number of claimed slots. Exact only when quiescent.
+   //
+   size_t size() const
+   {
+      const auto tail{ enqueuePos.load(std::memory_order_acquire) };
+      const auto head{ dequeuePos.load(std::memory_order_acquire) };
+      return (tail > head) ? (tail - head) : 0;
+   }
+
+   size_t getCapacity() const { return capacity; }
+};
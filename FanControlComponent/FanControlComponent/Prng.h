@@ -0,0 +1,64 @@
+/*
+* Class: Prng
+*
+* Description: Small, fast pseudo random number generator (xorshift64*) for
+*     the simulated subsystems. Unlike rand() it has no global state and
+*     takes no lock, so every simulated subsystem owns one and the sequence
+*     it produces only depends on its seed.
+*
+*     Not for anything security related.
+*
+*/
+
+#pragma once
+
+#include <cstdint>
+
+class Prng final
+{
+   uint64_t state;
+
+public:
+   //
+   // Name: Prng (ctor)
+   //
+   // Params: seed - Any value; it is mixed (splitmix64) so that close seeds,
+   //            e.g. consecutive subsystem ids, give unrelated sequences.
+   //
+   explicit Prng(uint64_t seed)
+   {
+      auto mixed{ seed + 0x9E3779B97F4A7C15ull };
+      mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+      mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+      mixed ^= (mixed >> 31);
+      state = (0 == mixed) ? 0x9E3779B97F4A7C15ull : mixed; // xorshift state must be non zero.
+   }
+
+   uint64_t next()
+   {
+      state ^= state >> 12;
+      state ^= state << 25;
+      state ^= state >> 27;
+      return state * 0x2545F4914F6CDD1Dull;
+   }
+
+   //
+   // Name: nextBelow
+   //
+   // Return: uint32_t - Uniform in [0, bound), bound must be non zero.
+   //
+   uint32_t nextBelow(uint32_t bound)
+   {
+      return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+   }
+
+   //
+   // Name: nextFloat
+   //
+   // Return: float - Uniform in [0, 1).
+   //
+   float nextFloat()
+   {
+      return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+   }
+};
\ No newline at end of file
@@ -0,0 +1,80 @@
+/*
+* Class: RegisterBackend
+*
+* Description: Where the fan registers live. A backend resolves a register
+*     address (as found in FanConstants::FAN_REGISTER_ADDRESSES or a fan
+*     address map) to a pointer to the 32-bit register, once, when the
+*     FanRegisters is built. Register writes then go straight through the
+*     pointer, so the backend costs nothing on the hot path.
+*
+*     RawRegisterBackend      - The address is the pointer (hardware, or the
+*                               address of a mock register in this process).
+*     MemoryRegisterBackend   - Registers are recorded in a zeroed in-memory
+*                               bank, readable with peek().
+*     MappedRegisterBackend   - Registers are in an mmap'd device, file or
+*                               shared memory region (MappedRegisterBackend.h).
+*
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+class RegisterBackend
+{
+public:
+   virtual ~RegisterBackend() = default;
+
+   //
+   // Name: resolve
+   //
+   // Params: address - Register address.
+   //
+   // Return: volatile uint32_t* - The register, nullptr if the backend has
+   //       no register at that address.
+   //
+   virtual volatile uint32_t* resolve(uint64_t address) = 0;
+};
+
+class RawRegisterBackend final : public RegisterBackend
+{
+public:
+   volatile uint32_t* resolve(uint64_t address) override
+   {
+      return reinterpret_cast<volatile uint32_t*>(address);
+   }
+};
+
+class MemoryRegisterBackend final : public RegisterBackend
+{
+   // Node based, so a register's address never moves once resolved.
+   std::unordered_map<uint64_t, std::unique_ptr<uint32_t>> bank;
+
+public:
+   volatile uint32_t* resolve(uint64_t address) override
+   {
+      auto& reg{ bank[address] };
+      if (nullptr == reg)
+      {
+         reg = std::make_unique<uint32_t>(0);
+      }
+      return reg.get();
+   }
+
+   //
+   // Name: peek
+   //
+   // Return: uint32_t - Last value written to the register at address,
+   //       0 if it was never resolved.
+   //
+   uint32_t peek(uint64_t address) const
+   {
+      auto itr{ bank.find(address) };
+      return (bank.end() == itr) ? 0 : *static_cast<volatile const uint32_t*>(itr->second.get());
+   }
+
+   size_t size() const { return bank.size(); }
+};
\ No newline at end of file
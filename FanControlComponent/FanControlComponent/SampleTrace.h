@@ -0,0 +1,40 @@
+/*
+* Struct: SampleTrace
+*
+* Description: Timestamps of one temp sample on its way from the sensor to
+*     the fan registers, for end-to-end latency measurement (LatencyRecorder).
+*
+*     The sender stamps the sample with a sequence number and the time it was
+*     read (SubSysIdAndTemp SampleTimeNs / SequenceNum). The TempMonitor adds
+*     the time an RPC handler ingested it and the time the tempThread applied
+*     it, the ListenerDispatcher the time it was handed to a listener.
+*     A sample without SampleTimeNs is not traced.
+*
+*     All times are steady_clock nanoseconds since its epoch.
+*
+*     {RISK}: steady_clock is only comparable between processes on the same
+*             host. Samples stamped on another host produce meaningless
+*             SENSOR_TO_INGEST and END_TO_END latencies.
+*
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+struct SampleTrace
+{
+   uint64_t sequenceNum{ 0 };
+   int64_t  sampleTimeNs{ 0 };  // Read by the sensor, 0 if the sample is not traced.
+   int64_t  ingestTimeNs{ 0 };  // Received by an RPC handler.
+   int64_t  processTimeNs{ 0 }; // Applied to the temp tables by the tempThread.
+   int64_t  notifyTimeNs{ 0 };  // Handed to the listener.
+
+   bool isTraced() const { return 0 != sampleTimeNs; }
+
+   static int64_t nowNs()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+};
\ No newline at end of file
@@ -0,0 +1,333 @@
+#include "SharedTempTable.h"
+#include "log.h"
+
+#include <chrono>
+#include <new>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SHARED_TEMP_TABLE_HAS_SHM
+#endif
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#define SHARED_TEMP_TABLE_HAS_FUTEX
+#endif
+
+namespace
+{
+#ifdef SHARED_TEMP_TABLE_HAS_FUTEX
+   //
+   // Name: futexWord
+   //
+   // Description: std::atomic::wait/notify use private futexes, which do not
+   //    wake other processes, so the table calls the futex syscall itself.
+   //
+   uint32_t* futexWord(std::atomic<uint32_t>& word)
+   {
+      return reinterpret_cast<uint32_t*>(&word);
+   }
+
+   void futexWait(std::atomic<uint32_t>& word, uint32_t expected, uint32_t timeoutMs)
+   {
+      timespec timeout{};
+      timeout.tv_sec  = static_cast<time_t>(timeoutMs / 1000);
+      timeout.tv_nsec = static_cast<long>((timeoutMs % 1000) * 1'000'000);
+      ::syscall(SYS_futex, futexWord(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+   }
+
+   void futexWakeAll(std::atomic<uint32_t>& word)
+   {
+      ::syscall(SYS_futex, futexWord(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+   }
+#endif
+}
+
+//
+// Name: SharedTempTable (ctor)
+//
+// Params: tableName - Shared memory object name, e.g. "/fcc_temps".
+//
+SharedTempTable::SharedTempTable(const std::string& tableName)
+   : name(tableName)
+{
+   // Empty
+}
+
+//
+// Name: ~SharedTempTable (dtor)
+//
+SharedTempTable::~SharedTempTable()
+{
+   close();
+}
+
+//
+// Name: getTableLength
+//
+// Return: size_t - Bytes needed for the header and slotCount slots.
+//
+size_t SharedTempTable::getTableLength(size_t slotCount)
+{
+   return sizeof(Header) + (slotCount * sizeof(Slot));
+}
+
+//
+// Name: create
+//
+// Description: Reader API. Creates (replacing any stale one) and maps the
+//    shared memory object, with every slot unpublished.
+//
+// Params: slotCount - Number of slots, non zero.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes SharedTempTable::create(size_t slotCount)
+{
+   auto rVal{ GeneralConstants::ReturnCodes::SHARED_TEMP_TABLE_OPEN_FAILED };
+
+#ifdef SHARED_TEMP_TABLE_HAS_SHM
+   close();
+
+   const auto length{ getTableLength(slotCount) };
+
+   ::shm_unlink(name.c_str());
+   const auto fd{ ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600) };
+   if ((fd >= 0) && (0 != slotCount))
+   {
+      if (0 == ::ftruncate(fd, static_cast<off_t>(length)))
+      {
+         auto addr{ ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) };
+         if (MAP_FAILED != addr)
+         {
+            mapping       = addr;
+            mappingLength = length;
+            owner         = true;
+
+            header = new (addr) Header();
+            header->numSlots = static_cast<uint32_t>(slotCount);
+
+            slots = reinterpret_cast<Slot*>(static_cast<uint8_t*>(addr) + sizeof(Header));
+            for (size_t idx{ 0 }; idx < slotCount; ++idx)
+            {
+               new (&slots[idx]) Slot();
+            }
+            numSlots = slotCount;
+            lastSequences.assign(slotCount, 0);
+
+            rVal = GeneralConstants::ReturnCodes::SUCCESS;
+         }
+      }
+
+      if (!owner)
+      {
+         ::shm_unlink(name.c_str());
+      }
+   }
+
+   if (fd >= 0)
+   {
+      ::close(fd); // The mapping keeps its own reference.
+   }
+#endif
+
+   DEBUG_STD_OUT("SharedTempTable::create() - name[" << name << "], slots[" << slotCount << "], rVal[" << GeneralConstants::ReturnCodesStrings.find(rVal)->second << "]");
+   return rVal;
+}
+
+//
+// Name: open
+//
+// Description: Writer API. Maps a table created by the reader. Fails if it
+//    does not exist (yet) or is not a SharedTempTable of this VERSION.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes SharedTempTable::open()
+{
+   auto rVal{ GeneralConstants::ReturnCodes::SHARED_TEMP_TABLE_OPEN_FAILED };
+
+#ifdef SHARED_TEMP_TABLE_HAS_SHM
+   close();
+
+   const auto fd{ ::shm_open(name.c_str(), O_RDWR, 0600) };
+   if (fd >= 0)
+   {
+      struct stat fileStat{};
+      if ((0 == ::fstat(fd, &fileStat)) && (static_cast<size_t>(fileStat.st_size) >= sizeof(Header)))
+      {
+         const auto length{ static_cast<size_t>(fileStat.st_size) };
+         auto addr{ ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) };
+         if (MAP_FAILED != addr)
+         {
+            mapping       = addr;
+            mappingLength = length;
+
+            auto table{ static_cast<Header*>(addr) };
+            if ((MAGIC == table->magic) && (VERSION == table->version) &&
+                (getTableLength(table->numSlots) <= length))
+            {
+               header   = table;
+               slots    = reinterpret_cast<Slot*>(static_cast<uint8_t*>(addr) + sizeof(Header));
+               numSlots = table->numSlots;
+               rVal     = GeneralConstants::ReturnCodes::SUCCESS;
+            }
+            else
+            {
+               close();
+            }
+         }
+      }
+      ::close(fd); // The mapping keeps its own reference.
+   }
+#endif
+
+   DEBUG_STD_OUT("SharedTempTable::open() - name[" << name << "], slots[" << numSlots << "], rVal[" << GeneralConstants::ReturnCodesStrings.find(rVal)->second << "]");
+   return rVal;
+}
+
+//
+// Name: close
+//
+// Description: Unmaps the table; the reader (creator) also removes it.
+//
+void SharedTempTable::close()
+{
+#ifdef SHARED_TEMP_TABLE_HAS_SHM
+   if (nullptr != mapping)
+   {
+      ::munmap(mapping, mappingLength);
+   }
+   if (owner)
+   {
+      ::shm_unlink(name.c_str());
+   }
+#endif
+   owner         = false;
+   mapping       = nullptr;
+   mappingLength = 0;
+   header        = nullptr;
+   slots         = nullptr;
+   numSlots      = 0;
+   lastSequences.clear();
+}
+
+//
+// Name: publish
+//
+// Description: Writer API. Overwrites the slot with the latest temp and
+//    wakes the reader if it is asleep. The slot must have no other writer.
+//
+// Params: slot - Slot index, [0, getSize()).
+//         subSysId - Subsystem id of the temp.
+//         temp - Temperature.
+//         sampleTimeNs - When the temp was read (SampleTrace::nowNs), 0 if not traced.
+//         sequenceNum - The writer's sample sequence number, if traced.
+//
+// Return: bool - False if the table is not open or the slot out of range.
+//
+bool SharedTempTable::publish(size_t slot, int subSysId, float temp, int64_t sampleTimeNs, uint64_t sequenceNum)
+{
+   if (slot >= numSlots)
+   {
+      return false;
+   }
+
+   auto& entry{ slots[slot] };
+
+   // Still odd if a previous writer died mid-write; carry on from there.
+   const auto seq{ entry.sequence.load(std::memory_order_relaxed) | 1u };
+   entry.sequence.store(seq, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_release);
+
+   entry.subSysId.store(subSysId, std::memory_order_relaxed);
+   entry.temp.store(temp, std::memory_order_relaxed);
+   entry.sampleTimeNs.store(static_cast<uint64_t>(sampleTimeNs), std::memory_order_relaxed);
+   entry.sequenceNum.store(sequenceNum, std::memory_order_relaxed);
+
+   entry.sequence.store(seq + 1, std::memory_order_release);
+
+   notify();
+   return true;
+}
+
+//
+// Name: notify
+//
+// Description: Wakes the reader if it is asleep, see EventCount::notify.
+//    Writers only pay for the syscall after a prepareWait.
+//
+void SharedTempTable::notify()
+{
+   if (nullptr == header)
+   {
+      return;
+   }
+
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if ((0 != header->sleeping.load(std::memory_order_relaxed)) &&
+       (0 != header->sleeping.exchange(0, std::memory_order_acq_rel)))
+   {
+      header->epoch.fetch_add(1, std::memory_order_seq_cst);
+#ifdef SHARED_TEMP_TABLE_HAS_FUTEX
+      futexWakeAll(header->epoch);
+#endif
+   }
+}
+
+//
+// Name: prepareWait
+//
+// Description: Reader API. Announces the intent to sleep. The reader must
+//    poll again after this call and then either cancelWait() or
+//    commitWait() with the returned key.
+//
+// Return: uint32_t - Key to pass to commitWait.
+//
+uint32_t SharedTempTable::prepareWait()
+{
+   header->sleeping.store(1, std::memory_order_seq_cst);
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   return header->epoch.load(std::memory_order_seq_cst);
+}
+
+//
+// Name: cancelWait
+//
+// Description: Reader API. Withdraws a prepareWait when a slot was published.
+//
+void SharedTempTable::cancelWait()
+{
+   header->sleeping.store(0, std::memory_order_relaxed);
+}
+
+//
+// Name: commitWait
+//
+// Description: Reader API. Sleeps until a notify after prepareWait returned
+//    key, or at most timeoutMs. May return early (spurious wake-up); the
+//    reader just polls again.
+//
+// Params: key - Value returned from prepareWait.
+//         timeoutMs - Longest sleep, so a writer that died between its
+//             publish and notify cannot keep the reader asleep.
+//
+void SharedTempTable::commitWait(uint32_t key, uint32_t timeoutMs)
+{
+#ifdef SHARED_TEMP_TABLE_HAS_FUTEX
+   if (header->epoch.load(std::memory_order_acquire) == key)
+   {
+      futexWait(header->epoch, key, timeoutMs);
+   }
+#else
+   std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+#endif
+   cancelWait();
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*
+* Class: SharedTempTable
+*
+* Description: Ingestion transport for sensor daemons on the same host. A
+*     POSIX shared memory object holds one cache line sized slot per
+*     subsystem; a daemon reports a temp by writing its slot under a
+*     seqlock, without a syscall or any serialization. The TempMonitor
+*     (TempMonitorConfig::sharedTableName) creates the table and submits the
+*     temps it finds, side by side with the gRPC server.
+*
+*     Writers: open() the table by name and publish() to their own slot.
+*     Every slot must have a single writer. A slot only holds the latest
+*     temp, a temp overwritten before the reader polled it is lost.
+*
+*     Reader (a single thread): create() the table, poll() it and, when
+*     nothing changed, sleep with prepareWait() / cancelWait() /
+*     commitWait() as with an EventCount. The wake-up is a process shared
+*     futex on a word of the table; publish() only pays for it when the
+*     reader is actually asleep.
+*
+* {RISK}: A writer that dies mid-write leaves its slot odd (busy). The slot
+*     is skipped until a writer publishes to it again.
+*
+* {RISK}: create() removes an existing table of the same name. Writers
+*     still mapping the old one must open() again.
+*
+* {RISK}: POSIX only. On other platforms create() and open() fail with
+*     SHARED_TEMP_TABLE_OPEN_FAILED. Without futexes (non Linux) commitWait
+*     sleeps for its timeout, i.e. the reader polls.
+*
+*/
+
+#pragma once
+
+#include "GeneralConstants.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class SharedTempTable final
+{
+public:
+   static constexpr size_t   CACHE_LINE_SIZE{ GeneralConstants::CACHE_LINE_SIZE };
+   static constexpr uint64_t MAGIC{ 0x3154'5448'5343'4346 }; // "FCCSHTT1"
+   static constexpr uint32_t VERSION{ 1 };
+   static constexpr uint32_t DEFAULT_WAIT_TIMEOUT_MS{ 100 };
+
+private:
+   struct alignas(CACHE_LINE_SIZE) Header
+   {
+      uint64_t magic{ MAGIC };
+      uint32_t version{ VERSION };
+      uint32_t numSlots{ 0 };
+
+      alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> epoch{ 0 };    // Futex word, bumped to wake the reader.
+      std::atomic<uint32_t>                          sleeping{ 0 }; // 1 while the reader is (about to be) asleep.
+   };
+
+   struct alignas(CACHE_LINE_SIZE) Slot
+   {
+      std::atomic<uint32_t> sequence{ 0 };   // Odd while the writer is inside.
+      std::atomic<int32_t>  subSysId{ 0 };
+      std::atomic<float>    temp{ 0.0f };
+      std::atomic<uint64_t> sampleTimeNs{ 0 };
+      std::atomic<uint64_t> sequenceNum{ 0 };
+   };
+
+   // The table is shared with other processes, nothing in it may need a lock.
+   static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<int32_t>::is_always_lock_free &&
+                 std::atomic<float>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+                 "SharedTempTable needs lock-free atomics.");
+   static_assert(sizeof(Slot) == CACHE_LINE_SIZE, "A Slot must fill exactly one cache line.");
+
+   const std::string     name;
+   bool                  owner{ false };
+   void*                 mapping{ nullptr };
+   size_t                mappingLength{ 0 };
+   Header*               header{ nullptr };
+   Slot*                 slots{ nullptr };
+   size_t                numSlots{ 0 };
+   std::vector<uint32_t> lastSequences;   // Reader only: slot sequence last polled.
+
+   static size_t getTableLength(size_t slotCount);
+
+public:
+   explicit SharedTempTable(const std::string& name);
+   ~SharedTempTable();
+
+   SharedTempTable(const SharedTempTable&) = delete;
+   SharedTempTable& operator=(const SharedTempTable&) = delete;
+
+   GeneralConstants::ReturnCodes create(size_t slotCount);
+   GeneralConstants::ReturnCodes open();
+   void close();
+
+   bool publish(size_t slot, int subSysId, float temp, int64_t sampleTimeNs = 0, uint64_t sequenceNum = 0);
+   void notify();
+
+   uint32_t prepareWait();
+   void cancelWait();
+   void commitWait(uint32_t key, uint32_t timeoutMs = DEFAULT_WAIT_TIMEOUT_MS);
+
+   //
+   // Name: poll
+   //
+   // Description: Reader API. Calls func(subSysId, temp, sampleTimeNs,
+   //    sequenceNum) for every slot published since the previous poll.
+   //    A slot being written is left for the next poll; its writer
+   //    notifies again when it is done.
+   //
+   // Params: func - Callable taking (int, float, int64_t, uint64_t).
+   //
+   // Return: size_t - Number of slots reported.
+   //
+   template <typename Func>
+   size_t poll(Func&& func)
+   {
+      size_t rVal{ 0 };
+
+      for (size_t idx{ 0 }; idx < numSlots; ++idx)
+      {
+         const auto& entry{ slots[idx] };
+
+         const auto seqBefore{ entry.sequence.load(std::memory_order_acquire) };
+         if ((seqBefore == lastSequences[idx]) || (0 != (seqBefore & 1)))
+         {
+            continue;
+         }
+
+         const auto subSysId{ entry.subSysId.load(std::memory_order_relaxed) };
+         const auto temp{ entry.temp.load(std::memory_order_relaxed) };
+         const auto sampleTimeNs{ entry.sampleTimeNs.load(std::memory_order_relaxed) };
+         const auto sequenceNum{ entry.sequenceNum.load(std::memory_order_relaxed) };
+         std::atomic_thread_fence(std::memory_order_acquire);
+
+         if (seqBefore == entry.sequence.load(std::memory_order_relaxed))
+         {
+            lastSequences[idx] = seqBefore;
+            func(static_cast<int>(subSysId), temp, static_cast<int64_t>(sampleTimeNs), sequenceNum);
+            ++rVal;
+         }
+      }
+      return rVal;
+   }
+
+   bool isOpen() const { return nullptr != header; }
+   size_t getSize() const { return numSlots; }
+};
\ No newline at end of file
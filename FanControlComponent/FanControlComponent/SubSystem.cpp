@@ -14,13 +14,24 @@ namespace
 // Params: channel - The gRPC Channel to use to communicate with gRpc server.
 //         ssid - The SubSystem ID to use..
 //         updater - Callback to the UI, to update the SubSystem Temps.
+//         mode - UNARY (RPC per temp), STREAMING (one long-lived stream) or
+//                ASYNC (RPC per temp, not waited for).
+//         sender - ASYNC mode: sender to share with other SubSystems, nullptr
+//                  for one of its own.
 //
-SubSystem::SubSystem(std::shared_ptr<grpc::Channel> channel, int ssid, UiUpdater* updater )
+SubSystem::SubSystem(std::shared_ptr<grpc::Channel> channel, int ssid, UiUpdater* updater, SendMode mode,
+                     std::shared_ptr<AsyncTempSender> sender )
    : stub_(TempMonitorSink::TempMonitorServer::NewStub(channel))
    , uiUpdater(updater)
    , subSystemId(ssid)
+   , sendMode(mode)
+   , prng(static_cast<uint64_t>(static_cast<uint32_t>(ssid)))
+   , asyncSender(std::move(sender))
 {
-   // Empty
+   if( ( SendMode::ASYNC == sendMode ) && ( nullptr == asyncSender ) )
+   {
+      asyncSender = std::make_shared<AsyncTempSender>( channel );
+   }
 }
 
 //
@@ -40,6 +51,8 @@ SubSystem::~SubSystem()
       subSysThread.join();
    }
 
+   closeStream();
+
    DEBUG_STD_OUT("SubSystem::~dtor() - SSID=[" << subSystemId << "] - EXIT");
 }
 
@@ -92,12 +105,46 @@ GeneralConstants::ReturnCodes SubSystem::stop()
 //
 // Param: temp - The temperature to send.
 //
+// Note: In STREAMING mode sendTemp must not be called concurrently.
+//       In ASYNC mode the temp is dropped if the sender has too many RPCs
+//       in flight; RPC errors are logged by the sender.
+//
 void SubSystem::sendTemp( float temp )
 {
+   const auto sampleTimeNs{ SampleTrace::nowNs() };
+   const auto sequence{ sequenceNum.fetch_add( 1, std::memory_order_relaxed ) + 1 };
+
+   if( SendMode::ASYNC == sendMode )
+   {
+      if( !asyncSender->send( subSystemId, temp, sequence, sampleTimeNs ) )
+      {
+         LOG_RATE_LIMITED( LogLevel::WARN, LOG_DEFAULT_RATE_LIMIT_MS, "SubSystem::sendTemp() - WARNING: SSID=[{}] - Too many RPCs in flight, temp dropped.", subSystemId );
+      }
+      return;
+   }
+
 	// Data we are sending to the server.
 	TempMonitorSink::SubSysIdAndTemp data;
 	data.set_subsysid(subSystemId);
 	data.set_temp(temp);
+	data.set_sampletimens(static_cast<uint64_t>(sampleTimeNs));
+	data.set_sequencenum(sequence);
+
+   if( SendMode::STREAMING == sendMode )
+   {
+      // A failed Write means the stream is broken (e.g. server restarted).
+      // Close it, reopen and retry once.
+      if( !openStream() || !streamWriter->Write(data) )
+      {
+         closeStream();
+         if( !openStream() || !streamWriter->Write(data) )
+         {
+            LOG_RATE_LIMITED( LogLevel::ERR, LOG_DEFAULT_RATE_LIMIT_MS, "SubSystem::sendTemp() - ERROR: SSID=[{}] - Unable to write to the temp stream.", subSystemId );
+            closeStream();
+         }
+      }
+      return;
+   }
 
 	TempMonitorSink::empty_param emptyRVal;
 
@@ -115,6 +162,73 @@ void SubSystem::sendTemp( float temp )
 	}
 }
 
+//
+// Name: sendTempBatch
+//
+// Description: Sends the temps of many subsystems (e.g. every sensor on a
+//    board controller) to the RPC Server in one UpdateSubSystemTempsBatch RPC.
+//
+// Param: ssIds - SubSystem ids.
+//        temps - temps[i] is the temperature of ssIds[i].
+//
+// Return: grpc::Status - Status of the RPC.
+//
+grpc::Status SubSystem::sendTempBatch( const std::vector<int>& ssIds, const std::vector<float>& temps )
+{
+   TempMonitorSink::SubSysIdsAndTemps data;
+   data.mutable_subsysids()->Add( ssIds.begin(), ssIds.end() );
+   data.mutable_temps()->Add( temps.begin(), temps.end() );
+
+   TempMonitorSink::empty_param emptyRVal;
+   grpc::ClientContext context;
+
+   auto status{ stub_->UpdateSubSystemTempsBatch(&context, data, &emptyRVal) };
+   if( !status.ok() )
+   {
+      PRINT_STD_OUT( "SubSystem::sendTempBatch() - ERROR: ["<< status.error_code() << "] -  " << status.error_message());
+   }
+   return status;
+}
+
+//
+// Name: openStream
+//
+// Description: STREAMING mode. Opens the StreamSubSystemTemps stream if it
+//    is not already open.
+//
+// Return: bool - True if the stream is open.
+//
+bool SubSystem::openStream()
+{
+   if( nullptr == streamWriter )
+   {
+      streamContext = std::make_unique<grpc::ClientContext>();
+      streamWriter  = stub_->StreamSubSystemTemps( streamContext.get(), &streamResponse );
+   }
+   return nullptr != streamWriter;
+}
+
+//
+// Name: closeStream
+//
+// Description: STREAMING mode. Half-closes the stream and collects the
+//    final status from the server.
+//
+void SubSystem::closeStream()
+{
+   if( nullptr != streamWriter )
+   {
+      streamWriter->WritesDone();
+      auto status{ streamWriter->Finish() };
+      if( !status.ok() )
+      {
+         PRINT_STD_OUT( "SubSystem::closeStream() - ERROR: SSID=[" << subSystemId << "] - [" << status.error_code() << "] -  " << status.error_message() );
+      }
+      streamWriter.reset();
+      streamContext.reset();
+   }
+}
+
 //
 // Name: SubSytemThread
 //
@@ -146,7 +260,7 @@ void SubSystem::SubSytemThread()
          uiUpdater->updateSubSystemTemp( subSystemId, temp);
       }
 
-      tempIncDirection = rand() % 3;
+      tempIncDirection = static_cast<int>(prng.nextBelow(3));
 
       switch (tempIncDirection)
       {
@@ -5,22 +5,61 @@
 *     help facilitate demo and testing. Connects to the TempMonitor gRPC
 *     server and sends a <SubSystemID / temperature> pair to the server.
 *
+*     In UNARY mode every temperature is its own UpdateSubSystemTemp RPC.
+*     In STREAMING mode one StreamSubSystemTemps stream is kept open for the
+*     life of the SubSystem and each temperature is a single Write on it.
+*     In ASYNC mode each temperature is an UpdateSubSystemTemp RPC started
+*     through an AsyncTempSender, which can be shared by many SubSystems;
+*     sendTemp does not wait for the reply.
+*
+*     Every temperature is stamped with its sequence number and the time it
+*     was read, so the TempMonitor can trace its latency (see SampleTrace).
+*
 */
 
 #pragma once
 
+#include "AsyncTempSender.h"
 #include "GeneralConstants.h"
+#include "Prng.h"
+#include "SampleTrace.h"
 #include "UiUpdater.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+
 #include <grpcpp/grpcpp.h>
 #include "TempMonitor.grpc.pb.h"
 
 class SubSystem final
 {
+public:
+   enum class SendMode
+   {
+        UNARY
+      , STREAMING
+      , ASYNC
+   };
+
+private:
    int subSystemId{INT_MIN};
+   const SendMode sendMode{ SendMode::UNARY };
+   Prng           prng;      // Own generator, rand() is shared and locked.
+   std::atomic<uint64_t> sequenceNum{ 0 }; // Of the last temp sent.
 
    std::unique_ptr<TempMonitorSink::TempMonitorServer::Stub> stub_;
    UiUpdater*              uiUpdater{nullptr};
+
+   // STREAMING mode: the long-lived stream and its context/response.
+   std::unique_ptr<grpc::ClientContext>                              streamContext;
+   TempMonitorSink::empty_param                                      streamResponse;
+   std::unique_ptr<grpc::ClientWriter<TempMonitorSink::SubSysIdAndTemp>> streamWriter;
+   bool openStream();
+   void closeStream();
+
+   // ASYNC mode: the (possibly shared) sender.
+   std::shared_ptr<AsyncTempSender> asyncSender;
    
    std::thread             subSysThread;
    std::condition_variable subSysThreadCond;
@@ -30,10 +69,12 @@ class SubSystem final
    void SubSytemThread();
 
 public:
-   SubSystem(std::shared_ptr<grpc::Channel> channel, int ssid, UiUpdater* updater = nullptr);
+   SubSystem(std::shared_ptr<grpc::Channel> channel, int ssid, UiUpdater* updater = nullptr, SendMode mode = SendMode::UNARY,
+             std::shared_ptr<AsyncTempSender> sender = nullptr);
    ~SubSystem();
 
    void sendTemp( float temp );
+   grpc::Status sendTempBatch( const std::vector<int>& ssIds, const std::vector<float>& temps );
 
    GeneralConstants::ReturnCodes initialize();
    GeneralConstants::ReturnCodes start();
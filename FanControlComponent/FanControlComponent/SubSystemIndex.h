@@ -0,0 +1,159 @@
+/*
+* Class: SubSystemIndex
+*
+* Description: Immutable subsystem id -> slot index, built once from the
+*     configured subsystem ids. Slots are assigned in id order (duplicates
+*     keep their first slot), so they line up with the CoalescingTempTable
+*     and MaxTempTracker slots.
+*
+*     When the ids are dense (span no larger than DENSE_SPAN_FACTOR x count)
+*     the index is a flat array offset by the min id: one bounds check and
+*     one load. Otherwise it is an open addressing table (power of two,
+*     at most half full, linear probing), which is still O(1) and
+*     allocation free on lookup.
+*
+*     Read only after construction, so safe to share across gRPC handler
+*     threads without locking.
+*
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class SubSystemIndex final
+{
+   static constexpr uint32_t EMPTY_SLOT{ std::numeric_limits<uint32_t>::max() };
+   static constexpr size_t   DENSE_SPAN_FACTOR{ 4 };
+   static constexpr size_t   MIN_DENSE_SPAN{ 64 };
+
+   struct Entry
+   {
+      int      id{ 0 };
+      uint32_t slot{ EMPTY_SLOT };
+   };
+
+   bool                  dense{ true };
+   int64_t               minId{ 0 };
+   size_t                numSlots{ 0 };
+   std::vector<uint32_t> slots;   // Dense only, indexed by (id - minId).
+   std::vector<Entry>    entries; // Hashed only, id and slot share a cache line.
+   size_t                mask{ 0 };
+
+   static size_t hash(int id)
+   {
+      // Fibonacci hashing, the high bits are well mixed.
+      return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ull) >> 32);
+   }
+
+   //
+   // Name: insert
+   //
+   // Description: Adds id with the next slot unless it is already present.
+   //
+   void insert(int id)
+   {
+      if (dense)
+      {
+         auto& slot{ slots[static_cast<size_t>(id - minId)] };
+         if (EMPTY_SLOT == slot)
+         {
+            slot = static_cast<uint32_t>(numSlots++);
+         }
+         return;
+      }
+
+      for (auto pos{ hash(id) & mask }; ; pos = (pos + 1) & mask)
+      {
+         auto& entry{ entries[pos] };
+         if (EMPTY_SLOT == entry.slot)
+         {
+            entry = { id, static_cast<uint32_t>(numSlots++) };
+            return;
+         }
+         if (id == entry.id)
+         {
+            return;
+         }
+      }
+   }
+
+public:
+   static constexpr size_t NOT_FOUND{ std::numeric_limits<size_t>::max() };
+
+   //
+   // Name: SubSystemIndex (ctor)
+   //
+   // Params: ids - Subsystem ids, slot N is the Nth distinct id.
+   //
+   explicit SubSystemIndex(const std::vector<int>& ids)
+   {
+      if (!ids.empty())
+      {
+         const auto [minItr, maxItr] { std::minmax_element(ids.begin(), ids.end()) };
+         minId = *minItr;
+
+         const auto span{ static_cast<uint64_t>(static_cast<int64_t>(*maxItr) - minId) + 1 };
+         dense = span <= std::max(MIN_DENSE_SPAN, DENSE_SPAN_FACTOR * ids.size());
+
+         if (dense)
+         {
+            slots.assign(static_cast<size_t>(span), EMPTY_SLOT);
+         }
+         else
+         {
+            size_t capacity{ 1 };
+            while (capacity < (2 * ids.size()))
+            {
+               capacity <<= 1;
+            }
+            mask = capacity - 1;
+            entries.assign(capacity, Entry{});
+         }
+      }
+
+      for (auto id : ids)
+      {
+         insert(id);
+      }
+   }
+
+   //
+   // Name: find
+   //
+   // Params: id - Subsystem id.
+   //
+   // Return: size_t - Slot of the id, NOT_FOUND if it is not a configured subsystem.
+   //
+   size_t find(int id) const
+   {
+      if (dense)
+      {
+         const auto offset{ static_cast<uint64_t>(static_cast<int64_t>(id) - minId) };
+         const auto slot{ (offset < slots.size()) ? slots[static_cast<size_t>(offset)] : EMPTY_SLOT };
+         return (EMPTY_SLOT == slot) ? NOT_FOUND : slot;
+      }
+
+      for (auto pos{ hash(id) & mask }; ; pos = (pos + 1) & mask)
+      {
+         const auto& entry{ entries[pos] };
+         if (id == entry.id)
+         {
+            return (EMPTY_SLOT == entry.slot) ? NOT_FOUND : entry.slot;
+         }
+         if (EMPTY_SLOT == entry.slot)
+         {
+            return NOT_FOUND;
+         }
+      }
+   }
+
+   bool contains(int id) const { return NOT_FOUND != find(id); }
+
+   bool   isDense() const { return dense; }
+   size_t getSize() const { return numSlots; }
+};
@@ -1,7 +1,10 @@
 #include "TempMonitor.h"
+#include "TempMonitorAsyncServer.h"
 #include "log.h"
 
 #include <utility>
+#include <chrono>
+#include <string>
 
 //
 // Name: TempMonitor (ctor)
@@ -9,139 +12,475 @@
 // Description: Constructor
 //
 // Params: ssids - Vector of subsystem ids.
+//         config - TempMonitor tunables (queue capacity, ingestion mode, ...).
 //
-TempMonitor::TempMonitor( const std::vector<int>& ssIds ) : subSystemIds( ssIds )
+TempMonitor::TempMonitor( const std::vector<int>& ssIds, const TempMonitorConfig& cfg )
+   : config( cfg )
+   , subSystemIds( ssIds )
+   , queue( cfg.queueCapacity )
+   , subSystemSlots( ssIds )
+   , latestTemps( ssIds.size() )
+   , maxTemps( ssIds.size() )
+   , lowWatermark( (queue.getCapacity() * cfg.queueLowWatermarkPct) / 100 )
+   , highWatermark( (queue.getCapacity() * cfg.queueHighWatermarkPct) / 100 )
 {
+   // Flatten subsystem slot -> (zone, zone slot) memberships, so a temp
+   // update touches one contiguous run of zoneMembers.
+   std::vector<std::vector<ZoneMember>> membersBySlot( subSystemSlots.getSize() );
+   for( const auto& thermalZone : config.thermalZones )
+   {
+      const SubSystemIndex zoneSlots( thermalZone.subSystemIds );
+      zones.emplace_back( thermalZone.zoneId, zoneSlots.getSize() );
+
+      for( auto ssId : thermalZone.subSystemIds )
+      {
+         const auto slot{ subSystemSlots.find( ssId ) };
+         if( (SubSystemIndex::NOT_FOUND != slot) &&
+             (membersBySlot[slot].empty() || ((zones.size() - 1) != membersBySlot[slot].back().zone)) )
+         {
+            membersBySlot[slot].push_back( { zones.size() - 1, zoneSlots.find( ssId ) } );
+         }
+      }
+   }
+
+   if( !zones.empty() )
+   {
+      zoneMemberOffsets.push_back( 0 );
+      for( const auto& members : membersBySlot )
+      {
+         zoneMembers.insert( zoneMembers.end(), members.begin(), members.end() );
+         zoneMemberOffsets.push_back( zoneMembers.size() );
+      }
+      dirtyZones.reserve( zones.size() );
+   }
+
    DEBUG_STD_OUT("TempMonitor::ctor() - EXIT");
 }
 
 //
 // Name: ~TempMonitor (dtor)
 //
-// Description: Destructor, causes the tempThread to exit and stops
-//    the gRPC server.
+// Description: Destructor, causes the sharedTableThread and tempThread to
+//    exit and stops the gRPC server.
 //
 TempMonitor::~TempMonitor()
 {
    DEBUG_STD_OUT("TempMonitor::dtor() - ENTER");
 
+   if (sharedTableThread.joinable())
+   {
+      sharedTableKeepAlive.store(false);
+      sharedTable->notify();
+      sharedTableThread.join();
+   }
+   sharedTable.reset();
+
    if (tempThread.joinable())
    {
       tempThreadKeepAlive.store(false);
-      
-      queue.push(QueueElement());
-
-      tempThreadCond.notify_one();
+      tempThreadSignal.notify();
       tempThread.join();
    }
 
    if( nullptr != server )
    {
-      server->Shutdown();
+      server->Shutdown( std::chrono::system_clock::now() + std::chrono::milliseconds(GeneralConstants::GRPC_SERVER_SHUTDOWN_DEADLINE_MS) );
       server->Wait();
    }
+
+   asyncServer.reset();
+
    DEBUG_STD_OUT("TempMonitor::dtor() - EXIT");
 }
 
 //
 // Name: initialize
 //
-// Description: Starts the tempThread and the gRPC server.
+// Description: Starts the tempThread, the gRPC server and, if configured,
+//    the sharedTableThread.
 //
 // Return: GeneralConstants::ReturnCodes
 //
 GeneralConstants::ReturnCodes TempMonitor::initialize()
 {
+   if( (0 == config.queueLowWatermarkPct) ||
+       (config.queueLowWatermarkPct > config.queueHighWatermarkPct) ||
+       (100 < config.queueHighWatermarkPct) )
+   {
+      PRINT_STD_OUT( "TempMonitor::initialize - ERROR: Queue watermarks must satisfy 0 < low <= high <= 100, low[" 
+                     << config.queueLowWatermarkPct << "], high[" << config.queueHighWatermarkPct << "]" );
+      return GeneralConstants::ReturnCodes::TEMP_MONITOR_INVALID_CONFIG;
+   }
+
+   if( !checkThermalZones() )
+   {
+      PRINT_STD_OUT( "TempMonitor::initialize - ERROR: Thermal zones must have unique ids and only known subsystems." );
+      return GeneralConstants::ReturnCodes::TEMP_MONITOR_INVALID_CONFIG;
+   }
+
    tempThreadKeepAlive.store(true);
    tempThread = std::thread(&TempMonitor::updateTempsThread, this);
    
-   RunServer();
+   auto rVal{ RunServer() };
+   if( (GeneralConstants::ReturnCodes::SUCCESS == rVal) && !config.sharedTableName.empty() )
+   {
+      rVal = openSharedTable();
+   }
+   return rVal;
+}
+
+//
+// Name: openSharedTable
+//
+// Description: Creates the SharedTempTable and starts the sharedTableThread.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes TempMonitor::openSharedTable()
+{
+   sharedTable = std::make_unique<SharedTempTable>( config.sharedTableName );
 
-   return GeneralConstants::ReturnCodes::SUCCESS;
+   auto rVal{ sharedTable->create( config.sharedTableSlots ) };
+   if( GeneralConstants::ReturnCodes::SUCCESS == rVal )
+   {
+      sharedTableKeepAlive.store(true);
+      sharedTableThread = std::thread(&TempMonitor::pollSharedTableThread, this);
+   }
+   else
+   {
+      PRINT_STD_OUT( "TempMonitor::openSharedTable - ERROR: Unable to create shared temp table[" << config.sharedTableName << "]" );
+   }
+   return rVal;
+}
+
+//
+// Name: pollSharedTableThread
+//
+// Description: Main for the sharedTableThread. Submits every temp published
+//    to the SharedTempTable since the previous poll. When nothing changed
+//    it sleeps on the table's futex (FUTEX) or for sharedTablePollUs (POLL).
+//
+// Note: The table only keeps the latest temp per slot, so a temp rejected
+//       by a full queue is not retried; the writer's next temp supersedes it.
+//
+void TempMonitor::pollSharedTableThread()
+{
+   auto submitSample = [this]( int subSysId, float temp, int64_t sampleTimeNs, uint64_t sequenceNum )
+   {
+      if( GeneralConstants::ReturnCodes::SUCCESS != submit( subSysId, temp, sampleTimeNs, sequenceNum ) )
+      {
+         LOG_RATE_LIMITED( LogLevel::WARN, LOG_DEFAULT_RATE_LIMIT_MS, "TempMonitor::pollSharedTableThread - WARNING: Temp of SubSystemID ID:[{}] dropped, ingestion queue is full.", subSysId );
+      }
+   };
+
+   while( sharedTableKeepAlive.load() )
+   {
+      if( 0 != sharedTable->poll( submitSample ) )
+      {
+         continue;
+      }
+
+      if( TempMonitorConfig::SharedTableWait::POLL == config.sharedTableWait )
+      {
+         std::this_thread::sleep_for( std::chrono::microseconds( config.sharedTablePollUs ) );
+         continue;
+      }
+
+      const auto key{ sharedTable->prepareWait() };
+      if( !sharedTableKeepAlive.load() || (0 != sharedTable->poll( submitSample )) )
+      {
+         sharedTable->cancelWait();
+      }
+      else
+      {
+         sharedTable->commitWait( key );
+      }
+   }
 }
 
 //
 // Name: updateTempsThread
 //
-// Description: Main for the tempThread. Pulls a
-//    temp from the queue, releasing the mutex lock
-//    and then passing the temp on for analysis.
+// Description: Main for the tempThread. Drains the ring,
+//    passing the temps on for analysis, and in COALESCING mode
+//    sweeps the dirty latestTemps slots. When there is nothing
+//    to process the thread sleeps on tempThreadSignal until a
+//    handler publishes a new temp.
 //
-// {HAZARD}: If updateCurTemps is too slow to process the influx of temps,
+// {HAZARD}: If drainQueue is too slow to process the influx of temps,
 //         the queues will slowly become deeper and deeper, the temperatures
 //         being processed will be stale and memory utilization will become high.
 //
 // {HAZARD_MITIGATION}:
 //         1. Perform analysis to characterize this processing path.
-//         2. Consider adding a watchdog to log whenever the queue
-//            reach certain size (50%, 80%, etc).
+//         2. The ring is bounded (queueCapacity) and overflowPolicy decides
+//            whether senders are rejected or samples are dropped. checkQueueDepth
+//            logs when the depth crosses the low/high watermarks and getQueueStats
+//            reports the peak depth and drop counts.
+//         3. COALESCING ingestion mode: memory is fixed at one slot per
+//            subsystem and temps are at most one sweep stale.
 //
-// {HAZARD_TODO}: Hazard Mitigation.
+// {HAZARD_TODO}: Hazard Mitigation (QUEUE mode), escalate watermark warnings
+//         to system-level logging.
 //
 void TempMonitor::updateTempsThread()
 {
    while( tempThreadKeepAlive.load() )
    {
-      std::unique_lock<std::mutex> lock(tempThreadMux);
-      tempThreadCond.wait(lock, [this]() { return !queue.empty(); });
+      auto didWork{ false };
 
-      if (!tempThreadKeepAlive.load())
+      if( drainQueue() )
       {
-         break;
+         didWork = true;
       }
 
-      auto newTemp = queue.front();
-      queue.pop();
-      lock.unlock();
+      if( sweepLatestTemps() )
+      {
+         didWork = true;
+      }
 
-      updateCurTemps( newTemp );
+      if( didWork )
+      {
+         continue;
+      }
+
+      auto key{ tempThreadSignal.prepareWait() };
+      if( hasPendingTemps() || !tempThreadKeepAlive.load() )
+      {
+         tempThreadSignal.cancelWait();
+         continue;
+      }
+      tempThreadSignal.commitWait(key);
+   }
+}
+
+//
+// Name: sweepLatestTemps
+//
+// Description: COALESCING mode. Applies the latest temp of every dirty
+//    slot to the temp tables, then checks for a new max temp once.
+//
+// Return: bool - True if at least one slot was swept.
+//
+bool TempMonitor::sweepLatestTemps()
+{
+   auto swept{ latestTemps.sweep( [this](size_t slot, float temp)
+   {
+      updateTempTables( slot, temp );
+   }) };
+
+   if( (0 != swept) && updateCurMaxTemp() )
+   {
+      // New Max temp.
+      notifyNewMaxTemp( SampleTrace() );
    }
+   notifyZoneMaxTemps( SampleTrace() );
+   return 0 != swept;
 }
 
-// Name: updateCurTemps
 //
-// Description: Updates the subsystem temp table and the sorted temps list. 
-//    It checks if there is a new max temp and if there is, notify listeners. 
+// Name: hasPendingTemps
 //
-// Params: newTemp - The new temperature to process.
+// Description: True if either the ring or the latestTemps table holds
+//    temps that have not been processed yet.
 //
-void TempMonitor::updateCurTemps(QueueElement& newTemp )
+bool TempMonitor::hasPendingTemps() const
 {
-   if( INT_MIN != newTemp.subSysId )
+   return !queue.empty() || latestTemps.anyDirty();
+}
+
+//
+// Name: drainQueue
+//
+// Description: Pops up to one ring's worth of temps, updating the temp
+//    tables for each, then checks for a new max temp once. A batch RPC is
+//    contiguous in the ring so it costs a single max recompute.
+//
+//    Traced temps have their time in the ring recorded, and the newest of
+//    them is passed on with the notifications.
+//
+// Return: bool - True if at least one temp was popped.
+//
+bool TempMonitor::drainQueue()
+{
+   QueueElement newTemp;
+   SampleTrace trace;
+   size_t popped{ 0 };
+
+   checkQueueDepth( queue.size() );
+
+   while( (popped < queue.getCapacity()) && queue.tryPop(newTemp) )
    {
-      updateTempTables( std::make_pair(newTemp.subSysId, newTemp.temp) );
+      updateTempTables( getTempSlot(newTemp.subSysId), newTemp.temp );
+      ++popped;
+
+      if( 0 != newTemp.sampleTimeNs )
+      {
+         trace.sequenceNum   = newTemp.sequenceNum;
+         trace.sampleTimeNs  = newTemp.sampleTimeNs;
+         trace.ingestTimeNs  = newTemp.ingestTimeNs;
+         trace.processTimeNs = SampleTrace::nowNs();
+         latency.record( LatencyStage::INGEST_TO_PROCESS, trace.ingestTimeNs, trace.processTimeNs );
+      }
    }
 
-   if( updateCurMaxTemp() )
+   if( (0 != popped) && updateCurMaxTemp() )
    {
       // New Max temp.
-      notifyNewMaxTemp();
+      notifyNewMaxTemp( trace );
    }
+   notifyZoneMaxTemps( trace );
+   return 0 != popped;
+}
+
+//
+// Name: getTempSlot
+//
+// Description: Maps a subsystem id to its maxTemps slot. Known ids were
+//    assigned a slot in the ctor. Unknown ids are given a new slot the first
+//    time they are seen (see {HAZARD} on ingestTemp).
+//
+// Params: subSysId - Subsystem id.
+//
+// Return: size_t - maxTemps slot.
+//
+size_t TempMonitor::getTempSlot(int subSysId)
+{
+   auto rVal{ subSystemSlots.find(subSysId) };
+   if( SubSystemIndex::NOT_FOUND == rVal )
+   {
+      auto Itr{ unknownSubSystemSlots.find(subSysId) };
+      if( unknownSubSystemSlots.end() == Itr )
+      {
+         Itr = unknownSubSystemSlots.emplace( subSysId, maxTemps.addSlot() ).first;
+      }
+      rVal = Itr->second;
+   }
+   return rVal;
 }
 
 //
 // Name: updateTempTables
 //
-// Description: Check if the temp changed. If it did, remove the old temp 
-// from the sorted list and insert the new temp.
+// Description: Check if the temp changed. If it did, update the
+// subsystem's slot in the max temp tracker, and in the trackers
+// of the thermal zones it belongs to.
+//
+// Params: slot - maxTemps slot of the subsystem.
+//         temp - The new temperature to process.
+//
+// Notes: T: O(logn) per tracker, no allocation.
+//
+void TempMonitor::updateTempTables(size_t slot, float temp)
+{
+   if( maxTemps.get(slot) != temp )
+   {
+      maxTemps.update( slot, temp );
+
+      if( (slot + 1) < zoneMemberOffsets.size() )
+      {
+         updateZoneTables( slot, temp );
+      }
+   }
+}
+
+//
+// Name: updateZoneTables
 //
-// Params: newTemp - The new temperature to process. <SubSystemId,Temp>.
+// Description: Updates the subsystem's slot in every zone it belongs to,
+//    marking those zones for notifyZoneMaxTemps.
 //
-// Notes: Find T: O(logn), Erase Itr T: O(1), Insert is T: O(logn)
+// Params: slot - Known subsystem slot.
+//         temp - The new temperature.
 //
-void TempMonitor::updateTempTables(const std::pair<int, float>& newTemp)
+void TempMonitor::updateZoneTables(size_t slot, float temp)
 {
-   if (subSystemTemps[newTemp.first] != newTemp.second)
+   for( auto idx{ zoneMemberOffsets[slot] }; idx < zoneMemberOffsets[slot + 1]; ++idx )
    {
-      auto Itr{ curTemps.find(subSystemTemps[newTemp.first]) };
-      if( curTemps.end() != Itr )
+      const auto& member{ zoneMembers[idx] };
+      auto& zone{ zones[member.zone] };
+
+      zone.maxTemps.update( member.zoneSlot, temp );
+      if( !zone.dirty )
       {
-         curTemps.erase(Itr); // Old
+         zone.dirty = true;
+         dirtyZones.push_back( member.zone );
       }
-      curTemps.insert(newTemp.second); // New
+   }
+}
 
-      subSystemTemps[newTemp.first] = newTemp.second;
+//
+// Name: notifyZoneMaxTemps
+//
+// Description: Publishes the max temp of every zone updated since the
+//    last call whose max changed, to that zone's listeners.
+//
+// Params: trace - Newest traced sample applied since the last call, if any.
+//
+void TempMonitor::notifyZoneMaxTemps(const SampleTrace& trace)
+{
+   for( auto zoneIdx : dirtyZones )
+   {
+      auto& zone{ zones[zoneIdx] };
+      zone.dirty = false;
+
+      if( zone.maxTemps.hasMax() && (zone.maxTemps.getMax() != zone.curMaxTemp) )
+      {
+         zone.curMaxTemp = zone.maxTemps.getMax();
+         zone.listeners->publish( zone.curMaxTemp, trace );
+      }
    }
+   dirtyZones.clear();
+}
+
+//
+// Name: checkThermalZones
+//
+// Return: bool - True if every zone has a unique id and at least one
+//       subsystem, and every zone subsystem is a known subsystem.
+//
+bool TempMonitor::checkThermalZones() const
+{
+   auto rVal{ true };
+
+   for( size_t idx{ 0 }; rVal && (idx < config.thermalZones.size()); ++idx )
+   {
+      const auto& thermalZone{ config.thermalZones[idx] };
+      rVal = !thermalZone.subSystemIds.empty();
+
+      for( size_t prev{ 0 }; rVal && (prev < idx); ++prev )
+      {
+         rVal = (config.thermalZones[prev].zoneId != thermalZone.zoneId);
+      }
+
+      for( auto ssId : thermalZone.subSystemIds )
+      {
+         rVal = rVal && subSystemSlots.contains( ssId );
+      }
+   }
+   return rVal;
+}
+
+//
+// Name: findZone
+//
+// Params: zoneId - ThermalZone id.
+//
+// Return: Zone* - The zone, nullptr if no zone has that id.
+//
+TempMonitor::Zone* TempMonitor::findZone(int zoneId)
+{
+   Zone* rVal{ nullptr };
+
+   for( auto& zone : zones )
+   {
+      if( zoneId == zone.zoneId )
+      {
+         rVal = &zone;
+         break;
+      }
+   }
+   return rVal;
 }
 
 //
@@ -151,15 +490,14 @@ void TempMonitor::updateTempTables(const std::pair<int, float>& newTemp)
 //
 // Return: bool - True if a new max temp was identified. False otherwise.
 //
-// Notes: Find & Erase is T: O(logn). Insert is T: O(logn)
+// Notes: T: O(1)
 //
 bool TempMonitor::updateCurMaxTemp()
 {
    auto rVal{ false };
-   auto maxTemp{ *(--curTemps.end()) };
-   if( maxTemp != curMaxTemp )
+   if( maxTemps.hasMax() && (maxTemps.getMax() != curMaxTemp) )
    {
-      curMaxTemp = maxTemp;
+      curMaxTemp = maxTemps.getMax();
       rVal = true;
    }
    return rVal;
@@ -174,17 +512,15 @@ bool TempMonitor::updateCurMaxTemp()
 //    for this thread to finish. Also, any listener not returning immediatly
 //    will cause delays and interrupt processing of temperatures.
 //
-// {RISK_MITIGATION} Consider a seperate thread (e.g. async). However,
-//    care needs to be taken since, while the thread runs, a new max temp may be
-//    identified.
+// {RISK_MITIGATION} Listeners are called from their own ListenerDispatcher
+//    mailbox thread. This thread only overwrites each mailbox with the latest
+//    max temp; a listener that falls behind skips intermediate values.
+//
+// Params: trace - Newest traced sample applied since the last call, if any.
 //
-void TempMonitor::notifyNewMaxTemp()
+void TempMonitor::notifyNewMaxTemp(const SampleTrace& trace)
 {
-   const std::lock_guard<std::mutex> lock(listenersMux); 
-   for( auto listener : listeners )
-   {
-      listener->notifyNewMaxTemp(curMaxTemp);
-   }
+   listenerDispatcher.publish(curMaxTemp, trace);
 }
 
 //
@@ -198,12 +534,8 @@ GeneralConstants::ReturnCodes TempMonitor::registerListener(TempMonitorListener&
 {
    auto rVal{ GeneralConstants::ReturnCodes::TEMP_MONITOR_LISTENER_REG_FAILED };
 
-   const std::lock_guard<std::mutex> lock(listenersMux);
-
-   auto Itr{ std::find(listeners.begin(), listeners.end(), &listener) };
-   if (listeners.end() == Itr)
+   if( listenerDispatcher.add(listener) )
    {
-      listeners.push_back( &listener );
       rVal = GeneralConstants::ReturnCodes::SUCCESS;
    }
    return rVal;
@@ -219,22 +551,62 @@ GeneralConstants::ReturnCodes TempMonitor::registerListener(TempMonitorListener&
 GeneralConstants::ReturnCodes TempMonitor::unregisterListener(TempMonitorListener& listener)
 {
    auto rVal{ GeneralConstants::ReturnCodes::TEMP_MONITOR_LISTENER_UNREG_FAILED };
-   
-   const std::lock_guard<std::mutex> lock(listenersMux);
 
-   auto Itr{ std::find(listeners.begin(), listeners.end(), &listener) };
-   if (listeners.end() != Itr)
+   if( listenerDispatcher.remove(listener) )
    {
-      listeners.erase(Itr);
       rVal = GeneralConstants::ReturnCodes::SUCCESS;
    }
    return rVal;
 }
 
 //
-// Name: UpdateSubSystemTemp
+// Name: registerZoneListener
+//
+// Description: Adds a listener notified of the zone's new max temps.
+//
+// Params: zoneId - ThermalZone id (TempMonitorConfig::thermalZones).
+//         listener - Listener to add.
+//
+// Return: GeneralConstants::ReturnCodes - TEMP_MONITOR_LISTENER_REG_FAILED
+//       if the zone is unknown or the listener is already registered.
+//
+GeneralConstants::ReturnCodes TempMonitor::registerZoneListener(int zoneId, TempMonitorListener& listener)
+{
+   auto rVal{ GeneralConstants::ReturnCodes::TEMP_MONITOR_LISTENER_REG_FAILED };
+
+   auto zone{ findZone( zoneId ) };
+   if( (nullptr != zone) && zone->listeners->add(listener) )
+   {
+      rVal = GeneralConstants::ReturnCodes::SUCCESS;
+   }
+   return rVal;
+}
+
+//
+// Name: unregisterZoneListener
 //
-// Description: RPC Interface, allowing subsystems to send in their temperatures.
+// Description: Removes a listener added with registerZoneListener.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes TempMonitor::unregisterZoneListener(int zoneId, TempMonitorListener& listener)
+{
+   auto rVal{ GeneralConstants::ReturnCodes::TEMP_MONITOR_LISTENER_UNREG_FAILED };
+
+   auto zone{ findZone( zoneId ) };
+   if( (nullptr != zone) && zone->listeners->remove(listener) )
+   {
+      rVal = GeneralConstants::ReturnCodes::SUCCESS;
+   }
+   return rVal;
+}
+
+//
+// Name: submit
+//
+// Description: In-process ingestion. Hands a temperature to the tempThread
+//    exactly as the RPCs do, without the protobuf message or a socket.
+//    Thread safe; any number of producers may call it concurrently.
 //
 // {HAZARD}: Subsystem Id is not in the list provided. System may be improperly setup.
 //           Plan is needed to properly handle.
@@ -247,42 +619,427 @@ GeneralConstants::ReturnCodes TempMonitor::unregisterListener(TempMonitorListene
 //
 // {HAZARD_TODO}: Come up with plan. For now, will process request to prevent subsystem from overheating.
 //
-grpc::Status TempMonitor::UpdateSubSystemTemp( grpc::ServerContext* context, 
-                                               const TempMonitorSink::SubSysIdAndTemp* idTemp, 
-                                               TempMonitorSink::empty_param* noResponse )
+// Params: subSysId - Subsystem id.
+//         temp - Temperature.
+//         sampleTimeNs - When the temp was read (SampleTrace::nowNs), 0 if not traced.
+//         sequenceNum - The sender's sample sequence number, if traced.
+//
+// Return: GeneralConstants::ReturnCodes - TEMP_MONITOR_QUEUE_FULL if the ingestion
+//       ring is full and the overflowPolicy is REJECT, so the caller can back off and
+//       retry. In COALESCING mode samples from known subsystems overwrite their
+//       latestTemps slot instead and are never rejected.
+//
+GeneralConstants::ReturnCodes TempMonitor::submit( int subSysId, float temp, int64_t sampleTimeNs, uint64_t sequenceNum )
 {
-   DEBUG_STD_OUT( "TempMonitor::UpdateSubSystemTemp[" << idTemp->subsysid() << ", " << idTemp->temp() << "]" );
+   QueueElement element( subSysId, temp );
+   if( 0 != sampleTimeNs )
+   {
+      element.sequenceNum  = sequenceNum;
+      element.sampleTimeNs = sampleTimeNs;
+      element.ingestTimeNs = SampleTrace::nowNs();
+      latency.record( LatencyStage::SENSOR_TO_INGEST, element.sampleTimeNs, element.ingestTimeNs );
+   }
+
+   const auto slot{ subSystemSlots.find( subSysId ) };
+   if( SubSystemIndex::NOT_FOUND == slot )
+   {
+      // {HAZARD_TODO} Execute system-level logging. Rate limited per call site so a misbehaving sender cannot flood the log.
+      LOG_RATE_LIMITED( LogLevel::ERR, LOG_DEFAULT_RATE_LIMIT_MS, "TempMonitor::submit - ERROR: Received temp for an unknown SubSystemID ID:[{}], Temp[{}]", subSysId, temp );
+   }
+   else if( TempMonitorConfig::IngestionMode::COALESCING == config.ingestionMode )
+   {
+      if( latestTemps.store( slot, temp ) )
+      {
+         tempThreadSignal.notify();
+      }
+      return GeneralConstants::ReturnCodes::SUCCESS;
+   }
 
-   auto Itr { find(subSystemIds.begin(), subSystemIds.end(), idTemp->subsysid()) };
-   if( subSystemIds.end() == Itr )
+   auto rVal{ pushToQueue( &element, 1 ) };
+   if( GeneralConstants::ReturnCodes::SUCCESS == rVal )
    {
-      // {HAZARD_TODO} Execute system-level logging (Beware of flooding logs).
-      PRINT_STD_OUT( "TempMonitor::UpdateSubSystemTemp - ERROR: Received temp for an unknown SubSystemID ID:[" << idTemp->subsysid() << "], Temp[" << idTemp->temp() << "]");
+      tempThreadSignal.notify();
    }
+   return rVal;
+}
 
+//
+// Name: submit (batch)
+//
+// Description: In-process ingestion of many temperatures. The whole batch
+//    goes into the ring with a single tryPushBatch (or, in COALESCING mode,
+//    into the latestTemps slots) followed by a single wake-up of the
+//    tempThread. Thread safe.
+//
+// Note: Unknown subsystem ids are handled as in submit. In COALESCING mode
+//       only they go through the ring, so a full ring drops just those and
+//       the rest of the batch is still applied.
+//
+// Params: subSysIds - Subsystem ids.
+//         temps - temps[i] is the temperature of subSysIds[i].
+//         numDropped - Optional, set to the number of temps not taken.
+//
+// Return: GeneralConstants::ReturnCodes - TEMP_MONITOR_INVALID_BATCH if the id and
+//       temp counts differ, TEMP_MONITOR_QUEUE_FULL if the ring does not have room
+//       for the whole batch and the overflowPolicy is REJECT, or
+//       TEMP_MONITOR_BATCH_PARTIAL if only the temps meant for the ring were rejected.
+//
+GeneralConstants::ReturnCodes TempMonitor::submit( std::span<const int> subSysIds, std::span<const float> temps, size_t* numDropped )
+{
+   if( nullptr != numDropped )
    {
-      std::unique_lock<std::mutex> lock(tempThreadMux);
-      queue.push( QueueElement(idTemp->subsysid(), idTemp->temp()) );
-      tempThreadCond.notify_one();
+      *numDropped = 0;
    }
 
+   if( subSysIds.size() != temps.size() )
+   {
+      return GeneralConstants::ReturnCodes::TEMP_MONITOR_INVALID_BATCH;
+   }
+
+   // Per producer thread scratch space, so a batch does not allocate once warm.
+   thread_local std::vector<QueueElement> batch;
+   batch.clear();
+
+   auto signal{ false };
+   for( size_t idx{ 0 }; idx < subSysIds.size(); ++idx )
+   {
+      const auto subSysId{ subSysIds[idx] };
+      const auto temp{ temps[idx] };
+
+      const auto slot{ subSystemSlots.find( subSysId ) };
+      if( SubSystemIndex::NOT_FOUND == slot )
+      {
+         // {HAZARD_TODO} Execute system-level logging. Rate limited per call site so a misbehaving sender cannot flood the log.
+         LOG_RATE_LIMITED( LogLevel::ERR, LOG_DEFAULT_RATE_LIMIT_MS, "TempMonitor::submit - ERROR: Received batch temp for an unknown SubSystemID ID:[{}], Temp[{}]", subSysId, temp );
+      }
+      else if( TempMonitorConfig::IngestionMode::COALESCING == config.ingestionMode )
+      {
+         signal = latestTemps.store( slot, temp ) || signal;
+         continue;
+      }
+      batch.emplace_back( subSysId, temp );
+   }
+
+   auto rVal{ GeneralConstants::ReturnCodes::SUCCESS };
+   if( !batch.empty() )
+   {
+      rVal = pushToQueue( batch.data(), batch.size() );
+      if( GeneralConstants::ReturnCodes::SUCCESS == rVal )
+      {
+         signal = true;
+      }
+      else
+      {
+         if( batch.size() < subSysIds.size() )
+         {
+            // COALESCING: the known ids are already in latestTemps.
+            rVal = GeneralConstants::ReturnCodes::TEMP_MONITOR_BATCH_PARTIAL;
+         }
+         if( nullptr != numDropped )
+         {
+            *numDropped = batch.size();
+         }
+      }
+   }
+
+   if( signal )
+   {
+      tempThreadSignal.notify();
+   }
+   return rVal;
+}
+
+//
+// Name: toStatus
+//
+// Description: Maps a submit result onto the gRPC status the RPCs return.
+//
+// Params: rc - Result of submit.
+//
+// Return: grpc::Status
+//
+grpc::Status TempMonitor::toStatus( GeneralConstants::ReturnCodes rc )
+{
+   switch( rc )
+   {
+   case GeneralConstants::ReturnCodes::SUCCESS:
+      return grpc::Status::OK;
+   case GeneralConstants::ReturnCodes::TEMP_MONITOR_QUEUE_FULL:
+   case GeneralConstants::ReturnCodes::TEMP_MONITOR_BATCH_PARTIAL:
+      return grpc::Status( grpc::StatusCode::RESOURCE_EXHAUSTED, GeneralConstants::ReturnCodesStrings.at( rc ) );
+   case GeneralConstants::ReturnCodes::TEMP_MONITOR_INVALID_BATCH:
+      return grpc::Status( grpc::StatusCode::INVALID_ARGUMENT, GeneralConstants::ReturnCodesStrings.at( rc ) );
+   default:
+      return grpc::Status( grpc::StatusCode::UNKNOWN, GeneralConstants::ReturnCodesStrings.at( rc ) );
+   }
+}
+
+//
+// Name: ingestTemp
+//
+// Description: Adapter from a temperature received by any of the RPCs to submit.
+//
+// Params: idTemp - Subsystem id, temperature and, if traced, sample time and
+//             sequence number.
+//
+// Return: grpc::Status - See toStatus.
+//
+grpc::Status TempMonitor::ingestTemp( const TempMonitorSink::SubSysIdAndTemp& idTemp )
+{
+   return toStatus( submit( idTemp.subsysid(), idTemp.temp(),
+                            static_cast<int64_t>( idTemp.sampletimens() ), idTemp.sequencenum() ) );
+}
+
+//
+// Name: pushToQueue
+//
+// Description: Pushes count contiguous elements into the ingestion ring,
+//    applying config.overflowPolicy when it is full. Batches stay
+//    all or nothing, so a batch is never split by a concurrent push.
+//
+// Params: elements - Pointer to count elements.
+//         count - Number of elements.
+//
+// Return: GeneralConstants::ReturnCodes - TEMP_MONITOR_QUEUE_FULL if the ring is
+//       full and the policy is REJECT, SUCCESS otherwise (including when samples
+//       were dropped).
+//
+GeneralConstants::ReturnCodes TempMonitor::pushToQueue( const QueueElement* elements, size_t count )
+{
+   auto rVal{ GeneralConstants::ReturnCodes::SUCCESS };
+   const auto capacity{ queue.getCapacity() };
+
+   if( TempMonitorConfig::OverflowPolicy::DROP_OLDEST == config.overflowPolicy )
+   {
+      // A batch larger than the ring keeps its newest capacity elements.
+      const auto skipped{ (count > capacity) ? (count - capacity) : 0 };
+      const auto evicted{ (1 == count) ? queue.pushEvictOldest( *elements )
+                                       : queue.pushBatchEvictOldest( elements + skipped, count - skipped ) };
+      if( 0 != (evicted + skipped) )
+      {
+         droppedOldestTemps.fetch_add( evicted + skipped, std::memory_order_relaxed );
+         notePeakQueueDepth( capacity );
+      }
+   }
+   else if( !((1 == count) ? queue.tryPush( *elements ) : queue.tryPushBatch( elements, count )) )
+   {
+      notePeakQueueDepth( capacity );
+      if( TempMonitorConfig::OverflowPolicy::DROP_NEWEST == config.overflowPolicy )
+      {
+         droppedNewestTemps.fetch_add( count, std::memory_order_relaxed );
+      }
+      else
+      {
+         rejectedTemps.fetch_add( count, std::memory_order_relaxed );
+         rVal = GeneralConstants::ReturnCodes::TEMP_MONITOR_QUEUE_FULL;
+      }
+   }
+   return rVal;
+}
+
+//
+// Name: notePeakQueueDepth
+//
+// Description: Raises the recorded peak queue depth to depth.
+//
+void TempMonitor::notePeakQueueDepth( size_t depth )
+{
+   auto peak{ peakQueueDepth.load( std::memory_order_relaxed ) };
+   while( (depth > peak) && !peakQueueDepth.compare_exchange_weak( peak, depth, std::memory_order_relaxed ) )
+   {
+      // Retry with the updated peak.
+   }
+}
+
+//
+// Name: checkQueueDepth
+//
+// Description: tempThread only. Records the peak depth and counts every
+//    upward crossing of the low/high watermarks. Warnings are logged at
+//    most once per config.watermarkLogIntervalMs so a queue hovering around
+//    a watermark cannot flood the logs.
+//
+// Params: depth - Current (approximate) queue depth.
+//
+void TempMonitor::checkQueueDepth( size_t depth )
+{
+   notePeakQueueDepth( depth );
+
+   const size_t level{ (depth >= highWatermark) ? 2u : ((depth >= lowWatermark) ? 1u : 0u) };
+   if( level > watermarkLevel )
+   {
+      watermarkEvents.fetch_add( 1, std::memory_order_relaxed );
+
+      const auto now{ std::chrono::steady_clock::now() };
+      if( (now - lastWatermarkLog) >= std::chrono::milliseconds( config.watermarkLogIntervalMs ) )
+      {
+         lastWatermarkLog = now;
+         // {HAZARD_TODO} Execute system-level logging.
+         if( 2 == level )
+         {
+            LOG_WARN( "TempMonitor::checkQueueDepth - WARNING: Ingestion queue depth[{}/{}] crossed the high watermark.", depth, queue.getCapacity() );
+         }
+         else
+         {
+            LOG_WARN( "TempMonitor::checkQueueDepth - WARNING: Ingestion queue depth[{}/{}] crossed the low watermark.", depth, queue.getCapacity() );
+         }
+      }
+   }
+   watermarkLevel = level;
+}
+
+//
+// Name: getQueueStats
+//
+// Description: Snapshot of the ingestion queue counters. Counters are
+//    read individually, so they may be mutually inconsistent under load.
+//
+// Return: TempMonitor::QueueStats
+//
+TempMonitor::QueueStats TempMonitor::getQueueStats() const
+{
+   QueueStats rVal;
+   rVal.capacity        = queue.getCapacity();
+   rVal.depth           = queue.size();
+   rVal.peakDepth       = peakQueueDepth.load( std::memory_order_relaxed );
+   rVal.rejected        = rejectedTemps.load( std::memory_order_relaxed );
+   rVal.droppedNewest   = droppedNewestTemps.load( std::memory_order_relaxed );
+   rVal.droppedOldest   = droppedOldestTemps.load( std::memory_order_relaxed );
+   rVal.watermarkEvents = watermarkEvents.load( std::memory_order_relaxed );
+   return rVal;
+}
+
+//
+// Name: UpdateSubSystemTemp
+//
+// Description: RPC Interface, allowing subsystems to send in their temperatures,
+//    one RPC per temperature.
+//
+grpc::Status TempMonitor::UpdateSubSystemTemp( grpc::ServerContext* /*context*/, 
+                                               const TempMonitorSink::SubSysIdAndTemp* idTemp, 
+                                               TempMonitorSink::empty_param* /*noResponse*/ )
+{
+   LOG_DEBUG( "TempMonitor::UpdateSubSystemTemp[{}, {}]", idTemp->subsysid(), idTemp->temp() );
+
+   return ingestTemp( *idTemp );
+}
+
+//
+// Name: StreamSubSystemTemps
+//
+// Description: RPC Interface, client-streaming. A subsystem keeps one stream
+//    open and writes a message per temperature, avoiding a ClientContext,
+//    HTTP/2 stream and round trip per sample. Runs until the client
+//    calls WritesDone or the server shuts down.
+//
+// Note: A rejected sample cannot be reported mid-stream. Rejections are counted
+//       and reported as RESOURCE_EXHAUSTED when the stream closes; later samples
+//       supersede the dropped ones.
+//
+grpc::Status TempMonitor::StreamSubSystemTemps( grpc::ServerContext* /*context*/,
+                                                grpc::ServerReader<TempMonitorSink::SubSysIdAndTemp>* reader,
+                                                TempMonitorSink::empty_param* /*noResponse*/ )
+{
+   TempMonitorSink::SubSysIdAndTemp idTemp;
+   size_t rejected{ 0 };
+
+   while( reader->Read( &idTemp ) )
+   {
+      if( !ingestTemp( idTemp ).ok() )
+      {
+         ++rejected;
+      }
+   }
+
+   if( 0 != rejected )
+   {
+      return grpc::Status( grpc::StatusCode::RESOURCE_EXHAUSTED,
+                           "TempMonitor ingestion queue was full, " + std::to_string(rejected) + " samples dropped." );
+   }
    return grpc::Status::OK;
 }
 
+//
+// Name: ingestTempBatch
+//
+// Description: Adapter from a batch RPC to the batch submit. The repeated
+//    fields are passed as spans over the message, without copying.
+//
+// Params: idsTemps - Subsystem ids and their temperatures.
+//
+// Return: grpc::Status - See toStatus. A partly applied batch is reported as
+//       RESOURCE_EXHAUSTED with the number of samples dropped, as the
+//       stream does.
+//
+grpc::Status TempMonitor::ingestTempBatch( const TempMonitorSink::SubSysIdsAndTemps& idsTemps )
+{
+   size_t dropped{ 0 };
+   const auto rc{ submit( std::span<const int>( idsTemps.subsysids().data(), static_cast<size_t>( idsTemps.subsysids_size() ) ),
+                          std::span<const float>( idsTemps.temps().data(), static_cast<size_t>( idsTemps.temps_size() ) ),
+                          &dropped ) };
+
+   if( GeneralConstants::ReturnCodes::TEMP_MONITOR_BATCH_PARTIAL == rc )
+   {
+      return grpc::Status( grpc::StatusCode::RESOURCE_EXHAUSTED,
+                           "TempMonitor ingestion queue was full, " + std::to_string(dropped) + " of " +
+                           std::to_string(idsTemps.subsysids_size()) + " samples dropped." );
+   }
+   return toStatus( rc );
+}
+
+//
+// Name: UpdateSubSystemTempsBatch
+//
+// Description: RPC Interface, allowing a board controller to send the
+//    temperatures of many subsystems in one RPC.
+//
+grpc::Status TempMonitor::UpdateSubSystemTempsBatch( grpc::ServerContext* /*context*/,
+                                                     const TempMonitorSink::SubSysIdsAndTemps* idsTemps,
+                                                     TempMonitorSink::empty_param* /*noResponse*/ )
+{
+   LOG_DEBUG( "TempMonitor::UpdateSubSystemTempsBatch[{}]", idsTemps->subsysids_size() );
+
+   return ingestTempBatch( *idsTemps );
+}
+
 //
 // Name: RunServer
 //
-// Description: Creates and starts the gRPC server.
+// Description: Creates and starts the gRPC server. In SYNC mode this
+//    TempMonitor is registered as the service; in ASYNC mode the
+//    TempMonitorAsyncServer owns the service and completion queues. In NONE
+//    mode no server is started; temps only arrive through submit().
 //
 // {HAZARD_TODO} Setup server credentials. For this exercise, server is using simple insecure credentials. 
 //
-void TempMonitor::RunServer()
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes TempMonitor::RunServer()
 {
-   builder.AddListeningPort(GeneralConstants::GRPC_SERVER_ADDRESS, grpc::InsecureServerCredentials());
+   auto rVal{ GeneralConstants::ReturnCodes::TEMP_MONITOR_INIT_FAILED };
+
+   if( TempMonitorConfig::ServerMode::NONE == config.serverMode )
+   {
+      rVal = GeneralConstants::ReturnCodes::SUCCESS;
+   }
+   else if( TempMonitorConfig::ServerMode::ASYNC == config.serverMode )
+   {
+      asyncServer = std::make_unique<TempMonitorAsyncServer>( *this, config );
+      rVal = asyncServer->start();
+   }
+   else
+   {
+      builder.AddListeningPort(GeneralConstants::GRPC_SERVER_ADDRESS, grpc::InsecureServerCredentials());
 
-   builder.RegisterService(this);
+      builder.RegisterService(this);
 
-   server = builder.BuildAndStart();
-   
-   DEBUG_STD_OUT( "TempMonitor::RunServer() - Server listening on " << GeneralConstants::GRPC_SERVER_ADDRESS );
+      server = builder.BuildAndStart();
+      if( nullptr != server )
+      {
+         rVal = GeneralConstants::ReturnCodes::SUCCESS;
+      }
+
+      DEBUG_STD_OUT( "TempMonitor::RunServer() - Server listening on " << GeneralConstants::GRPC_SERVER_ADDRESS );
+   }
+   return rVal;
 }
\ No newline at end of file
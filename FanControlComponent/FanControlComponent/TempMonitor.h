@@ -2,76 +2,208 @@
 * Class: TempMonitor
 *
 * Description: Reponsible for receiving temperatures from multiple subsystems
-*     asynchronously. It makes use of a double buffer (with a queue as the buffer)
-*     to allow the draining of one buffer while the second buffer is being filled.
+*     asynchronously. Producers in the same process (e.g. sensor drivers) call
+*     submit() directly, without protobuf or a socket; the gRPC handlers are
+*     thin adapters over it. Both push samples into a lock-free,
+*     fixed capacity MPSC ring which is drained by the tempThread. The tempThread
+*     only sleeps (via an EventCount) when the ring is empty. When the ring is
+*     full the configured OverflowPolicy rejects the RPC or drops the newest or
+*     oldest samples; depth watermarks and drop counts are exposed through
+*     getQueueStats().
+*
+*     In COALESCING ingestion mode, samples from known subsystems bypass the
+*     ring and overwrite that subsystem's slot in a CoalescingTempTable. The
+*     tempThread sweeps the dirty slots and recomputes the max once per sweep.
+*
+*     In ASYNC server mode the RPCs are served from completion queues by a
+*     TempMonitorAsyncServer instead of gRPC's sync thread pool. In NONE
+*     server mode there is no gRPC server and submit() is the only input.
+*
+*     Sensor daemons on the same host can instead write their temps into a
+*     SharedTempTable (TempMonitorConfig::sharedTableName). The
+*     sharedTableThread polls it, sleeping on its futex when nothing
+*     changed, and submits the temps, alongside any server mode.
 * 
 *     It is also responsible for monitoring the max temp across all subsystems.
 *     When a new max temp is identified, it will notify all the listeners of the 
-*     the new max temp value.
+*     the new max temp value. Listeners are called from their own
+*     ListenerDispatcher thread, never from the tempThread.
+*
+*     Configured ThermalZones get a MaxTempTracker and ListenerDispatcher of
+*     their own. Every temp update is applied to the zones its subsystem
+*     belongs to, and a zone's listeners (registerZoneListener) are notified
+*     only when that zone's max changes.
+*
+*     Samples carrying a SampleTimeNs are traced: the latency of every stage
+*     they go through, up to the fan register write, is recorded in the
+*     LatencyRecorder (getLatencyRecorder). In COALESCING mode the trace of
+*     samples from known subsystems ends at ingestion.
 *
 */
 
 #pragma once
 #include "TempMonitorListener.h"
+#include "TempMonitorConfig.h"
 #include "GeneralConstants.h"
+#include "MpscRingBuffer.h"
+#include "SharedTempTable.h"
+#include "EventCount.h"
+#include "CoalescingTempTable.h"
+#include "MaxTempTracker.h"
+#include "SubSystemIndex.h"
+#include "ListenerDispatcher.h"
+#include "LatencyRecorder.h"
 
-#include <unordered_map>   // LUT of SS & Temps
-#include <set>             // Order set of temps.
-#include <vector>          // Listeners list.
-#include <queue>           // {TECH_DEBT} Would be better to use a circular buffer with re-usable elements.
-#include <mutex>
+#include <unordered_map>   // LUT of unknown SS & slots
+#include <vector>
 #include <atomic>
 #include <thread>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
 
 #include <grpcpp/grpcpp.h>
 #include "TempMonitor.grpc.pb.h"
 
+class TempMonitorAsyncServer;
+
 class TempMonitor final : public TempMonitorSink::TempMonitorServer::Service
 {
+   friend class TempMonitorAsyncServer;
+   friend struct TempMonitorBenchAccess; // Benchmarks of the tempThread steps.
+
    struct QueueElement
    {
-      int   subSysId{ INT_MIN };
-      float temp{ 0.0f };
+      int      subSysId{ INT_MIN };
+      float    temp{ 0.0f };
+      uint64_t sequenceNum{ 0 };
+      int64_t  sampleTimeNs{ 0 };  // 0 if the sample is not traced.
+      int64_t  ingestTimeNs{ 0 };
 
       QueueElement() {};
       QueueElement(int ssid, float t) : subSysId(ssid), temp(t) {};
    };
 
+   const TempMonitorConfig        config;
    const std::vector<int>         subSystemIds;
-   std::unordered_map<int, float> subSystemTemps;
-   std::multiset<float>           curTemps;
-   std::queue<QueueElement>       queue;
+   MpscRingBuffer<QueueElement>   queue;
+
+   const SubSystemIndex            subSystemSlots;        // SS Id -> slot (latestTemps & maxTemps).
+   std::unordered_map<int, size_t> unknownSubSystemSlots; // tempThread only: unknown SS Id -> maxTemps slot.
+   CoalescingTempTable             latestTemps;
+   MaxTempTracker                  maxTemps;
                                      
    float                          curMaxTemp{ 0.0 };
+
+   struct Zone
+   {
+      int                                 zoneId{ 0 };
+      MaxTempTracker                      maxTemps;            // tempThread only.
+      float                               curMaxTemp{ 0.0f };  // tempThread only.
+      bool                                dirty{ false };      // tempThread only.
+      std::unique_ptr<ListenerDispatcher> listeners;
+
+      Zone(int id, size_t numSlots)
+         : zoneId(id)
+         , maxTemps(numSlots)
+         , listeners(std::make_unique<ListenerDispatcher>())
+      {}
+   };
+
+   struct ZoneMember
+   {
+      size_t zone{ 0 };
+      size_t zoneSlot{ 0 };
+   };
+
+   std::vector<Zone>       zones;
+   std::vector<size_t>     zoneMemberOffsets; // Known slot -> [offsets[slot], offsets[slot + 1]) of zoneMembers.
+   std::vector<ZoneMember> zoneMembers;
+   std::vector<size_t>     dirtyZones;        // tempThread only.
+
+   const size_t                          lowWatermark;          // Queue depth, elements.
+   const size_t                          highWatermark;         // Queue depth, elements.
+   size_t                                watermarkLevel{ 0 };   // tempThread only: 0 below low, 1 low, 2 high.
+   std::chrono::steady_clock::time_point lastWatermarkLog{};    // tempThread only.
+   std::atomic<size_t>                   peakQueueDepth{ 0 };
+   std::atomic<uint64_t>                 rejectedTemps{ 0 };
+   std::atomic<uint64_t>                 droppedNewestTemps{ 0 };
+   std::atomic<uint64_t>                 droppedOldestTemps{ 0 };
+   std::atomic<uint64_t>                 watermarkEvents{ 0 };
                                      
    std::thread             tempThread;
-   std::condition_variable tempThreadCond;
-   std::mutex              tempThreadMux;
+   EventCount              tempThreadSignal;
    std::atomic<bool>       tempThreadKeepAlive{ false };
 
-   std::vector<TempMonitorListener*> listeners;
-   std::mutex                        listenersMux;
+   ListenerDispatcher                listenerDispatcher;
+   LatencyRecorder                   latency;
   
    bool updateCurMaxTemp();
-   void notifyNewMaxTemp();
-   void updateTempTables(const std::pair<int,float>& newTemp );
-   void updateCurTemps(QueueElement& tempData);
+   void notifyNewMaxTemp(const SampleTrace& trace);
+   void updateTempTables(size_t slot, float temp);
+   void updateZoneTables(size_t slot, float temp);
+   void notifyZoneMaxTemps(const SampleTrace& trace);
+   bool checkThermalZones() const;
+   Zone* findZone(int zoneId);
+   size_t getTempSlot(int subSysId);
+   bool drainQueue();
+   bool sweepLatestTemps();
+   bool hasPendingTemps() const;
+   void checkQueueDepth(size_t depth);
+   void notePeakQueueDepth(size_t depth);
 
    void updateTempsThread();
 
-   grpc::ServerBuilder           builder;
-   std::unique_ptr<grpc::Server> server;
+   std::unique_ptr<SharedTempTable> sharedTable;  // sharedTableName only.
+   std::thread                      sharedTableThread;
+   std::atomic<bool>                sharedTableKeepAlive{ false };
 
+   GeneralConstants::ReturnCodes openSharedTable();
+   void pollSharedTableThread();
+
+   grpc::ServerBuilder                     builder;
+   std::unique_ptr<grpc::Server>           server;
+   std::unique_ptr<TempMonitorAsyncServer> asyncServer; // ServerMode::ASYNC only.
+
+   GeneralConstants::ReturnCodes pushToQueue(const QueueElement* elements, size_t count);
+   static grpc::Status toStatus(GeneralConstants::ReturnCodes rc);
+   grpc::Status ingestTemp(const TempMonitorSink::SubSysIdAndTemp& idTemp);
+   grpc::Status ingestTempBatch(const TempMonitorSink::SubSysIdsAndTemps& idsTemps);
    grpc::Status UpdateSubSystemTemp(grpc::ServerContext* context, const TempMonitorSink::SubSysIdAndTemp* idTemp, TempMonitorSink::empty_param* noResponse) override;
-   void RunServer();
+   grpc::Status StreamSubSystemTemps(grpc::ServerContext* context, grpc::ServerReader<TempMonitorSink::SubSysIdAndTemp>* reader, TempMonitorSink::empty_param* noResponse) override;
+   grpc::Status UpdateSubSystemTempsBatch(grpc::ServerContext* context, const TempMonitorSink::SubSysIdsAndTemps* idsTemps, TempMonitorSink::empty_param* noResponse) override;
+   GeneralConstants::ReturnCodes RunServer();
 
 public:
-   TempMonitor( const std::vector<int>& subSystemIds );
+   struct QueueStats
+   {
+      size_t   capacity{ 0 };
+      size_t   depth{ 0 };            // Approximate.
+      size_t   peakDepth{ 0 };
+      uint64_t rejected{ 0 };         // OverflowPolicy::REJECT
+      uint64_t droppedNewest{ 0 };    // OverflowPolicy::DROP_NEWEST
+      uint64_t droppedOldest{ 0 };    // OverflowPolicy::DROP_OLDEST
+      uint64_t watermarkEvents{ 0 };  // Upward crossings of either watermark.
+   };
+
+   TempMonitor( const std::vector<int>& subSystemIds, const TempMonitorConfig& config = TempMonitorConfig() );
    ~TempMonitor();
 
    GeneralConstants::ReturnCodes initialize();
 
+   GeneralConstants::ReturnCodes submit(int subSysId, float temp, int64_t sampleTimeNs = 0, uint64_t sequenceNum = 0);
+   GeneralConstants::ReturnCodes submit(std::span<const int> subSysIds, std::span<const float> temps, size_t* numDropped = nullptr);
+
    GeneralConstants::ReturnCodes registerListener(TempMonitorListener& listener);
    GeneralConstants::ReturnCodes unregisterListener(TempMonitorListener& listener);
+
+   GeneralConstants::ReturnCodes registerZoneListener(int zoneId, TempMonitorListener& listener);
+   GeneralConstants::ReturnCodes unregisterZoneListener(int zoneId, TempMonitorListener& listener);
+
+   QueueStats getQueueStats() const;
+
+   LatencyRecorder& getLatencyRecorder() { return latency; }
+   const LatencyRecorder& getLatencyRecorder() const { return latency; }
 };
 
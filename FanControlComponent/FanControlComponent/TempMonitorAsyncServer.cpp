@@ -0,0 +1,382 @@
+#include "TempMonitorAsyncServer.h"
+#include "TempMonitor.h"
+#include "log.h"
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+//
+// Name: Call
+//
+// Description: Base for the per-RPC state machines. The call object itself
+//    is the completion queue tag, and each call has at most one operation
+//    outstanding at any time.
+//
+class TempMonitorAsyncServer::Call
+{
+protected:
+   TempMonitorAsyncServer&            owner;
+   PollingQueue&                      queue;
+   std::optional<grpc::ServerContext> context;
+
+public:
+   Call(TempMonitorAsyncServer& server, PollingQueue& pollingQueue)
+      : owner(server)
+      , queue(pollingQueue)
+   {}
+   virtual ~Call() {};
+
+   //
+   // Name: arm
+   //
+   // Description: Asks gRPC for the next incoming RPC of this kind.
+   //
+   virtual void arm() = 0;
+
+   //
+   // Name: proceed
+   //
+   // Description: Advances the state machine after the outstanding
+   //    operation completed. Called with the queue mux held.
+   //
+   // Params: ok - Completion queue result of the operation.
+   //
+   // Return: bool - False if the call is done and should be deleted.
+   //
+   virtual bool proceed(bool ok) = 0;
+};
+
+//
+// Name: UnaryCall
+//
+// Description: UpdateSubSystemTemp. Re-armed after every RPC.
+//
+class TempMonitorAsyncServer::UnaryCall final : public Call
+{
+   TempMonitorSink::SubSysIdAndTemp request;
+   TempMonitorSink::empty_param     response;
+   std::optional<grpc::ServerAsyncResponseWriter<TempMonitorSink::empty_param>> responder;
+   bool finishing{ false };
+
+public:
+   using Call::Call;
+
+   void arm() override
+   {
+      responder.reset();
+      context.emplace();
+      responder.emplace(&*context);
+      finishing = false;
+      owner.service.RequestUpdateSubSystemTemp(&*context, &request, &*responder, queue.cq.get(), queue.cq.get(), this);
+   }
+
+   bool proceed(bool ok) override
+   {
+      auto rVal{ true };
+
+      if (finishing)
+      {
+         arm();
+      }
+      else if (ok)
+      {
+         finishing = true;
+         responder->Finish(response, owner.ingestTemp(request), this);
+      }
+      else
+      {
+         rVal = false; // Server is shutting down.
+      }
+      return rVal;
+   }
+};
+
+//
+// Name: BatchCall
+//
+// Description: UpdateSubSystemTempsBatch. Re-armed after every RPC.
+//
+class TempMonitorAsyncServer::BatchCall final : public Call
+{
+   TempMonitorSink::SubSysIdsAndTemps request;
+   TempMonitorSink::empty_param       response;
+   std::optional<grpc::ServerAsyncResponseWriter<TempMonitorSink::empty_param>> responder;
+   bool finishing{ false };
+
+public:
+   using Call::Call;
+
+   void arm() override
+   {
+      responder.reset();
+      context.emplace();
+      responder.emplace(&*context);
+      finishing = false;
+      owner.service.RequestUpdateSubSystemTempsBatch(&*context, &request, &*responder, queue.cq.get(), queue.cq.get(), this);
+   }
+
+   bool proceed(bool ok) override
+   {
+      auto rVal{ true };
+
+      if (finishing)
+      {
+         arm();
+      }
+      else if (ok)
+      {
+         finishing = true;
+         responder->Finish(response, owner.ingestTempBatch(request), this);
+      }
+      else
+      {
+         rVal = false; // Server is shutting down.
+      }
+      return rVal;
+   }
+};
+
+//
+// Name: StreamCall
+//
+// Description: StreamSubSystemTemps. When a stream starts, a replacement call
+//    is armed so new streams can still be accepted; this call reads until the
+//    client half-closes and is then deleted.
+//
+class TempMonitorAsyncServer::StreamCall final : public Call
+{
+   enum class State
+   {
+        REQUESTED
+      , READING
+      , FINISHING
+   };
+
+   TempMonitorSink::SubSysIdAndTemp request;
+   TempMonitorSink::empty_param     response;
+   std::optional<grpc::ServerAsyncReader<TempMonitorSink::empty_param, TempMonitorSink::SubSysIdAndTemp>> reader;
+   State  state{ State::REQUESTED };
+   size_t rejected{ 0 };
+
+public:
+   using Call::Call;
+
+   void arm() override
+   {
+      context.emplace();
+      reader.emplace(&*context);
+      owner.service.RequestStreamSubSystemTemps(&*context, &*reader, queue.cq.get(), queue.cq.get(), this);
+   }
+
+   bool proceed(bool ok) override
+   {
+      auto rVal{ true };
+
+      switch (state)
+      {
+      case State::REQUESTED:
+      {
+         if (!ok)
+         {
+            rVal = false;
+            break;
+         }
+         (new StreamCall(owner, queue))->arm();
+         state = State::READING;
+         reader->Read(&request, this);
+         break;
+      }
+      case State::READING:
+      {
+         if (ok)
+         {
+            if (!owner.ingestTemp(request).ok())
+            {
+               ++rejected;
+            }
+            reader->Read(&request, this);
+            break;
+         }
+
+         // Client half-closed the stream.
+         state = State::FINISHING;
+         if (0 != rejected)
+         {
+            reader->Finish(response, grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+               "TempMonitor ingestion queue was full, " + std::to_string(rejected) + " samples dropped."), this);
+         }
+         else
+         {
+            reader->Finish(response, grpc::Status::OK, this);
+         }
+         break;
+      }
+      case State::FINISHING: // Fallthrough
+      default:
+         rVal = false;
+         break;
+      }
+
+      return rVal;
+   }
+};
+
+//
+// Name: TempMonitorAsyncServer (ctor)
+//
+// Params: tempMonitor - TempMonitor that receives the temps.
+//         cfg - Polling thread and call pool sizes.
+//
+TempMonitorAsyncServer::TempMonitorAsyncServer(TempMonitor& tempMonitor, const TempMonitorConfig& cfg)
+   : monitor(tempMonitor)
+   , config(cfg)
+{
+   // Empty
+}
+
+//
+// Name: ~TempMonitorAsyncServer (dtor)
+//
+TempMonitorAsyncServer::~TempMonitorAsyncServer()
+{
+   shutdown();
+}
+
+//
+// Name: start
+//
+// Description: Builds the server with one completion queue per polling
+//    thread, arms the call pools and starts the polling threads.
+//
+// {HAZARD_TODO} Setup server credentials. For this exercise, server is using simple insecure credentials.
+//
+// Return: GeneralConstants::ReturnCodes
+//
+GeneralConstants::ReturnCodes TempMonitorAsyncServer::start()
+{
+   auto rVal{ GeneralConstants::ReturnCodes::TEMP_MONITOR_INIT_FAILED };
+
+   builder.AddListeningPort(GeneralConstants::GRPC_SERVER_ADDRESS, grpc::InsecureServerCredentials());
+   builder.RegisterService(&service);
+
+   const auto numQueues{ (0 == config.asyncPollingThreads) ? size_t{ 1 } : config.asyncPollingThreads };
+   for (size_t idx{ 0 }; idx < numQueues; ++idx)
+   {
+      queues.push_back(std::make_unique<PollingQueue>());
+      queues.back()->cq = builder.AddCompletionQueue();
+   }
+
+   server = builder.BuildAndStart();
+   if (nullptr != server)
+   {
+      for (auto& queue : queues)
+      {
+         for (size_t idx{ 0 }; idx < config.asyncCallsPerQueue; ++idx)
+         {
+            (new UnaryCall(*this, *queue))->arm();
+            (new StreamCall(*this, *queue))->arm();
+            (new BatchCall(*this, *queue))->arm();
+         }
+         queue->thread = std::thread(&TempMonitorAsyncServer::pollingThread, this, std::ref(*queue));
+      }
+      rVal = GeneralConstants::ReturnCodes::SUCCESS;
+   }
+
+   DEBUG_STD_OUT("TempMonitorAsyncServer::start() - Server listening on " << GeneralConstants::GRPC_SERVER_ADDRESS << ", queues[" << numQueues << "]");
+   return rVal;
+}
+
+//
+// Name: shutdown
+//
+// Description: Stops the server (in-flight streams are cancelled after
+//    GRPC_SERVER_SHUTDOWN_DEADLINE_MS), then shuts down and drains every
+//    completion queue, deleting the call objects as their last tag comes out.
+//
+void TempMonitorAsyncServer::shutdown()
+{
+   if (nullptr != server)
+   {
+      server->Shutdown(std::chrono::system_clock::now() + std::chrono::milliseconds(GeneralConstants::GRPC_SERVER_SHUTDOWN_DEADLINE_MS));
+   }
+
+   for (auto& queue : queues)
+   {
+      {
+         const std::lock_guard<std::mutex> lock(queue->mux);
+         queue->shuttingDown = true;
+      }
+      queue->cq->Shutdown();
+   }
+
+   for (auto& queue : queues)
+   {
+      if (queue->thread.joinable())
+      {
+         queue->thread.join();
+      }
+      else
+      {
+         pollingThread(*queue); // start() failed before the thread was created, drain here.
+      }
+   }
+
+   server.reset();
+   queues.clear();
+}
+
+//
+// Name: pollingThread
+//
+// Description: Drains one completion queue until it is shut down and empty.
+//    Once shutdown has started no new operations may be started on the queue,
+//    so calls are deleted instead of advanced.
+//
+// Params: queue - The completion queue (and its guard) owned by this thread.
+//
+void TempMonitorAsyncServer::pollingThread(PollingQueue& queue)
+{
+   void* tag{ nullptr };
+   bool  ok{ false };
+
+   while (queue.cq->Next(&tag, &ok))
+   {
+      auto call{ static_cast<Call*>(tag) };
+
+      const std::lock_guard<std::mutex> lock(queue.mux);
+      if (queue.shuttingDown || !call->proceed(ok))
+      {
+         delete call;
+      }
+   }
+}
+
+//
+// Name: ingestTemp
+//
+// Description: Forwards a temp received by a call to the TempMonitor. Called
+//    from the polling threads, the calls only know the server.
+//
+// Params: idTemp - Subsystem id and temperature from the request.
+//
+// Return: grpc::Status - Status to finish the call with, see TempMonitor::ingestTemp.
+//
+grpc::Status TempMonitorAsyncServer::ingestTemp(const TempMonitorSink::SubSysIdAndTemp& idTemp)
+{
+   return monitor.ingestTemp(idTemp);
+}
+
+//
+// Name: ingestTempBatch
+//
+// Description: Forwards a batch received by a call to the TempMonitor.
+//
+// Params: idsTemps - Subsystem ids and their temperatures from the request.
+//
+// Return: grpc::Status - Status to finish the call with, see TempMonitor::ingestTempBatch.
+//
+grpc::Status TempMonitorAsyncServer::ingestTempBatch(const TempMonitorSink::SubSysIdsAndTemps& idsTemps)
+{
+   return monitor.ingestTempBatch(idsTemps);
+}
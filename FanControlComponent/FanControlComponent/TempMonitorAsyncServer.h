@@ -0,0 +1,72 @@
+/*
+* Class: TempMonitorAsyncServer
+*
+* Description: Completion queue based gRPC server for the TempMonitor
+*     (TempMonitorConfig::ServerMode::ASYNC). A fixed number of polling
+*     threads each drain their own ServerCompletionQueue, and every queue has
+*     a preallocated set of call objects armed for each RPC. Thread count is
+*     therefore independent of the number of connected subsystems or
+*     in-flight RPCs.
+*
+*     Unary and batch call objects are re-armed after each RPC. A streaming
+*     call arms a replacement when its stream starts and is freed when the
+*     stream ends, so the number of concurrent streams is not capped.
+*
+*     Samples are handed to the TempMonitor through the same ingest helpers
+*     as the sync handlers.
+*
+*/
+
+#pragma once
+
+#include "GeneralConstants.h"
+#include "TempMonitorConfig.h"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+#include "TempMonitor.grpc.pb.h"
+
+class TempMonitor;
+
+class TempMonitorAsyncServer final
+{
+   class Call;
+   class UnaryCall;
+   class StreamCall;
+   class BatchCall;
+
+   struct PollingQueue
+   {
+      std::unique_ptr<grpc::ServerCompletionQueue> cq;
+      std::mutex                                   mux;          // Held while a call starts a new operation.
+      bool                                         shuttingDown{ false };
+      std::thread                                  thread;
+   };
+
+   TempMonitor&            monitor;
+   const TempMonitorConfig config;
+
+   TempMonitorSink::TempMonitorServer::AsyncService service;
+   grpc::ServerBuilder                              builder;
+   std::unique_ptr<grpc::Server>                    server;
+   std::vector<std::unique_ptr<PollingQueue>>       queues;
+
+   void pollingThread(PollingQueue& queue);
+
+   grpc::Status ingestTemp(const TempMonitorSink::SubSysIdAndTemp& idTemp);
+   grpc::Status ingestTempBatch(const TempMonitorSink::SubSysIdsAndTemps& idsTemps);
+
+public:
+   TempMonitorAsyncServer(TempMonitor& monitor, const TempMonitorConfig& config);
+   ~TempMonitorAsyncServer();
+
+   TempMonitorAsyncServer(const TempMonitorAsyncServer&) = delete;
+   TempMonitorAsyncServer& operator=(const TempMonitorAsyncServer&) = delete;
+
+   GeneralConstants::ReturnCodes start();
+   void shutdown();
+};
@@ -0,0 +1,84 @@
+/*
+* Struct: TempMonitorConfig
+*
+* Description: Tunables for the TempMonitor. Default constructed values
+*     reproduce the standard behaviour.
+*
+*/
+
+#pragma once
+
+#include "ThermalZone.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct TempMonitorConfig
+{
+   enum class IngestionMode
+   {
+        QUEUE       // Every sample is queued and processed in arrival order.
+      , COALESCING  // Only the latest sample per known subsystem is processed.
+   };
+
+   // How submit() (and so the gRPC handlers) hands samples to the tempThread.
+   // In COALESCING mode samples from unknown subsystem ids still go through
+   // the ring.
+   IngestionMode ingestionMode{ IngestionMode::QUEUE };
+
+   // Number of temperature samples the ingestion ring can hold before the
+   // overflowPolicy applies. Rounded up to a power of two.
+   size_t queueCapacity{ 4096 };
+
+   enum class OverflowPolicy
+   {
+        REJECT       // TEMP_MONITOR_QUEUE_FULL (RPC: RESOURCE_EXHAUSTED) so the sender backs off.
+      , DROP_NEWEST  // The incoming sample is discarded, submit succeeds.
+      , DROP_OLDEST  // The oldest queued samples are evicted to make room.
+   };
+
+   // What submit() does with a sample when the ingestion ring is full.
+   OverflowPolicy overflowPolicy{ OverflowPolicy::REJECT };
+
+   // Queue depth watermarks, in percent of queueCapacity. Crossing one logs
+   // a warning, at most once per watermarkLogIntervalMs.
+   size_t queueLowWatermarkPct{ 50 };
+   size_t queueHighWatermarkPct{ 80 };
+   size_t watermarkLogIntervalMs{ 1000 };
+
+   enum class ServerMode
+   {
+        SYNC   // gRPC sync server, handlers run on gRPC's thread pool.
+      , ASYNC  // Completion queue server, see TempMonitorAsyncServer.
+      , NONE   // No server, temps only arrive through TempMonitor::submit().
+   };
+
+   ServerMode serverMode{ ServerMode::SYNC };
+
+   // ASYNC: number of completion queues, each drained by its own thread.
+   size_t asyncPollingThreads{ 2 };
+
+   // ASYNC: calls of each RPC kind kept armed on every completion queue.
+   size_t asyncCallsPerQueue{ 16 };
+
+   // Shared memory telemetry table (SharedTempTable) name, e.g. "/fcc_temps",
+   // empty for none. initialize() creates it with sharedTableSlots slots and
+   // every temp published to it is submitted, side by side with the server.
+   std::string sharedTableName;
+   size_t      sharedTableSlots{ 64 };
+
+   enum class SharedTableWait
+   {
+        FUTEX  // Sleep until a writer publishes; a writer only syscalls to wake it.
+      , POLL   // Rescan every sharedTablePollUs; writers never syscall.
+   };
+
+   SharedTableWait sharedTableWait{ SharedTableWait::FUTEX };
+   uint32_t        sharedTablePollUs{ 100 };
+
+   // Zones whose max temp is tracked and notified separately (only the
+   // subSystemIds are used). Every zone subsystem must be a known subsystem.
+   std::vector<ThermalZone> thermalZones;
+};
@@ -5,12 +5,20 @@
 *     objects to register with TempMonitor to be notified of a new 
 *     max temp.
 *
+*     Listeners that measure latency (see LatencyRecorder) also override the
+*     traced overload, which by default drops the trace.
+*
 */
 
 #pragma once
 
+#include "SampleTrace.h"
+
 class TempMonitorListener
 {
 public:
    virtual void notifyNewMaxTemp( float temp ) = 0;
+
+   // trace - The sample that produced the new max, if it was traced.
+   virtual void notifyNewMaxTemp( float temp, const SampleTrace& /*trace*/ ) { notifyNewMaxTemp( temp ); }
 };
\ No newline at end of file
@@ -27,7 +27,7 @@ struct TempToDutyCycle
    //
    // Description: Calculates and returns the duty cycle for the provided temp.
    //
-   inline static float getDutyCycle(float temp)
+   static constexpr float getDutyCycle(float temp)
    {
       float rVal{ 0.0 };
 
@@ -0,0 +1,23 @@
+/*
+* Struct: ThermalZone
+*
+* Description: A set of subsystems whose max temp drives a set of fans.
+*     The TempMonitor tracks each zone's max temp alongside the global one
+*     and notifies the zone's listeners when it changes; the FanControl
+*     drives the zone's fans from it with a FanGroup of their own.
+*
+*     A subsystem may belong to several zones. A fan belongs to at most one
+*     zone; fans in no zone follow the global max temp.
+*
+*/
+
+#pragma once
+
+#include <vector>
+
+struct ThermalZone
+{
+   int              zoneId{ 0 };
+   std::vector<int> subSystemIds;
+   std::vector<int> fanIds;
+};
\ No newline at end of file
@@ -0,0 +1,206 @@
+/*
+* Class: TimerWheel
+*
+* Description: Hierarchical timer wheel for a fixed set of timers, e.g. one
+*     per simulated subsystem. Time is counted in ticks (the owner decides
+*     how long a tick is).
+*
+*     There are NUM_LEVELS wheels of SLOTS_PER_LEVEL slots. Level 0 slots
+*     are one tick wide, each higher level's slots span a whole turn of the
+*     level below. A timer is filed in the lowest level its expiry fits in,
+*     and is moved down (cascaded) when the wheel below reaches its slot, so
+*     schedule() and expiring a timer are O(1) regardless of the number of
+*     timers or how far out they are.
+*
+*     Timers are identified by an index in [0, capacity) and linked through
+*     a preallocated node array: scheduling and expiring never allocate.
+*
+*     Not thread safe: owned by one thread.
+*
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class TimerWheel final
+{
+public:
+   using TimerId = uint32_t;
+
+   static constexpr uint32_t SLOT_BITS{ 8 };
+   static constexpr uint32_t SLOTS_PER_LEVEL{ 1u << SLOT_BITS };
+   static constexpr uint32_t NUM_LEVELS{ 4 };
+
+   // Furthest a timer can be filed; later expiries are cascaded again.
+   static constexpr uint64_t MAX_DELTA{ (1ull << (SLOT_BITS * NUM_LEVELS)) - 1 };
+
+private:
+   static constexpr uint32_t SLOT_MASK{ SLOTS_PER_LEVEL - 1 };
+   static constexpr TimerId  NIL{ std::numeric_limits<TimerId>::max() };
+
+   struct Node
+   {
+      uint64_t expiry{ 0 };
+      TimerId  next{ NIL };
+      bool     scheduled{ false };
+   };
+
+   uint64_t             now{ 0 };
+   size_t               numScheduled{ 0 };
+   std::vector<Node>    nodes;
+   std::vector<TimerId> slots; // NUM_LEVELS x SLOTS_PER_LEVEL list heads.
+
+   TimerId& slotHead(uint32_t level, uint64_t tick)
+   {
+      return slots[(level * SLOTS_PER_LEVEL) + ((tick >> (level * SLOT_BITS)) & SLOT_MASK)];
+   }
+
+   //
+   // Name: file
+   //
+   // Description: Links the timer into the slot of the lowest level whose
+   //    span covers its expiry, relative to now.
+   //
+   void file(TimerId id)
+   {
+      auto& node{ nodes[id] };
+      auto  delta{ node.expiry - now };
+      auto  fileTick{ node.expiry };
+      if (delta > MAX_DELTA)
+      {
+         delta    = MAX_DELTA;
+         fileTick = now + MAX_DELTA;
+      }
+
+      uint32_t level{ 0 };
+      while ((level + 1 < NUM_LEVELS) && (delta >= (1ull << ((level + 1) * SLOT_BITS))))
+      {
+         ++level;
+      }
+
+      auto& head{ slotHead(level, fileTick) };
+      node.next = head;
+      head      = id;
+   }
+
+   //
+   // Name: cascade
+   //
+   // Description: Refiles every timer in the level's current slot; they
+   //    now land in a lower level.
+   //
+   void cascade(uint32_t level)
+   {
+      auto& head{ slotHead(level, now) };
+      auto  id{ head };
+      head = NIL;
+
+      while (NIL != id)
+      {
+         const auto next{ nodes[id].next };
+         file(id);
+         id = next;
+      }
+   }
+
+public:
+   //
+   // Name: TimerWheel (ctor)
+   //
+   // Params: capacity - Number of timers, ids are [0, capacity).
+   //         startTick - Current tick.
+   //
+   explicit TimerWheel(size_t capacity, uint64_t startTick = 0)
+      : now(startTick)
+      , nodes(capacity)
+      , slots(NUM_LEVELS * SLOTS_PER_LEVEL, NIL)
+   {}
+
+   //
+   // Name: schedule
+   //
+   // Description: Arms the timer to expire at expiryTick (the next tick if
+   //    that has already passed). The timer must not be armed already; it
+   //    may be re-armed from its own expiry callback.
+   //
+   // Params: id - Timer id, [0, capacity).
+   //         expiryTick - Absolute tick.
+   //
+   // Return: bool - False if the id is out of range or already armed.
+   //
+   bool schedule(TimerId id, uint64_t expiryTick)
+   {
+      auto rVal{ false };
+
+      if ((id < nodes.size()) && !nodes[id].scheduled)
+      {
+         auto& node{ nodes[id] };
+         node.expiry    = (expiryTick > now) ? expiryTick : (now + 1);
+         node.scheduled = true;
+         ++numScheduled;
+         file(id);
+         rVal = true;
+      }
+      return rVal;
+   }
+
+   //
+   // Name: advance
+   //
+   // Description: Moves the wheel forward to toTick, calling onExpired(id)
+   //    for every timer that expires on the way, in expiry order (timers
+   //    expiring on the same tick in no particular order). A timer is
+   //    disarmed before its callback runs.
+   //
+   // Params: toTick - Absolute tick to advance to.
+   //         onExpired - Callable taking (TimerId).
+   //
+   template <typename Func>
+   void advance(uint64_t toTick, Func&& onExpired)
+   {
+      while (now < toTick)
+      {
+         if (0 == numScheduled)
+         {
+            now = toTick; // Nothing to expire or cascade.
+            break;
+         }
+
+         ++now;
+         for (uint32_t level{ 1 }; (level < NUM_LEVELS) && (0 == (now & ((1ull << (level * SLOT_BITS)) - 1))); ++level)
+         {
+            cascade(level);
+         }
+
+         auto& head{ slotHead(0, now) };
+         auto  id{ head };
+         head = NIL;
+
+         while (NIL != id)
+         {
+            auto& node{ nodes[id] };
+            const auto next{ node.next };
+
+            if (node.expiry > now)
+            {
+               file(id); // Beyond MAX_DELTA when it was filed.
+            }
+            else
+            {
+               node.scheduled = false;
+               --numScheduled;
+               onExpired(id);
+            }
+            id = next;
+         }
+      }
+   }
+
+   uint64_t getNow() const { return now; }
+   size_t   getNumScheduled() const { return numScheduled; }
+   size_t   getCapacity() const { return nodes.size(); }
+};
\ No newline at end of file
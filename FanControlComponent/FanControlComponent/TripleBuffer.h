@@ -0,0 +1,97 @@
+/*
+* Class: TripleBuffer
+*
+* Description: Lock-free handoff of the latest T from one writer thread to
+*     one reader thread, e.g. fan data from FanControl to the UI.
+*
+*     There are three Ts: the writer fills its back buffer and publishes it
+*     by swapping it with the middle one, the reader takes the middle one by
+*     swapping it with its front buffer. Each swap is a single atomic
+*     exchange, so neither side ever waits for the other and no T is copied
+*     or allocated by the handoff. The reader only ever sees the latest
+*     published T; older ones are overwritten (not queued).
+*
+*     T must be default constructible. Buffers are reused, so the writer
+*     must overwrite every field it cares about before publishing.
+*
+*/
+
+#pragma once
+
+#include "GeneralConstants.h"
+
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer final
+{
+   static constexpr size_t  CACHE_LINE_SIZE{ GeneralConstants::CACHE_LINE_SIZE };
+   static constexpr uint8_t INDEX_MASK{ 0x3 };
+   static constexpr uint8_t NEW_DATA{ 0x4 }; // Middle buffer published, not yet taken.
+
+   struct alignas(CACHE_LINE_SIZE) Buffer
+   {
+      T value{};
+   };
+
+   Buffer buffers[3];
+
+   alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> middle{ 1 }; // Index | NEW_DATA.
+   alignas(CACHE_LINE_SIZE) uint8_t              back{ 0 };   // Writer only.
+   alignas(CACHE_LINE_SIZE) uint8_t              front{ 2 };  // Reader only.
+
+public:
+   TripleBuffer() = default;
+
+   TripleBuffer(const TripleBuffer&) = delete;
+   TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+   //
+   // Name: getWriteBuffer
+   //
+   // Description: Writer only. The buffer to fill before publish(); it may
+   //    still hold an older value.
+   //
+   T& getWriteBuffer() { return buffers[back].value; }
+
+   //
+   // Name: publish
+   //
+   // Description: Writer only. Makes the write buffer the latest value and
+   //    hands the writer a free buffer.
+   //
+   void publish()
+   {
+      back = middle.exchange(static_cast<uint8_t>(back | NEW_DATA), std::memory_order_acq_rel) & INDEX_MASK;
+   }
+
+   //
+   // Name: update
+   //
+   // Description: Reader only. Takes the latest published value, if there
+   //    is one newer than getReadBuffer().
+   //
+   // Return: bool - True if getReadBuffer() changed.
+   //
+   bool update()
+   {
+      auto rVal{ false };
+
+      if (0 != (middle.load(std::memory_order_relaxed) & NEW_DATA))
+      {
+         front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+         rVal = true;
+      }
+      return rVal;
+   }
+
+   //
+   // Name: getReadBuffer
+   //
+   // Description: Reader only. The value taken by the last update() (a
+   //    default constructed T before the first one). Stable until the next
+   //    update().
+   //
+   const T& getReadBuffer() const { return buffers[front].value; }
+};
\ No newline at end of file
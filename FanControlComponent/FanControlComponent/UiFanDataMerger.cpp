@@ -0,0 +1,72 @@
+#include "UiFanDataMerger.h"
+
+#include <algorithm>
+
+//
+// Name: UiFanDataMerger (ctor)
+//
+// Params: uiUpdater - The UI the merged FanData is handed to.
+//
+UiFanDataMerger::UiFanDataMerger(UiUpdater& uiUpdater)
+   : target(uiUpdater)
+{
+   // Empty
+}
+
+//
+// Name: addRegion
+//
+// Description: Reserves the next maxFans fans of the merged FanData for one
+//    fan owner. Must be called before the region's first update, and not
+//    concurrently with any update.
+//
+// Params: maxFans - Most fans the owner reports.
+//         summary - The owner's temp and duty cycle are the ones shown.
+//
+// Return: UiUpdater* - The region, owned by this merger.
+//
+UiUpdater* UiFanDataMerger::addRegion(size_t maxFans, bool summary)
+{
+   Slice slice;
+   slice.offset   = numReserved;
+   slice.capacity = std::min( maxFans, UiUpdater::FanData::MAX_FANS - numReserved );
+   slice.summary  = summary;
+   numReserved   += slice.capacity;
+
+   slices.push_back( slice );
+   regions.push_back( std::make_unique<Region>( *this, regions.size() ) );
+   return regions.back().get();
+}
+
+//
+// Name: update
+//
+// Description: Replaces the fans of one region and hands the merged FanData
+//    to the UI.
+//
+// Params: index - Region index.
+//         fandata - The region owner's latest fan data.
+//
+void UiFanDataMerger::update(size_t index, const UiUpdater::FanData& fandata)
+{
+   std::lock_guard<std::mutex> guard(mux);
+
+   auto& slice{ slices[index] };
+   slice.numFans = std::min( fandata.numFans, slice.capacity );
+   std::copy_n( fandata.fans.begin(), slice.numFans, regionFans.fans.begin() + slice.offset );
+
+   if( slice.summary )
+   {
+      merged.temp      = fandata.temp;
+      merged.dutyCycle = fandata.dutyCycle;
+   }
+
+   merged.numFans = 0;
+   for( const auto& region : slices )
+   {
+      std::copy_n( regionFans.fans.begin() + region.offset, region.numFans, merged.fans.begin() + merged.numFans );
+      merged.numFans += region.numFans;
+   }
+
+   target.updateFanData( merged );
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+* Class: UiFanDataMerger
+*
+* Description: Combines the fan data of several fan owners (the FanControl
+*     fanThread and every FanGroup) into the single FanData the UiUpdater
+*     displays. Every owner gets a Region, itself a UiUpdater, covering a
+*     fixed slice of the MAX_FANS fans. A Region's updateFanData() replaces
+*     that slice and hands the merged FanData (the reported fans of every
+*     region, in region order) to the UI.
+*
+*     The temp and duty cycle shown are those of the summary region (the
+*     FanControl's, driven by the global max temp); the other regions only
+*     contribute fans.
+*
+*     Updates are serialized by a mutex, so the UiUpdater still sees a single
+*     writer at a time (e.g. for its TripleBuffer<FanData>).
+*
+* {RISK}: Fans beyond MAX_FANS in total are not shown, as with a single owner.
+*
+*/
+
+#pragma once
+
+#include "UiUpdater.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class UiFanDataMerger final
+{
+public:
+   class Region final : public UiUpdater
+   {
+      UiFanDataMerger& merger;
+      const size_t     index;
+
+   public:
+      Region(UiFanDataMerger& owner, size_t regionIndex) : merger(owner), index(regionIndex) {}
+
+      void updateSubSystemTemp(int ssid, float temp) override { merger.target.updateSubSystemTemp(ssid, temp); }
+      void updateFanData(const UiUpdater::FanData& fandata) override { merger.update(index, fandata); }
+   };
+
+private:
+   struct Slice
+   {
+      size_t offset{ 0 };
+      size_t capacity{ 0 };
+      size_t numFans{ 0 };   // Reported so far.
+      bool   summary{ false };
+   };
+
+   UiUpdater&                           target;
+   std::mutex                           mux;
+   std::vector<Slice>                   slices;
+   std::vector<std::unique_ptr<Region>> regions;
+   size_t                               numReserved{ 0 };
+   UiUpdater::FanData                   regionFans; // Every region's fans at its offset.
+   UiUpdater::FanData                   merged;     // Handed to the target.
+
+   void update(size_t index, const UiUpdater::FanData& fandata);
+
+public:
+   explicit UiFanDataMerger(UiUpdater& uiUpdater);
+
+   UiFanDataMerger(const UiFanDataMerger&) = delete;
+   UiFanDataMerger& operator=(const UiFanDataMerger&) = delete;
+
+   UiUpdater* addRegion(size_t maxFans, bool summary = false);
+};
\ No newline at end of file
@@ -5,21 +5,40 @@
 *     to the UI to allow for reporting subsystem temp and fan data
 *     for display.
 *
+*     FanData has fixed capacity inline storage, so building and handing
+*     it over never allocates. An implementation is expected to copy it out
+*     without locking, e.g. into a TripleBuffer<FanData>.
+*
 */
 
 #pragma once
 
+#include "FanConstants.h"
+
+#include <array>
+#include <cstddef>
+
 class UiUpdater
 {
 public:
 
+   struct FanPwmc
+   {
+      int fanId{ 0 };
+      int pwmc{ 0 };
+   };
+
    struct FanData
    {
-      float temp{ 0.0f };
-      float dutyCycle{0.0f};
-      std::vector<std::pair<int,int>> fans;
+      // Only fans with a proportionality const. can be actuated.
+      static constexpr size_t MAX_FANS{ FanConstants::FAN_PWMC_PROPORTIONALITY_TABLE.size() };
+
+      float                           temp{ 0.0f };
+      float                           dutyCycle{ 0.0f };
+      size_t                          numFans{ 0 };
+      std::array<FanPwmc, MAX_FANS>   fans{};
    };
 
    virtual void updateSubSystemTemp(int ssid, float temp) = 0;
-   virtual void updateFanData(UiUpdater::FanData& fandata ) = 0;
+   virtual void updateFanData(const UiUpdater::FanData& fandata ) = 0;
 };
\ No newline at end of file
@@ -3,10 +3,23 @@
 *
 * Description: Provides MACROS and other mechanisms for logging.
 *
+*     PRINT_STD_OUT / DEBUG_STD_OUT write synchronously to std::cout. They
+*     are for start up, shut down and other cold paths only.
+*
+*     LOG_DEBUG / LOG_INFO / LOG_WARN / LOG_ERROR queue a record with the
+*     AsyncLogger and return without blocking, for anything on a control
+*     or ingestion path. LOG_RATE_LIMITED additionally logs at most once
+*     per interval from that call site. Levels below LOG_MIN_LEVEL are
+*     compiled out (default: DEBUG in _DEBUG builds, INFO otherwise).
+*
+*     e.g. LOG_INFO("FanControl::updateFans(): CurTemp=[{}], DC=[{}]", temp, dc);
+*
 */
 
 #pragma once
 
+#include "AsyncLogger.h"
+
 #include <iostream>
 
 #define PRINT_STD_OUT(str) std::cout << str << std::endl;
@@ -15,4 +28,30 @@
 #define DEBUG_STD_OUT(str) std::cout << str << std::endl;
 #else
 #define DEBUG_STD_OUT(str) ;
-#endif
\ No newline at end of file
+#endif
+
+#ifndef LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define LOG_MIN_LEVEL 0 // LogLevel::DBG
+#else
+#define LOG_MIN_LEVEL 1 // LogLevel::INFO
+#endif
+#endif
+
+// Default interval for LOG_RATE_LIMITED call sites driven by external input.
+constexpr int LOG_DEFAULT_RATE_LIMIT_MS{ 1000 };
+
+#define LOG_RATE_LIMITED(level, minIntervalMs, fmt, ...)                            \
+   do                                                                               \
+   {                                                                                \
+      if constexpr (static_cast<int>(level) >= LOG_MIN_LEVEL)                       \
+      {                                                                             \
+         static AsyncLogger::Site logSite{ fmt, level, minIntervalMs };             \
+         AsyncLogger::log(logSite, ##__VA_ARGS__);                                  \
+      }                                                                             \
+   } while (false)
+
+#define LOG_DEBUG(fmt, ...) LOG_RATE_LIMITED(LogLevel::DBG,  0, fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...)  LOG_RATE_LIMITED(LogLevel::INFO, 0, fmt, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...)  LOG_RATE_LIMITED(LogLevel::WARN, 0, fmt, ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...) LOG_RATE_LIMITED(LogLevel::ERR,  0, fmt, ##__VA_ARGS__)
\ No newline at end of file
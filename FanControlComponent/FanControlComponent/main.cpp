@@ -81,7 +81,7 @@ int main()
    for( auto ssid : subSystemIds )
    {
       auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
-      subSystems.push_back( std::move( std::unique_ptr<SubSystem>( new SubSystem( channel, ssid) ) ) );
+      subSystems.push_back( std::move( std::unique_ptr<SubSystem>( new SubSystem( channel, ssid, nullptr, SubSystem::SendMode::STREAMING ) ) ) );
    }
 
    for (int x{ 0 }; x < subSystems.size(); ++x)
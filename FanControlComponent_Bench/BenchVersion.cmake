@@ -0,0 +1,31 @@
+#
+# Writes FCC_BENCH_VERSION_HEADER with FCC_BENCH_VERSION from git describe.
+# Run by the fcc_bench_version target on every build, so the version in the
+# benchmark JSON follows new commits and edits without a re-configure. The
+# header is only rewritten when the version changes.
+#
+#    cmake -DFCC_BENCH_SOURCE_DIR=<dir> -DFCC_BENCH_VERSION_HEADER=<file> -P BenchVersion.cmake
+#
+
+set(FCC_BENCH_VERSION "unknown")
+find_package(Git QUIET)
+if(GIT_FOUND)
+   execute_process(COMMAND ${GIT_EXECUTABLE} describe --always --dirty
+                   WORKING_DIRECTORY ${FCC_BENCH_SOURCE_DIR}
+                   OUTPUT_VARIABLE FCC_GIT_DESCRIBE
+                   OUTPUT_STRIP_TRAILING_WHITESPACE
+                   ERROR_QUIET)
+   if(FCC_GIT_DESCRIBE)
+      set(FCC_BENCH_VERSION ${FCC_GIT_DESCRIBE})
+   endif()
+endif()
+
+set(FCC_BENCH_VERSION_TEXT "// Generated by BenchVersion.cmake, do not edit.\n#pragma once\n#define FCC_BENCH_VERSION \"${FCC_BENCH_VERSION}\"\n")
+
+set(FCC_BENCH_VERSION_OLD "")
+if(EXISTS ${FCC_BENCH_VERSION_HEADER})
+   file(READ ${FCC_BENCH_VERSION_HEADER} FCC_BENCH_VERSION_OLD)
+endif()
+if(NOT FCC_BENCH_VERSION_OLD STREQUAL FCC_BENCH_VERSION_TEXT)
+   file(WRITE ${FCC_BENCH_VERSION_HEADER} ${FCC_BENCH_VERSION_TEXT})
+endif()
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+* File: AsyncLoggerBench
+*
+* Description: Caller side cost of one control path log line, formatted
+*     synchronously into a stream with std::endl (previous PRINT_STD_OUT)
+*     versus queued with LOG_INFO. The async rings are drained outside the
+*     timed region so no record is dropped.
+*
+*/
+
+#include "benchmark/benchmark.h"
+#include "log.h"
+
+#include <ostream>
+#include <streambuf>
+
+namespace
+{
+   // Discards everything, so only formatting and flushing are measured.
+   class NullBuffer final : public std::streambuf
+   {
+   protected:
+      int overflow(int c) override { return c; }
+   };
+}
+
+static void BM_SyncLog(benchmark::State& state)
+{
+   NullBuffer   buffer;
+   std::ostream out(&buffer);
+
+   float temp{ 37.5f };
+   int   dc{ 42 };
+   for (auto _ : state)
+   {
+      out << "FanControl::updateFans(): CurTemp=[" << temp << "], DC=[" << dc << "]" << std::endl;
+      temp += 0.25f;
+      ++dc;
+   }
+}
+BENCHMARK(BM_SyncLog);
+
+static void BM_AsyncLog(benchmark::State& state)
+{
+   NullBuffer   buffer;
+   std::ostream out(&buffer);
+   AsyncLogger::instance().setSink(out);
+
+   float  temp{ 37.5f };
+   int    dc{ 42 };
+   size_t queued{ 0 };
+   for (auto _ : state)
+   {
+      LOG_INFO("FanControl::updateFans(): CurTemp=[{}], DC=[{}]", temp, dc);
+      temp += 0.25f;
+      ++dc;
+
+      if (++queued == (AsyncLogger::RING_CAPACITY / 2))
+      {
+         state.PauseTiming();
+         AsyncLogger::instance().flush();
+         queued = 0;
+         state.ResumeTiming();
+      }
+   }
+
+   AsyncLogger::instance().flush();
+   AsyncLogger::instance().setSink(std::cout);
+   state.counters["dropped"] = static_cast<double>(AsyncLogger::instance().getDropped());
+}
+BENCHMARK(BM_AsyncLog);
\ No newline at end of file
@@ -0,0 +1,64 @@
+/*
+* File: BenchMain
+*
+* Description: main for FanControlComponentBench, replacing benchmark_main.
+*     Besides the console table the results are always written as JSON, to
+*     DEFAULT_OUT_FILE unless --benchmark_out is given, so every release
+*     leaves a machine readable baseline to compare against, e.g. with
+*     benchmark's tools/compare.py.
+*
+*     The JSON context records FCC_BENCH_VERSION (the CMake build generates
+*     FccBenchVersion.h from git describe on every build) so results can be
+*     matched to the code measured.
+*
+*/
+
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if __has_include("FccBenchVersion.h")
+#include "FccBenchVersion.h"
+#endif
+
+#ifndef FCC_BENCH_VERSION
+#define FCC_BENCH_VERSION "unknown"
+#endif
+
+namespace
+{
+   constexpr const char* DEFAULT_OUT_FILE{ "FanControlComponentBench.json" };
+}
+
+int main(int argc, char** argv)
+{
+   std::vector<char*> args(argv, argv + argc);
+
+   auto haveOut{ false };
+   for (auto arg : args)
+   {
+      haveOut = haveOut || std::string_view(arg).starts_with("--benchmark_out=");
+   }
+
+   std::string outArg{ std::string("--benchmark_out=") + DEFAULT_OUT_FILE };
+   std::string formatArg{ "--benchmark_out_format=json" };
+   if (!haveOut)
+   {
+      args.push_back(outArg.data());
+      args.push_back(formatArg.data());
+   }
+
+   auto numArgs{ static_cast<int>(args.size()) };
+   benchmark::Initialize(&numArgs, args.data());
+   if (benchmark::ReportUnrecognizedArguments(numArgs, args.data()))
+   {
+      return 1;
+   }
+
+   benchmark::AddCustomContext("fcc_version", FCC_BENCH_VERSION);
+   benchmark::RunSpecifiedBenchmarks();
+   benchmark::Shutdown();
+   return 0;
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+/*
+* File: ControlPipelineBench
+*
+* Description: The control pipeline a stage at a time, from a new temp to
+*     the fan registers.
+*
+*     BM_TempToDutyCycle: TempToDutyCycle::getDutyCycle.
+*
+*     BM_UpdateTempTables: TempMonitor::updateTempTables, one random
+*     subsystem temp, at 10, 1k and 100k subsystems. BM_UpdateCurMaxTemp
+*     adds the updateCurMaxTemp that follows it in drainQueue.
+*
+*     BM_UpdateFans: FanControl::updateFans (log, PWMC lookup, register
+*     writes) at 1, 10 and 21 fans. The log goes to a null sink.
+*
+*     BM_WriteRegister / BM_ReadRegister: FanRegisters, one fan. Written
+*     values alternate, so no write is elided by the shadow.
+*
+*     The TempMonitor and FanControl are not initialized (no gRPC server,
+*     no threads); their private steps are reached through the
+*     *BenchAccess friends below.
+*
+*/
+
+#include "benchmark/benchmark.h"
+#include "FanControl.h"
+#include "FanRegisters.h"
+#include "TempMonitor.h"
+#include "TempToDutyCycle.h"
+#include "log.h"
+
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <unordered_map>
+#include <vector>
+
+struct TempMonitorBenchAccess
+{
+   static void updateTempTables(TempMonitor& tm, size_t slot, float temp) { tm.updateTempTables(slot, temp); }
+   static bool updateCurMaxTemp(TempMonitor& tm) { return tm.updateCurMaxTemp(); }
+};
+
+struct FanControlBenchAccess
+{
+   static GeneralConstants::ReturnCodes compile(FanControl& fc) { return fc.actuationPlan.compile(fc.fanIds, fc.fanRegisters); }
+   static void updateFans(const FanControl& fc, float temp) { fc.updateFans(temp); }
+};
+
+namespace
+{
+   constexpr size_t NUM_SAMPLES{ 1 << 16 };
+
+   struct Sample
+   {
+      size_t slot{ 0 };
+      float  temp{ 0.0f };
+   };
+
+   std::vector<Sample> makeSamples(size_t numSubSystems)
+   {
+      std::mt19937 rng{ 42 };
+      std::uniform_int_distribution<size_t> slotDist(0, numSubSystems - 1);
+      std::uniform_real_distribution<float> tempDist(20.0f, 80.0f);
+
+      std::vector<Sample> samples(NUM_SAMPLES);
+      for (auto& sample : samples)
+      {
+         sample = { slotDist(rng), tempDist(rng) };
+      }
+      return samples;
+   }
+
+   std::vector<int> makeIds(size_t count)
+   {
+      std::vector<int> ids(count);
+      for (size_t x{ 0 }; x < count; ++x)
+      {
+         ids[x] = static_cast<int>(x) + 1;
+      }
+      return ids;
+   }
+
+   class NullBuffer final : public std::streambuf
+   {
+   protected:
+      int overflow(int c) override { return c; }
+   };
+}
+
+static void BM_TempToDutyCycle(benchmark::State& state)
+{
+   float temp{ 20.0f };
+   for (auto _ : state)
+   {
+      benchmark::DoNotOptimize(TempToDutyCycle::getDutyCycle(temp));
+      temp = (temp < 80.0f) ? (temp + 0.0625f) : 20.0f;
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TempToDutyCycle);
+
+static void BM_UpdateTempTables(benchmark::State& state)
+{
+   const auto numSubSystems{ static_cast<size_t>(state.range(0)) };
+   const auto samples{ makeSamples(numSubSystems) };
+   TempMonitor tm{ makeIds(numSubSystems) };
+
+   size_t idx{ 0 };
+   for (auto _ : state)
+   {
+      const auto& sample{ samples[idx++ & (NUM_SAMPLES - 1)] };
+      TempMonitorBenchAccess::updateTempTables(tm, sample.slot, sample.temp);
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UpdateTempTables)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void BM_UpdateCurMaxTemp(benchmark::State& state)
+{
+   const auto numSubSystems{ static_cast<size_t>(state.range(0)) };
+   const auto samples{ makeSamples(numSubSystems) };
+   TempMonitor tm{ makeIds(numSubSystems) };
+
+   size_t idx{ 0 };
+   for (auto _ : state)
+   {
+      const auto& sample{ samples[idx++ & (NUM_SAMPLES - 1)] };
+      TempMonitorBenchAccess::updateTempTables(tm, sample.slot, sample.temp);
+      benchmark::DoNotOptimize(TempMonitorBenchAccess::updateCurMaxTemp(tm));
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UpdateCurMaxTemp)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void BM_UpdateFans(benchmark::State& state)
+{
+   const auto numFans{ static_cast<size_t>(state.range(0)) };
+   const auto fanIds{ makeIds(numFans) };
+
+   std::vector<uint32_t>             registers(numFans, 0);
+   std::unordered_map<int, uint64_t> addresses;
+   for (size_t x{ 0 }; x < numFans; ++x)
+   {
+      addresses[fanIds[x]] = reinterpret_cast<uint64_t>(&registers[x]);
+   }
+
+   FanControl fc{ { 1 }, fanIds, addresses };
+   if (GeneralConstants::ReturnCodes::SUCCESS != FanControlBenchAccess::compile(fc))
+   {
+      state.SkipWithError("FanActuationPlan::compile failed.");
+      return;
+   }
+
+   NullBuffer   buffer;
+   std::ostream out(&buffer);
+   AsyncLogger::instance().setSink(out);
+
+   float  temp{ 20.0f };
+   size_t logged{ 0 };
+   for (auto _ : state)
+   {
+      FanControlBenchAccess::updateFans(fc, temp);
+      temp = (temp < 80.0f) ? (temp + 0.0625f) : 20.0f;
+
+      if (++logged == (AsyncLogger::RING_CAPACITY / 2))
+      {
+         state.PauseTiming();
+         AsyncLogger::instance().flush();
+         logged = 0;
+         state.ResumeTiming();
+      }
+   }
+
+   AsyncLogger::instance().flush();
+   AsyncLogger::instance().setSink(std::cout);
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UpdateFans)->Arg(1)->Arg(10)->Arg(21);
+
+static void BM_WriteRegister(benchmark::State& state)
+{
+   uint32_t     reg{ 0 };
+   FanRegisters fanRegisters{ { { 1, reinterpret_cast<uint64_t>(&reg) } } };
+
+   unsigned int pwmc{ 0 };
+   for (auto _ : state)
+   {
+      fanRegisters.writeRegister(1, pwmc);
+      pwmc ^= 1;
+   }
+   benchmark::DoNotOptimize(reg);
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WriteRegister);
+
+static void BM_ReadRegister(benchmark::State& state)
+{
+   uint32_t     reg{ 42 };
+   FanRegisters fanRegisters{ { { 1, reinterpret_cast<uint64_t>(&reg) } } };
+
+   for (auto _ : state)
+   {
+      benchmark::DoNotOptimize(fanRegisters.readRegister(1));
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReadRegister);
\ No newline at end of file
@@ -0,0 +1,227 @@
+/*
+* File: FanActuationBench
+*
+* Description: Cost of writing one duty cycle to every fan register:
+*     per-fan multiplier and register address map lookups (previous
+*     FanControl::updateFans) versus the precompiled FanActuationPlan, at
+*     21 fans (FanConstants) and 4096 fans. Registers are plain memory.
+*
+*     BM_TempToFans*: the whole control computation from a temperature,
+*     duty cycle math plus map lookups versus the FanPwmcTables lookup plus
+*     FanActuationPlan, for the 21 FanConstants fans.
+*
+*     BM_WriteRegistersBatch: FanRegisters::writeRegisters with the fans
+*     in reverse address order (sorted into address order, one fence).
+*
+*     BM_ActuationPlanUpdateMapped: the FanActuationPlan writing into a
+*     MappedRegisterBackend over a tmpfs file (/dev/shm), i.e. a hardware
+*     shaped register bank. POSIX only.
+*
+*/
+
+#include "benchmark/benchmark.h"
+#include "FanActuationPlan.h"
+#include "FanRegisters.h"
+#include "MappedRegisterBackend.h"
+#include "FanConstants.h"
+#include "FanPwmcTables.h"
+#include "TempToDutyCycle.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+   struct Fans
+   {
+      std::vector<int>                  ids;
+      std::vector<uint32_t>             registers;
+      std::unordered_map<int, uint64_t> addresses;
+      std::unordered_map<int, int>      multipliers;
+
+      explicit Fans(size_t numFans)
+         : registers(numFans, 0)
+      {
+         for (size_t x{ 0 }; x < numFans; ++x)
+         {
+            const auto fanId{ static_cast<int>(x) + 1 };
+            ids.push_back(fanId);
+            addresses[fanId]   = reinterpret_cast<uint64_t>(&registers[x]);
+            multipliers[fanId] = 2 + static_cast<int>(x % 7);
+         }
+      }
+   };
+}
+
+static void BM_MapLookupUpdate(benchmark::State& state)
+{
+   Fans fans{ static_cast<size_t>(state.range(0)) };
+   FanRegisters fanRegisters{ fans.addresses };
+
+   int dutyCycle{ 20 };
+   for (auto _ : state)
+   {
+      for (auto fanId : fans.ids)
+      {
+         auto multiplier{ fans.multipliers.find(fanId) };
+         if (fans.multipliers.end() != multiplier)
+         {
+            fanRegisters.writeRegister(fanId, dutyCycle * multiplier->second);
+         }
+      }
+      dutyCycle = (100 == dutyCycle) ? 20 : dutyCycle + 1;
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ActuationPlanUpdate(benchmark::State& state)
+{
+   Fans fans{ static_cast<size_t>(state.range(0)) };
+   FanRegisters fanRegisters{ fans.addresses };
+
+   FanActuationPlan plan;
+   if (GeneralConstants::ReturnCodes::SUCCESS != plan.compile(fans.ids, fanRegisters, fans.multipliers))
+   {
+      state.SkipWithError("FanActuationPlan::compile failed");
+      return;
+   }
+
+   int dutyCycle{ 20 };
+   for (auto _ : state)
+   {
+      plan.apply(dutyCycle);
+      dutyCycle = (100 == dutyCycle) ? 20 : dutyCycle + 1;
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_WriteRegistersBatch(benchmark::State& state)
+{
+   Fans fans{ static_cast<size_t>(state.range(0)) };
+   FanRegisters fanRegisters{ fans.addresses };
+
+   std::vector<FanRegisters::FanWrite> writes(fans.ids.size());
+   std::vector<int>                    multipliers;
+   for (auto itr{ fans.ids.rbegin() }; itr != fans.ids.rend(); ++itr)
+   {
+      multipliers.push_back(fans.multipliers[*itr]);
+   }
+
+   int dutyCycle{ 20 };
+   for (auto _ : state)
+   {
+      for (size_t x{ 0 }; x < fans.ids.size(); ++x)
+      {
+         writes[x] = { fans.ids[fans.ids.size() - 1 - x], static_cast<uint32_t>(dutyCycle * multipliers[x]) };
+      }
+      fanRegisters.writeRegisters(writes);
+      dutyCycle = (100 == dutyCycle) ? 20 : dutyCycle + 1;
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_TempToFansLegacy(benchmark::State& state)
+{
+   Fans fans{ FanConstants::FAN_PWMC_PROPORTIONALITY_TABLE.size() };
+   FanRegisters fanRegisters{ fans.addresses };
+
+   float temp{ 20.0f };
+   for (auto _ : state)
+   {
+      const auto roundedDc{ static_cast<int>(std::round(TempToDutyCycle::getDutyCycle(temp))) };
+      for (auto fanId : fans.ids)
+      {
+         auto multiplier{ FanConstants::FAN_PWMC_PROPORTIONALITY.find(fanId) };
+         if (FanConstants::FAN_PWMC_PROPORTIONALITY.end() != multiplier)
+         {
+            fanRegisters.writeRegister(fanId, roundedDc * multiplier->second);
+         }
+      }
+      temp = (temp > 80.0f) ? 20.0f : temp + 0.37f;
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_TempToFansTables(benchmark::State& state)
+{
+   Fans fans{ FanConstants::FAN_PWMC_PROPORTIONALITY_TABLE.size() };
+   FanRegisters fanRegisters{ fans.addresses };
+
+   FanActuationPlan plan;
+   if (GeneralConstants::ReturnCodes::SUCCESS != plan.compile(fans.ids, fanRegisters))
+   {
+      state.SkipWithError("FanActuationPlan::compile failed");
+      return;
+   }
+
+   float temp{ 20.0f };
+   for (auto _ : state)
+   {
+      plan.apply(FanPwmcTables::getDutyCycle(temp));
+      temp = (temp > 80.0f) ? 20.0f : temp + 0.37f;
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+static void BM_ActuationPlanUpdateMapped(benchmark::State& state)
+{
+   constexpr uint64_t BASE_ADDRESS{ 0xB200'0000 };
+   const std::string  path{ "/dev/shm/FanActuationBench_registers" };
+
+   const auto numFans{ static_cast<size_t>(state.range(0)) };
+   auto backend{ std::make_shared<MappedRegisterBackend>(path, BASE_ADDRESS, numFans * sizeof(uint32_t), 0, true) };
+   if (GeneralConstants::ReturnCodes::SUCCESS != backend->open())
+   {
+      state.SkipWithError("MappedRegisterBackend::open failed");
+      return;
+   }
+
+   Fans fans{ numFans };
+   for (size_t x{ 0 }; x < numFans; ++x)
+   {
+      fans.addresses[fans.ids[x]] = BASE_ADDRESS + (x * sizeof(uint32_t));
+   }
+   FanRegisters fanRegisters{ fans.addresses, backend };
+
+   FanActuationPlan plan;
+   if (GeneralConstants::ReturnCodes::SUCCESS != plan.compile(fans.ids, fanRegisters, fans.multipliers))
+   {
+      state.SkipWithError("FanActuationPlan::compile failed");
+      return;
+   }
+
+   int dutyCycle{ 20 };
+   for (auto _ : state)
+   {
+      plan.apply(dutyCycle);
+      dutyCycle = (100 == dutyCycle) ? 20 : dutyCycle + 1;
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+   std::remove(path.c_str());
+}
+
+BENCHMARK(BM_ActuationPlanUpdateMapped)->Arg(21)->Arg(4096);
+#endif
+
+BENCHMARK(BM_MapLookupUpdate)->Arg(21)->Arg(4096);
+BENCHMARK(BM_ActuationPlanUpdate)->Arg(21)->Arg(4096);
+BENCHMARK(BM_WriteRegistersBatch)->Arg(21)->Arg(4096);
+
+BENCHMARK(BM_TempToFansLegacy);
+BENCHMARK(BM_TempToFansTables);
\ No newline at end of file
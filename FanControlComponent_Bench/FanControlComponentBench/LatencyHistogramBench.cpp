@@ -0,0 +1,44 @@
+/*
+* File: LatencyHistogramBench
+*
+* Description: Cost the latency tracing adds to a traced sample: one
+*     LatencyHistogram::record (with a steady_clock read, as on the hot path),
+*     from one thread and from several threads recording into the same
+*     histogram.
+*
+*/
+
+#include "benchmark/benchmark.h"
+#include "LatencyHistogram.h"
+#include "SampleTrace.h"
+
+namespace
+{
+   LatencyHistogram sharedHistogram;
+}
+
+static void BM_LatencyHistogramRecord(benchmark::State& state)
+{
+   LatencyHistogram histogram;
+   uint64_t valueNs{ 1 };
+
+   for (auto _ : state)
+   {
+      histogram.record(valueNs);
+      valueNs = (valueNs * 7) & 0xF'FFFF; // Up to ~1ms, spread over the buckets.
+      valueNs |= 1;
+   }
+   benchmark::DoNotOptimize(histogram.getCount());
+}
+BENCHMARK(BM_LatencyHistogramRecord);
+
+static void BM_LatencyHistogramRecordNow(benchmark::State& state)
+{
+   const auto startNs{ SampleTrace::nowNs() };
+
+   for (auto _ : state)
+   {
+      sharedHistogram.record(static_cast<uint64_t>(SampleTrace::nowNs() - startNs) & 0xF'FFFF);
+   }
+}
+BENCHMARK(BM_LatencyHistogramRecordNow)->Threads(1)->Threads(4);
\ No newline at end of file
@@ -0,0 +1,69 @@
+/*
+* File: LoadGeneratorBench
+*
+* Description: Cost per simulated temp of the LoadGenerator engine loop
+*     (TimerWheel expiry, Prng waveform step, re-arm), at 1k, 10k and 100k
+*     subsystems with a 300ms period, versus the SubSystem step it replaces
+*     (rand() under its global lock). Thread wake ups and sends excluded.
+*
+*/
+
+#include "benchmark/benchmark.h"
+#include "Prng.h"
+#include "TimerWheel.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+   constexpr uint64_t PERIOD_TICKS{ 300 };
+}
+
+static void BM_SubSystemRandStep(benchmark::State& state)
+{
+   float temp{ 30.0f };
+   for (auto _ : state)
+   {
+      switch (rand() % 3)
+      {
+      case 0:  temp -= 0.1f; break;
+      case 1:  temp += 0.1f; break;
+      default: break;
+      }
+      benchmark::DoNotOptimize(temp);
+   }
+}
+BENCHMARK(BM_SubSystemRandStep);
+
+static void BM_TimerWheelEngineStep(benchmark::State& state)
+{
+   const auto numSubSystems{ static_cast<size_t>(state.range(0)) };
+
+   TimerWheel         wheel{ numSubSystems };
+   std::vector<Prng>  prngs;
+   std::vector<float> temps(numSubSystems, 30.0f);
+   for (TimerWheel::TimerId id{ 0 }; id < numSubSystems; ++id)
+   {
+      prngs.emplace_back(id);
+      wheel.schedule(id, 1 + prngs.back().nextBelow(PERIOD_TICKS));
+   }
+
+   // One period per iteration: every subsystem expires once.
+   for (auto _ : state)
+   {
+      wheel.advance(wheel.getNow() + PERIOD_TICKS, [&](TimerWheel::TimerId id)
+      {
+         switch (prngs[id].nextBelow(3))
+         {
+         case 0:  temps[id] -= 0.1f; break;
+         case 1:  temps[id] += 0.1f; break;
+         default: break;
+         }
+         wheel.schedule(id, wheel.getNow() + PERIOD_TICKS);
+      });
+   }
+   benchmark::DoNotOptimize(temps.data());
+   state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(numSubSystems));
+}
+BENCHMARK(BM_TimerWheelEngineStep)->Arg(1'000)->Arg(10'000)->Arg(100'000);
\ No newline at end of file
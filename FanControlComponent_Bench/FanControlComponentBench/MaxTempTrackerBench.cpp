@@ -0,0 +1,103 @@
+/*
+* File: MaxTempTrackerBench
+*
+* Description: Cost of applying one subsystem temp and reading the max temp,
+*     std::multiset (previous TempMonitor implementation) versus the
+*     MaxTempTracker tournament tree, at 10, 1k and 100k subsystems.
+*
+*/
+
+#include "benchmark/benchmark.h"
+#include "MaxTempTracker.h"
+
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+   constexpr size_t NUM_SAMPLES{ 1 << 16 };
+
+   struct Sample
+   {
+      size_t slot{ 0 };
+      float  temp{ 0.0f };
+   };
+
+   std::vector<Sample> makeSamples(size_t numSubSystems)
+   {
+      std::mt19937 rng{ 42 };
+      std::uniform_int_distribution<size_t> slotDist(0, numSubSystems - 1);
+      std::uniform_real_distribution<float> tempDist(20.0f, 80.0f);
+
+      std::vector<Sample> samples(NUM_SAMPLES);
+      for (auto& sample : samples)
+      {
+         sample = { slotDist(rng), tempDist(rng) };
+      }
+      return samples;
+   }
+}
+
+static void BM_MultisetMaxTemp(benchmark::State& state)
+{
+   const auto numSubSystems{ static_cast<size_t>(state.range(0)) };
+   const auto samples{ makeSamples(numSubSystems) };
+
+   std::unordered_map<int, float> subSystemTemps;
+   std::multiset<float>           curTemps;
+   for (size_t x{ 0 }; x < numSubSystems; ++x)
+   {
+      subSystemTemps[static_cast<int>(x)] = 25.0f;
+      curTemps.insert(25.0f);
+   }
+
+   size_t idx{ 0 };
+   for (auto _ : state)
+   {
+      const auto& sample{ samples[idx++ & (NUM_SAMPLES - 1)] };
+      auto& oldTemp{ subSystemTemps[static_cast<int>(sample.slot)] };
+      if (oldTemp != sample.temp)
+      {
+         auto Itr{ curTemps.find(oldTemp) };
+         if (curTemps.end() != Itr)
+         {
+            curTemps.erase(Itr);
+         }
+         curTemps.insert(sample.temp);
+         oldTemp = sample.temp;
+      }
+      benchmark::DoNotOptimize(*(--curTemps.end()));
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_MaxTempTracker(benchmark::State& state)
+{
+   const auto numSubSystems{ static_cast<size_t>(state.range(0)) };
+   const auto samples{ makeSamples(numSubSystems) };
+
+   MaxTempTracker tracker{ numSubSystems };
+   for (size_t x{ 0 }; x < numSubSystems; ++x)
+   {
+      tracker.update(x, 25.0f);
+   }
+
+   size_t idx{ 0 };
+   for (auto _ : state)
+   {
+      const auto& sample{ samples[idx++ & (NUM_SAMPLES - 1)] };
+      if (tracker.get(sample.slot) != sample.temp)
+      {
+         tracker.update(sample.slot, sample.temp);
+      }
+      benchmark::DoNotOptimize(tracker.getMax());
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_MultisetMaxTemp)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_MaxTempTracker)->Arg(10)->Arg(1000)->Arg(100000);
@@ -0,0 +1,130 @@
+/*
+* File: SubSystemIndexBench
+*
+* Description: Cost of validating a subsystem id and finding its slot:
+*     linear std::find (original UpdateSubSystemTemp check), unordered_map
+*     and SubSystemIndex, for dense and sparse ids. BM_UpdateSubSystemTemp
+*     times the whole RPC handler, called through the generated Service
+*     interface without the transport.
+*
+*/
+
+#include "benchmark/benchmark.h"
+#include "SubSystemIndex.h"
+#include "TempMonitor.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+   constexpr size_t NUM_LOOKUPS{ 1 << 16 };
+
+   // state.range(0): number of subsystems, state.range(1): 0 dense ids, 1 sparse ids.
+   std::vector<int> makeIds(const benchmark::State& state)
+   {
+      std::vector<int> ids(static_cast<size_t>(state.range(0)));
+      std::mt19937 rng{ 42 };
+      for (size_t x{ 0 }; x < ids.size(); ++x)
+      {
+         ids[x] = (0 == state.range(1)) ? static_cast<int>(x) + 1 : static_cast<int>(rng() & 0x7FFFFFFF);
+      }
+      return ids;
+   }
+
+   std::vector<int> makeLookups(const std::vector<int>& ids)
+   {
+      std::mt19937 rng{ 7 };
+      std::uniform_int_distribution<size_t> dist(0, ids.size() - 1);
+
+      std::vector<int> lookups(NUM_LOOKUPS);
+      for (auto& id : lookups)
+      {
+         id = ids[dist(rng)];
+      }
+      return lookups;
+   }
+}
+
+static void BM_LinearFind(benchmark::State& state)
+{
+   const auto ids{ makeIds(state) };
+   const auto lookups{ makeLookups(ids) };
+
+   size_t idx{ 0 };
+   for (auto _ : state)
+   {
+      const auto id{ lookups[idx++ & (NUM_LOOKUPS - 1)] };
+      benchmark::DoNotOptimize(std::find(ids.begin(), ids.end(), id) - ids.begin());
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_UnorderedMap(benchmark::State& state)
+{
+   const auto ids{ makeIds(state) };
+   const auto lookups{ makeLookups(ids) };
+
+   std::unordered_map<int, size_t> slots;
+   for (auto id : ids)
+   {
+      slots.emplace(id, slots.size());
+   }
+
+   size_t idx{ 0 };
+   for (auto _ : state)
+   {
+      const auto id{ lookups[idx++ & (NUM_LOOKUPS - 1)] };
+      benchmark::DoNotOptimize(slots.find(id)->second);
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_SubSystemIndex(benchmark::State& state)
+{
+   const auto ids{ makeIds(state) };
+   const auto lookups{ makeLookups(ids) };
+   const SubSystemIndex index{ ids };
+
+   size_t idx{ 0 };
+   for (auto _ : state)
+   {
+      const auto id{ lookups[idx++ & (NUM_LOOKUPS - 1)] };
+      benchmark::DoNotOptimize(index.find(id));
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+
+//
+// COALESCING mode so the handler never sees a full ring; the tempThread
+// is not started, so this is the handler's cost alone.
+//
+static void BM_UpdateSubSystemTemp(benchmark::State& state)
+{
+   const auto ids{ makeIds(state) };
+   const auto lookups{ makeLookups(ids) };
+
+   TempMonitorConfig config;
+   config.ingestionMode = TempMonitorConfig::IngestionMode::COALESCING;
+   TempMonitor tm{ ids, config };
+   TempMonitorSink::TempMonitorServer::Service& service{ tm };
+
+   TempMonitorSink::SubSysIdAndTemp request;
+   TempMonitorSink::empty_param     response;
+
+   size_t idx{ 0 };
+   for (auto _ : state)
+   {
+      request.set_subsysid(lookups[idx++ & (NUM_LOOKUPS - 1)]);
+      request.set_temp(static_cast<float>(idx & 0x3F));
+      benchmark::DoNotOptimize(service.UpdateSubSystemTemp(nullptr, &request, &response));
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_LinearFind)->ArgsProduct({ { 10, 1000 }, { 0, 1 } });
+BENCHMARK(BM_UnorderedMap)->ArgsProduct({ { 10, 1000, 100000 }, { 0, 1 } });
+BENCHMARK(BM_SubSystemIndex)->ArgsProduct({ { 10, 1000, 100000 }, { 0, 1 } });
+BENCHMARK(BM_UpdateSubSystemTemp)->ArgsProduct({ { 10, 1000, 100000 }, { 0, 1 } });
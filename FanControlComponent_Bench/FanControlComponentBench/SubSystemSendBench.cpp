@@ -0,0 +1,228 @@
+/*
+* File: SubSystemSendBench
+*
+* Description: Per-sample cost of SubSystem::sendTemp against an in-process
+*     TempMonitor: one unary UpdateSubSystemTemp RPC per sample, one Write on
+*     a long-lived StreamSubSystemTemps stream, and UpdateSubSystemTempsBatch
+*     carrying N subsystems per RPC, and AsyncTempSender (ASYNC mode) with
+*     up to N unary RPCs in flight. As the baseline, TempMonitor::submit
+*     (single and batched) hands the same samples over in process, and
+*     SharedTempTable::publish writes them to a shared memory table the
+*     TempMonitor polls (FUTEX or POLL wait).
+*
+*/
+
+#include "benchmark/benchmark.h"
+#include "AsyncTempSender.h"
+#include "SharedTempTable.h"
+#include "SubSystem.h"
+#include "TempMonitor.h"
+
+#include <memory>
+#include <numeric>
+#include <thread>
+
+namespace
+{
+   const std::vector<int> SUB_SYSTEM_IDS{ 1 };
+   const size_t           MAX_BATCH_SIZE{ 64 };
+
+   std::unique_ptr<TempMonitor> tempMonitor;
+
+   void startTempMonitor(const benchmark::State&)
+   {
+      std::vector<int> ssIds(MAX_BATCH_SIZE);
+      std::iota(ssIds.begin(), ssIds.end(), SUB_SYSTEM_IDS[0]);
+      tempMonitor = std::make_unique<TempMonitor>(ssIds);
+      tempMonitor->initialize();
+   }
+
+   // No server; DROP_OLDEST so a producer faster than the tempThread is
+   // never rejected and every iteration does the same work.
+   void startInProcessTempMonitor(const benchmark::State&)
+   {
+      std::vector<int> ssIds(MAX_BATCH_SIZE);
+      std::iota(ssIds.begin(), ssIds.end(), SUB_SYSTEM_IDS[0]);
+      TempMonitorConfig config;
+      config.serverMode     = TempMonitorConfig::ServerMode::NONE;
+      config.overflowPolicy = TempMonitorConfig::OverflowPolicy::DROP_OLDEST;
+      tempMonitor = std::make_unique<TempMonitor>(ssIds, config);
+      tempMonitor->initialize();
+   }
+
+   const char* const SHARED_TABLE_NAME{ "/FanControlComponentBench" };
+
+   // In process, no server; the TempMonitor reads SHARED_TABLE_NAME with
+   // the SharedTableWait given as the benchmark argument.
+   void startSharedTableTempMonitor(const benchmark::State& state)
+   {
+      TempMonitorConfig config;
+      config.serverMode       = TempMonitorConfig::ServerMode::NONE;
+      config.overflowPolicy   = TempMonitorConfig::OverflowPolicy::DROP_OLDEST;
+      config.sharedTableName  = SHARED_TABLE_NAME;
+      config.sharedTableSlots = SUB_SYSTEM_IDS.size();
+      config.sharedTableWait  = static_cast<TempMonitorConfig::SharedTableWait>(state.range(0));
+      tempMonitor = std::make_unique<TempMonitor>(SUB_SYSTEM_IDS, config);
+      tempMonitor->initialize();
+   }
+
+   void stopTempMonitor(const benchmark::State&)
+   {
+      tempMonitor.reset();
+   }
+}
+
+static void BM_SubSystemSendTemp(benchmark::State& state)
+{
+   const auto mode{ static_cast<SubSystem::SendMode>(state.range(0)) };
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   SubSystem subSystem(channel, SUB_SYSTEM_IDS[0], nullptr, mode);
+
+   float temp{ 30.0f };
+   for (auto _ : state)
+   {
+      subSystem.sendTemp(temp);
+      temp = (temp > 70.0f) ? 30.0f : (temp + 0.1f);
+   }
+
+   state.SetItemsProcessed(state.iterations());
+   state.SetLabel((SubSystem::SendMode::UNARY == mode) ? "UNARY" : "STREAMING");
+}
+
+BENCHMARK(BM_SubSystemSendTemp)
+   ->Setup(startTempMonitor)
+   ->Teardown(stopTempMonitor)
+   ->Arg(static_cast<int>(SubSystem::SendMode::UNARY))
+   ->Arg(static_cast<int>(SubSystem::SendMode::STREAMING))
+   ->UseRealTime();
+
+static void BM_SubSystemSendTempBatch(benchmark::State& state)
+{
+   const auto batchSize{ static_cast<size_t>(state.range(0)) };
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   SubSystem boardController(channel, SUB_SYSTEM_IDS[0]);
+
+   std::vector<int> ssIds(batchSize);
+   std::iota(ssIds.begin(), ssIds.end(), SUB_SYSTEM_IDS[0]);
+   std::vector<float> temps(batchSize, 30.0f);
+
+   for (auto _ : state)
+   {
+      boardController.sendTempBatch(ssIds, temps);
+      for (auto& temp : temps)
+      {
+         temp = (temp > 70.0f) ? 30.0f : (temp + 0.1f);
+      }
+   }
+
+   // Per sample, comparable with BM_SubSystemSendTemp.
+   state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+BENCHMARK(BM_SubSystemSendTempBatch)
+   ->Setup(startTempMonitor)
+   ->Teardown(stopTempMonitor)
+   ->Arg(8)
+   ->Arg(static_cast<int>(MAX_BATCH_SIZE))
+   ->UseRealTime();
+
+
+static void BM_AsyncTempSenderSend(benchmark::State& state)
+{
+   const auto maxInFlight{ static_cast<size_t>(state.range(0)) };
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   AsyncTempSender sender(channel, maxInFlight);
+
+   // Only count temps that were sent: retry while every slot is in flight.
+   float temp{ 30.0f };
+   for (auto _ : state)
+   {
+      while (!sender.send(SUB_SYSTEM_IDS[0], temp))
+      {
+         std::this_thread::yield();
+      }
+      temp = (temp > 70.0f) ? 30.0f : (temp + 0.1f);
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_AsyncTempSenderSend)
+   ->Setup(startTempMonitor)
+   ->Teardown(stopTempMonitor)
+   ->Arg(1)
+   ->Arg(16)
+   ->Arg(64)
+   ->UseRealTime();
+
+static void BM_TempMonitorSubmit(benchmark::State& state)
+{
+   float temp{ 30.0f };
+   for (auto _ : state)
+   {
+      benchmark::DoNotOptimize(tempMonitor->submit(SUB_SYSTEM_IDS[0], temp));
+      temp = (temp > 70.0f) ? 30.0f : (temp + 0.1f);
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_TempMonitorSubmit)
+   ->Setup(startInProcessTempMonitor)
+   ->Teardown(stopTempMonitor)
+   ->UseRealTime();
+
+static void BM_TempMonitorSubmitBatch(benchmark::State& state)
+{
+   const auto batchSize{ static_cast<size_t>(state.range(0)) };
+
+   std::vector<int> ssIds(batchSize);
+   std::iota(ssIds.begin(), ssIds.end(), SUB_SYSTEM_IDS[0]);
+   std::vector<float> temps(batchSize, 30.0f);
+
+   for (auto _ : state)
+   {
+      benchmark::DoNotOptimize(tempMonitor->submit(ssIds, temps));
+      for (auto& temp : temps)
+      {
+         temp = (temp > 70.0f) ? 30.0f : (temp + 0.1f);
+      }
+   }
+
+   // Per sample, comparable with BM_TempMonitorSubmit.
+   state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+BENCHMARK(BM_TempMonitorSubmitBatch)
+   ->Setup(startInProcessTempMonitor)
+   ->Teardown(stopTempMonitor)
+   ->Arg(8)
+   ->Arg(static_cast<int>(MAX_BATCH_SIZE))
+   ->UseRealTime();
+
+static void BM_SharedTempTablePublish(benchmark::State& state)
+{
+   SharedTempTable sensor{ SHARED_TABLE_NAME };
+   if (GeneralConstants::ReturnCodes::SUCCESS != sensor.open())
+   {
+      state.SkipWithError("Shared temp table is not available.");
+      return;
+   }
+
+   float temp{ 30.0f };
+   for (auto _ : state)
+   {
+      sensor.publish(0, SUB_SYSTEM_IDS[0], temp);
+      temp = (temp > 70.0f) ? 30.0f : (temp + 0.1f);
+   }
+
+   state.SetItemsProcessed(state.iterations());
+   state.SetLabel((TempMonitorConfig::SharedTableWait::FUTEX == static_cast<TempMonitorConfig::SharedTableWait>(state.range(0))) ? "FUTEX" : "POLL");
+}
+
+BENCHMARK(BM_SharedTempTablePublish)
+   ->Setup(startSharedTableTempMonitor)
+   ->Teardown(stopTempMonitor)
+   ->Arg(static_cast<int>(TempMonitorConfig::SharedTableWait::FUTEX))
+   ->Arg(static_cast<int>(TempMonitorConfig::SharedTableWait::POLL))
+   ->UseRealTime();
\ No newline at end of file
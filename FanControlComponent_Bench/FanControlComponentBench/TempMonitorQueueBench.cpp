@@ -0,0 +1,171 @@
+/*
+* File: TempMonitorQueueBench
+*
+* Description: Compares the TempMonitor ingestion path before and after the
+*     switch to a lock-free ring: std::queue + mutex + condition_variable
+*     versus MpscRingBuffer + EventCount. One consumer thread drains the queue
+*     while 1..N producer threads (the gRPC handler threads) push samples.
+*
+*/
+
+#include "benchmark/benchmark.h"
+#include "EventCount.h"
+#include "MpscRingBuffer.h"
+
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace
+{
+   struct QueueElement
+   {
+      int   subSysId{ INT_MIN };
+      float temp{ 0.0f };
+   };
+
+   //
+   // Original TempMonitor ingestion: every push takes the mutex and signals the cv.
+   //
+   class MutexQueue final
+   {
+      std::queue<QueueElement> queue;
+      std::mutex               mux;
+      std::condition_variable  cond;
+      bool                     keepAlive{ true };
+      std::thread              consumer;
+
+      void consumerThread()
+      {
+         std::unique_lock<std::mutex> lock(mux);
+         while (keepAlive)
+         {
+            cond.wait(lock, [this]() { return !queue.empty() || !keepAlive; });
+            while (!queue.empty())
+            {
+               benchmark::DoNotOptimize(queue.front());
+               queue.pop();
+            }
+         }
+      }
+
+   public:
+      MutexQueue() : consumer(&MutexQueue::consumerThread, this) {}
+      ~MutexQueue()
+      {
+         {
+            std::lock_guard<std::mutex> lock(mux);
+            keepAlive = false;
+         }
+         cond.notify_one();
+         consumer.join();
+      }
+
+      void push(const QueueElement& elem)
+      {
+         {
+            std::lock_guard<std::mutex> lock(mux);
+            queue.push(elem);
+         }
+         cond.notify_one();
+      }
+   };
+
+   //
+   // Current TempMonitor ingestion: lock-free ring, consumer only woken when asleep.
+   //
+   class RingQueue final
+   {
+      MpscRingBuffer<QueueElement> queue{ 4096 };
+      EventCount                   signal;
+      std::atomic<bool>            keepAlive{ true };
+      std::thread                  consumer;
+
+      void consumerThread()
+      {
+         QueueElement elem;
+         while (keepAlive.load(std::memory_order_acquire))
+         {
+            if (queue.tryPop(elem))
+            {
+               benchmark::DoNotOptimize(elem);
+               continue;
+            }
+
+            const auto key{ signal.prepareWait() };
+            if (!queue.empty() || !keepAlive.load(std::memory_order_acquire))
+            {
+               signal.cancelWait();
+            }
+            else
+            {
+               signal.commitWait(key);
+            }
+         }
+      }
+
+   public:
+      RingQueue() : consumer(&RingQueue::consumerThread, this) {}
+      ~RingQueue()
+      {
+         keepAlive.store(false, std::memory_order_release);
+         signal.notify();
+         consumer.join();
+      }
+
+      void push(const QueueElement& elem)
+      {
+         // The service rejects when full; here we retry so both queues do the same work.
+         while (!queue.tryPush(elem))
+         {
+            std::this_thread::yield();
+         }
+         signal.notify();
+      }
+   };
+
+   template <typename Q>
+   std::unique_ptr<Q> activeQueue;
+
+   template <typename Q>
+   void startConsumer(const benchmark::State&)
+   {
+      activeQueue<Q> = std::make_unique<Q>();
+   }
+
+   template <typename Q>
+   void stopConsumer(const benchmark::State&)
+   {
+      activeQueue<Q>.reset();
+   }
+}
+
+template <typename Q>
+static void BM_TempMonitorIngest(benchmark::State& state)
+{
+   auto& queue{ *activeQueue<Q> };
+   const QueueElement elem{ static_cast<int>(state.thread_index()), 42.0f };
+
+   for (auto _ : state)
+   {
+      queue.push(elem);
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_TempMonitorIngest, MutexQueue)
+   ->Setup(startConsumer<MutexQueue>)
+   ->Teardown(stopConsumer<MutexQueue>)
+   ->ThreadRange(1, 16)
+   ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_TempMonitorIngest, RingQueue)
+   ->Setup(startConsumer<RingQueue>)
+   ->Teardown(stopConsumer<RingQueue>)
+   ->ThreadRange(1, 16)
+   ->UseRealTime();
@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "log.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+   size_t countOccurrences(const std::string& text, const std::string& pattern)
+   {
+      size_t count{ 0 };
+      for (auto pos{ text.find(pattern) }; std::string::npos != pos; pos = text.find(pattern, pos + pattern.size()))
+      {
+         ++count;
+      }
+      return count;
+   }
+
+   void logRateLimited(int value)
+   {
+      LOG_RATE_LIMITED(LogLevel::WARN, 50, "AsyncLoggerUT rate limited [{}]", value);
+   }
+}
+
+TEST(AsyncLoggerUT, FormatsArgs)
+{
+   std::ostringstream out;
+   AsyncLogger::instance().setSink(out);
+
+   LOG_INFO("AsyncLoggerUT format int=[{}] float=[{}] bool=[{}] str=[{}]", -7, 1.5f, true, "abc");
+   LOG_INFO("AsyncLoggerUT no args {}");
+   AsyncLogger::instance().flush();
+   AsyncLogger::instance().setSink(std::cout);
+
+   const auto text{ out.str() };
+   ASSERT_NE(std::string::npos, text.find("AsyncLoggerUT format int=[-7] float=[1.5] bool=[true] str=[abc]\n"));
+   ASSERT_NE(std::string::npos, text.find("AsyncLoggerUT no args {}\n"));
+}
+
+TEST(AsyncLoggerUT, RateLimitedSiteCountsSuppressed)
+{
+   std::ostringstream out;
+   AsyncLogger::instance().setSink(out);
+
+   for (int idx{ 0 }; idx < 100; ++idx)
+   {
+      logRateLimited(idx);
+   }
+   AsyncLogger::instance().flush();
+   ASSERT_EQ(1, countOccurrences(out.str(), "AsyncLoggerUT rate limited"));
+   ASSERT_NE(std::string::npos, out.str().find("AsyncLoggerUT rate limited [0]\n"));
+
+   std::this_thread::sleep_for(std::chrono::milliseconds(60));
+   logRateLimited(100);
+   AsyncLogger::instance().flush();
+   AsyncLogger::instance().setSink(std::cout);
+
+   ASSERT_EQ(2, countOccurrences(out.str(), "AsyncLoggerUT rate limited"));
+   ASSERT_NE(std::string::npos, out.str().find("AsyncLoggerUT rate limited [100] [99 similar messages suppressed]\n"));
+}
+
+TEST(AsyncLoggerUT, ThreadsAreMergedInOrder)
+{
+   constexpr int NUM_THREADS{ 4 };
+   constexpr int NUM_RECORDS{ 100 };
+
+   std::ostringstream out;
+   AsyncLogger::instance().setSink(out);
+
+   std::vector<std::thread> threads;
+   for (int threadIdx{ 0 }; threadIdx < NUM_THREADS; ++threadIdx)
+   {
+      threads.emplace_back([threadIdx]()
+      {
+         for (int idx{ 0 }; idx < NUM_RECORDS; ++idx)
+         {
+            LOG_INFO("AsyncLoggerUT thread [{}] record [{}]", threadIdx, idx);
+         }
+      });
+   }
+   for (auto& thread : threads)
+   {
+      thread.join();
+   }
+   AsyncLogger::instance().flush();
+   AsyncLogger::instance().setSink(std::cout);
+
+   // Every record is written once, and each thread's records stay in order.
+   const auto text{ out.str() };
+   ASSERT_EQ(NUM_THREADS * NUM_RECORDS, countOccurrences(text, "AsyncLoggerUT thread ["));
+   for (int threadIdx{ 0 }; threadIdx < NUM_THREADS; ++threadIdx)
+   {
+      size_t prevPos{ 0 };
+      for (int idx{ 0 }; idx < NUM_RECORDS; ++idx)
+      {
+         const auto pos{ text.find("AsyncLoggerUT thread [" + std::to_string(threadIdx) + "] record [" + std::to_string(idx) + "]\n") };
+         ASSERT_NE(std::string::npos, pos);
+         ASSERT_GE(pos, prevPos);
+         prevPos = pos;
+      }
+   }
+}
+
+TEST(AsyncLoggerUT, FullRingDropsAndCounts)
+{
+   constexpr size_t NUM_RECORDS{ 4 * AsyncLogger::RING_CAPACITY };
+
+   std::ostringstream out;
+   AsyncLogger::instance().setSink(out);
+   const auto droppedBefore{ AsyncLogger::instance().getDropped() };
+
+   // A fresh thread gets a fresh ring; logging much faster than the drain
+   // interval overflows it.
+   std::thread([]()
+   {
+      for (size_t idx{ 0 }; idx < NUM_RECORDS; ++idx)
+      {
+         LOG_INFO("AsyncLoggerUT flood [{}]", idx);
+      }
+   }).join();
+   AsyncLogger::instance().flush();
+   AsyncLogger::instance().setSink(std::cout);
+
+   const auto dropped{ AsyncLogger::instance().getDropped() - droppedBefore };
+   const auto text{ out.str() };
+   ASSERT_GT(dropped, 0);
+   ASSERT_EQ(NUM_RECORDS, countOccurrences(text, "AsyncLoggerUT flood [") + dropped);
+   ASSERT_NE(std::string::npos, text.find("log records dropped, log ring full."));
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+#include "AsyncTempSender.h"
+#include "TempMonitor.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+   // Replies are reaped on the sender's thread, wait for them to be counted.
+   AsyncTempSender::Stats waitForReplies(const AsyncTempSender& sender)
+   {
+      auto stats{ sender.getStats() };
+      for (int x{ 0 }; (x < 2000) && (stats.sent != (stats.completed + stats.failed)); ++x)
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         stats = sender.getStats();
+      }
+      return stats;
+   }
+}
+
+TEST(AsyncTempSenderUT, BoundsRpcsInFlight)
+{
+   constexpr size_t MAX_IN_FLIGHT{ 4 };
+   constexpr int    NUM_TEMPS{ 1000 };
+
+   const std::vector<int> ssIds{ 1, 2, 3 };
+   TempMonitor tm{ ssIds };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+   AsyncTempSender sender{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()), MAX_IN_FLIGHT };
+
+   // send() never waits: a temp either starts an RPC or is rejected.
+   int accepted{ 0 };
+   for (int x{ 0 }; x < NUM_TEMPS; ++x)
+   {
+      accepted += sender.send(ssIds[x % ssIds.size()], 30.0f) ? 1 : 0;
+   }
+
+   const auto stats{ waitForReplies(sender) };
+   ASSERT_EQ(static_cast<uint64_t>(accepted), stats.sent);
+   ASSERT_EQ(static_cast<uint64_t>(NUM_TEMPS), stats.sent + stats.rejected);
+   ASSERT_EQ(stats.sent, stats.completed);
+   ASSERT_EQ(0, stats.failed);
+   ASSERT_LE(1, stats.maxInFlight);
+   ASSERT_GE(MAX_IN_FLIGHT, stats.maxInFlight);
+
+   // Every slot is free again.
+   ASSERT_TRUE(sender.send(ssIds[0], 31.0f));
+}
+
+TEST(AsyncTempSenderUT, UnreachableServerFails)
+{
+   // Nothing listens on this port; the deadline bounds each RPC.
+   AsyncTempSender sender{ grpc::CreateChannel("localhost:1", grpc::InsecureChannelCredentials()), 2, 50 };
+
+   ASSERT_TRUE(sender.send(1, 30.0f));
+
+   const auto stats{ waitForReplies(sender) };
+   ASSERT_EQ(1, stats.sent);
+   ASSERT_EQ(0, stats.completed);
+   ASSERT_EQ(1, stats.failed);
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include "CoalescingTempTable.h"
+
+#include <thread>
+#include <vector>
+
+TEST(CoalescingTempTableUT, ctor)
+{
+   ASSERT_NO_THROW(
+   {
+      CoalescingTempTable table{ 130 };
+      ASSERT_EQ(130, table.getSize());
+      ASSERT_FALSE(table.anyDirty());
+   });
+}
+
+TEST(CoalescingTempTableUT, LatestValueWins)
+{
+   CoalescingTempTable table{ 10 };
+
+   // First store marks the slot dirty, the rest coalesce into it.
+   ASSERT_TRUE(table.store(3, 20.0f));
+   ASSERT_FALSE(table.store(3, 21.0f));
+   ASSERT_FALSE(table.store(3, 22.0f));
+   ASSERT_TRUE(table.anyDirty());
+
+   std::vector<std::pair<size_t, float>> swept;
+   ASSERT_EQ(1, table.sweep([&swept](size_t slot, float temp) { swept.emplace_back(slot, temp); }));
+   ASSERT_EQ(1, swept.size());
+   ASSERT_EQ(3, swept[0].first);
+   ASSERT_EQ(22.0f, swept[0].second);
+
+   ASSERT_FALSE(table.anyDirty());
+   ASSERT_EQ(0, table.sweep([](size_t, float) {}));
+
+   // Slot is clean again after the sweep.
+   ASSERT_TRUE(table.store(3, 23.0f));
+}
+
+TEST(CoalescingTempTableUT, SweepOnlyDirtySlots)
+{
+   CoalescingTempTable table{ 200 };
+
+   table.store(0, 1.0f);
+   table.store(64, 2.0f);
+   table.store(199, 3.0f);
+
+   std::vector<size_t> slots;
+   ASSERT_EQ(3, table.sweep([&slots](size_t slot, float) { slots.push_back(slot); }));
+   ASSERT_EQ((std::vector<size_t>{ 0, 64, 199 }), slots);
+   ASSERT_EQ(3.0f, table.load(199));
+}
+
+TEST(CoalescingTempTableUT, ConcurrentWriters)
+{
+   const int NUM_WRITERS{ 4 };
+   const int WRITES_PER_WRITER{ 10000 };
+
+   CoalescingTempTable table{ 8 };
+
+   std::vector<std::thread> writers;
+   for (int w{ 0 }; w < NUM_WRITERS; ++w)
+   {
+      writers.emplace_back([&table, WRITES_PER_WRITER]()
+      {
+         for (int x{ 1 }; x <= WRITES_PER_WRITER; ++x)
+         {
+            table.store(x % 8, static_cast<float>(x));
+         }
+      });
+   }
+
+   for (auto& writer : writers)
+   {
+      writer.join();
+   }
+
+   // Slot 0 holds one of the values written to it.
+   const auto temp{ static_cast<int>(table.load(0)) };
+   ASSERT_EQ(0, temp % 8);
+   ASSERT_LE(temp, WRITES_PER_WRITER);
+   ASSERT_EQ(8, table.sweep([](size_t, float) {}));
+}
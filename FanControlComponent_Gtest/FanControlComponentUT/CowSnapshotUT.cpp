@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include "CowSnapshot.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(CowSnapshotUT, ReadUpdate)
+{
+   CowSnapshot<std::vector<int>> snapshot;
+
+   snapshot.read([](const std::vector<int>& values) { ASSERT_TRUE(values.empty()); });
+
+   ASSERT_TRUE(snapshot.update([](std::vector<int>& values) { values.push_back(1); return true; }));
+   ASSERT_FALSE(snapshot.update([](std::vector<int>& values) { values.push_back(2); return false; }));
+
+   snapshot.read([](const std::vector<int>& values) { ASSERT_EQ(std::vector<int>{ 1 }, values); });
+}
+
+TEST(CowSnapshotUT, ReadersSeeConsistentSnapshots)
+{
+   const int NUM_READERS{ 4 };
+   const int NUM_UPDATES{ 2000 };
+
+   // Every published snapshot holds N copies of the value N.
+   CowSnapshot<std::vector<int>> snapshot;
+   std::atomic<bool> done{ false };
+   std::atomic<int>  badReads{ 0 };
+
+   std::vector<std::thread> readers;
+   for (int r{ 0 }; r < NUM_READERS; ++r)
+   {
+      readers.emplace_back([&]()
+      {
+         while (!done.load())
+         {
+            snapshot.read([&badReads](const std::vector<int>& values)
+            {
+               for (auto value : values)
+               {
+                  if (value != static_cast<int>(values.size()))
+                  {
+                     ++badReads;
+                  }
+               }
+            });
+         }
+      });
+   }
+
+   for (int x{ 1 }; x <= NUM_UPDATES; ++x)
+   {
+      snapshot.update([x](std::vector<int>& values)
+      {
+         values.assign(static_cast<size_t>(x % 64), x % 64);
+         return true;
+      });
+   }
+
+   done.store(true);
+   for (auto& reader : readers)
+   {
+      reader.join();
+   }
+   ASSERT_EQ(0, badReads);
+}
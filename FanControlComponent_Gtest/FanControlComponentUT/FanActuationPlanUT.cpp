@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include "FanActuationPlan.h"
+
+TEST(FanActuationPlanUT, CompileApply)
+{
+   std::vector<int> fanIds{ 8, 6, 2, 4 };
+   uint32_t         mockRegisters[4]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+   for (int x{ 0 }; x < 4; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+   const std::unordered_map<int, int> multipliers{ { 8, 3 }, { 6, 8 }, { 2, 2 }, { 4, 6 } };
+
+   FanRegisters     fr{ FanIdMemAddresses };
+   FanActuationPlan plan;
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, plan.compile(fanIds, fr, multipliers));
+   ASSERT_EQ(4, plan.size());
+
+   plan.apply(50);
+   for (int x{ 0 }; x < 4; ++x)
+   {
+      ASSERT_EQ(50 * multipliers.at(fanIds[x]), mockRegisters[x]);
+      ASSERT_EQ(fanIds[x], plan.getFanId(x));
+      ASSERT_EQ(static_cast<int>(mockRegisters[x]), plan.getPwmc(x, 50));
+   }
+   ASSERT_EQ(4, fr.getWriteStats().written);
+
+   // Same duty cycle again: every write is elided.
+   mockRegisters[0] = 0;
+   plan.apply(50);
+   ASSERT_EQ(0, mockRegisters[0]);
+   ASSERT_EQ(4, fr.getWriteStats().written);
+   ASSERT_EQ(4, fr.getWriteStats().elided);
+
+   fr.refresh();
+   ASSERT_EQ(50 * multipliers.at(fanIds[0]), mockRegisters[0]);
+}
+
+TEST(FanActuationPlanUT, CompileErrors)
+{
+   uint32_t mockRegister{ 0 };
+   std::unordered_map<int, uint64_t> FanIdMemAddresses{ { 1, reinterpret_cast<uint64_t>(&mockRegister) } };
+   FanRegisters     fr{ FanIdMemAddresses };
+   FanActuationPlan plan;
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::UNKNOWN_FAN_ID, plan.compile({ 1, 2 }, fr, { { 1, 5 }, { 2, 5 } }));
+   ASSERT_EQ(0, plan.size());
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::NO_FAN_MULTIPLIER, plan.compile({ 1 }, fr, { { 2, 5 } }));
+   ASSERT_EQ(0, plan.size());
+}
@@ -1,6 +1,11 @@
 #include "gtest/gtest.h"
 #include "FanControl.h"
 #include "FanConstants.h"
+#include "FanPwmcTables.h"
+#include "SubSystem.h"
+#include "TripleBuffer.h"
+
+#include <algorithm>
 
 TEST(FanControlUT, ctor)
 {
@@ -72,4 +77,331 @@ TEST(FanControlUT, NewMaxTemp)
    auto rVal2{ mockRegisters[idx] };
    ASSERT_EQ( rVal, rVal2 ) << "rVal=[" << rVal << "], rVal2=[" << rVal2 << "]";
 
+}
+
+TEST(FanControlUT, FixedRateInvalidPeriod)
+{
+   std::vector<int> subSystemIds{ 1 };
+   std::vector<int> fanIds{ 8 };
+   uint32_t         mockRegisters[1]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses{ { fanIds[0], reinterpret_cast<uint64_t>(&(mockRegisters[0])) } };
+
+   FanControlConfig config;
+   config.controlMode = FanControlConfig::ControlMode::FIXED_RATE;
+   config.controlPeriodMs = 0;
+
+   FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, nullptr, config);
+   ASSERT_EQ(GeneralConstants::ReturnCodes::FAN_CONTROL_INVALID_CONFIG, fanCntrl.initialize());
+}
+
+TEST(FanControlUT, FixedRateCoalescesNotifications)
+{
+   std::vector<int> subSystemIds{ 1, 2, 3, 4,  5,  6,  7,  8,  9, 10 };
+   std::vector<int> fanIds{ 8, 6, 2, 4, 20, 18, 14, 16, 10, 12 };
+   uint32_t         mockRegisters[10]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+
+   for (int x{ 0 }; x < 10; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+
+   FanControlConfig config;
+   config.controlMode = FanControlConfig::ControlMode::FIXED_RATE;
+   config.controlPeriodMs = 20;
+
+   FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, nullptr, config);
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fanCntrl.initialize());
+
+   // A burst well inside one period: at most two ticks can see it.
+   constexpr int NUM_NOTIFICATIONS{ 500 };
+   for (int x{ 0 }; x < NUM_NOTIFICATIONS; ++x)
+   {
+      fanCntrl.notifyNewMaxTemp( 30.0f + (x % 40) );
+   }
+   fanCntrl.notifyNewMaxTemp( 71.94f );
+
+   std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+   auto stats{ fanCntrl.getControlLoopStats() };
+   ASSERT_LE(3u, stats.ticks);
+   ASSERT_LE(1u, stats.actuations);
+   ASSERT_GE(2u, stats.actuations);
+   ASSERT_EQ(NUM_NOTIFICATIONS + 1, stats.actuations + stats.coalescedNotifications);
+   ASSERT_GE(stats.maxLatenessUs, stats.meanLatenessUs);
+
+   auto multiplier{ FanConstants::FAN_PWMC_PROPORTIONALITY.find(fanIds[5])->second };
+   ASSERT_EQ(95u * multiplier, mockRegisters[5]);
+}
+
+
+TEST(FanControlUT, RegisterRefreshUnderSteadyLoad)
+{
+   std::vector<int> subSystemIds{ 1 };
+   std::vector<int> fanIds{ 8, 6 };
+   uint32_t         mockRegisters[2]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+   for (int x{ 0 }; x < 2; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+
+   const auto expected{ static_cast<uint32_t>(95 * FanConstants::FAN_PWMC_PROPORTIONALITY.at(fanIds[1])) };
+   volatile uint32_t& reg{ mockRegisters[1] };
+
+   for (auto mode : { FanControlConfig::ControlMode::EVENT, FanControlConfig::ControlMode::FIXED_RATE })
+   {
+      FanControlConfig config;
+      config.controlMode       = mode;
+      config.controlPeriodMs   = 5;
+      config.registerRefreshMs = 50;
+
+      FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, nullptr, config);
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fanCntrl.initialize());
+
+      // Same duty cycle every time, so every write after the first is elided.
+      auto notifyFor = [&fanCntrl, &reg, expected](int ms)
+      {
+         for (int x{ 0 }; (x < ms) && (expected != reg); ++x)
+         {
+            fanCntrl.notifyNewMaxTemp( (0 == (x % 2)) ? 71.94f : 71.95f );
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         }
+      };
+
+      notifyFor(200);
+      ASSERT_EQ(expected, reg);
+
+      // The register loses its value; only the forced refresh restores it.
+      reg = 0;
+      notifyFor(500);
+      ASSERT_EQ(expected, reg);
+   }
+
+   FanControlConfig config;
+   config.registerRefreshMs = 0;
+   FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, nullptr, config);
+   ASSERT_EQ(GeneralConstants::ReturnCodes::FAN_CONTROL_INVALID_CONFIG, fanCntrl.initialize());
+}
+
+TEST(FanControlUT, ThermalZonesInvalidConfig)
+{
+   std::vector<int> subSystemIds{ 1, 2 };
+   std::vector<int> fanIds{ 8, 6 };
+   uint32_t         mockRegisters[2]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+   for (int x{ 0 }; x < 2; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+
+   FanControlConfig config;
+
+   // Fan in two zones.
+   config.thermalZones = { { 1, { 1 }, { 8 } }, { 2, { 2 }, { 8 } } };
+   {
+      FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, nullptr, config);
+      ASSERT_EQ(GeneralConstants::ReturnCodes::FAN_CONTROL_INVALID_CONFIG, fanCntrl.initialize());
+   }
+
+   // Fan that is not a FanControl fan.
+   config.thermalZones = { { 1, { 1 }, { 4 } } };
+   {
+      FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, nullptr, config);
+      ASSERT_EQ(GeneralConstants::ReturnCodes::FAN_CONTROL_INVALID_CONFIG, fanCntrl.initialize());
+   }
+}
+
+TEST(FanControlUT, ThermalZonesDriveTheirFans)
+{
+   std::vector<int> subSystemIds{ 1, 2, 3 };
+   std::vector<int> fanIds{ 8, 6, 2 };
+   uint32_t         mockRegisters[3]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+   for (int x{ 0 }; x < 3; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+
+   // Fan 8 follows subsystem 1, fan 6 follows subsystem 2, fan 2 the global max.
+   FanControlConfig config;
+   config.thermalZones = { { 1, { 1 }, { 8 } }, { 2, { 2 }, { 6 } } };
+
+   FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, nullptr, config);
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fanCntrl.initialize());
+
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   SubSystem ss1(channel, subSystemIds[0]);
+   SubSystem ss2(channel, subSystemIds[1]);
+   ss1.sendTemp(30.0f);
+   ss2.sendTemp(70.0f);
+
+   auto expected = [](int fanId, float temp)
+   {
+      return static_cast<uint32_t>(FanPwmcTables::getDutyCycle(temp) * FanConstants::FAN_PWMC_PROPORTIONALITY.at(fanId));
+   };
+
+   for (int x{ 0 }; (x < 200) && ((expected(8, 30.0f) != mockRegisters[0]) || (expected(6, 70.0f) != mockRegisters[1]) ||
+                                  (expected(2, 70.0f) != mockRegisters[2])); ++x)
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+
+   ASSERT_EQ(expected(8, 30.0f), mockRegisters[0]);
+   ASSERT_EQ(expected(6, 70.0f), mockRegisters[1]);
+   ASSERT_EQ(expected(2, 70.0f), mockRegisters[2]);
+}
+
+TEST(FanControlUT, TracedSampleLatencyRecorded)
+{
+   std::vector<int> subSystemIds{ 1, 2 };
+   std::vector<int> fanIds{ 8, 6 };
+   uint32_t         mockRegisters[2]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+   for (int x{ 0 }; x < 2; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+
+   // Fan 6 is in a zone, so both the fanThread and a FanGroup record.
+   FanControlConfig config;
+   config.thermalZones = { { 1, { 2 }, { 6 } } };
+
+   FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, nullptr, config);
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fanCntrl.initialize());
+
+   const auto& latency{ fanCntrl.getLatencyRecorder() };
+   const auto startNs{ SampleTrace::nowNs() };
+
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   SubSystem ss2(channel, subSystemIds[1]);
+   ss2.sendTemp(65.0f);
+
+   for (int x{ 0 }; (x < 200) && (latency.getHistogram(LatencyStage::END_TO_END).getCount() < 2); ++x)
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+   const auto elapsedNs{ static_cast<uint64_t>(SampleTrace::nowNs() - startNs) };
+
+   ASSERT_EQ(1u, latency.getHistogram(LatencyStage::SENSOR_TO_INGEST).getCount());
+   ASSERT_EQ(1u, latency.getHistogram(LatencyStage::INGEST_TO_PROCESS).getCount());
+
+   // Once per actuation: the global fans and the zone's FanGroup.
+   for (const auto stage : { LatencyStage::PROCESS_TO_NOTIFY, LatencyStage::NOTIFY_TO_WRITE, LatencyStage::END_TO_END })
+   {
+      ASSERT_EQ(2u, latency.getHistogram(stage).getCount()) << LatencyRecorder::getStageName(stage);
+   }
+
+   const auto& endToEnd{ latency.getHistogram(LatencyStage::END_TO_END) };
+   ASSERT_LT(0u, endToEnd.getMin());
+   ASSERT_GE(elapsedNs, endToEnd.getMax());
+   ASSERT_LE(latency.getHistogram(LatencyStage::SENSOR_TO_INGEST).getMax(), endToEnd.getMax());
+}
+
+
+namespace
+{
+   class MockUiUpdater final : public UiUpdater
+   {
+   public:
+      TripleBuffer<UiUpdater::FanData> fanDataBuffer;
+
+      void updateSubSystemTemp(int, float) override {}
+      void updateFanData(const UiUpdater::FanData& fandata) override
+      {
+         fanDataBuffer.getWriteBuffer() = fandata;
+         fanDataBuffer.publish();
+      }
+   };
+}
+
+TEST(FanControlUT, UiUpdaterReceivesFanData)
+{
+   std::vector<int> subSystemIds{ 1, 2, 3 };
+   std::vector<int> fanIds{ 8, 6, 2, 4 };
+   uint32_t         mockRegisters[4]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+
+   for (int x{ 0 }; x < 4; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+
+   MockUiUpdater uiUpdater;
+   FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, &uiUpdater);
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fanCntrl.initialize());
+
+   fanCntrl.notifyNewMaxTemp( 71.94f );
+   std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+   ASSERT_TRUE(uiUpdater.fanDataBuffer.update());
+   const auto& fanData{ uiUpdater.fanDataBuffer.getReadBuffer() };
+   ASSERT_EQ(71.94f, fanData.temp);
+   ASSERT_EQ(fanIds.size(), fanData.numFans);
+
+   for (size_t idx{ 0 }; idx < fanData.numFans; ++idx)
+   {
+      const auto fanItr{ std::find(fanIds.begin(), fanIds.end(), fanData.fans[idx].fanId) };
+      ASSERT_NE(fanIds.end(), fanItr);
+      ASSERT_EQ(mockRegisters[fanItr - fanIds.begin()], static_cast<uint32_t>(fanData.fans[idx].pwmc));
+   }
+}
+
+TEST(FanControlUT, UiUpdaterReceivesZoneFanData)
+{
+   std::vector<int> subSystemIds{ 1, 2, 3 };
+   std::vector<int> fanIds{ 8, 6, 2 };
+   uint32_t         mockRegisters[3]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+   for (int x{ 0 }; x < 3; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+
+   // Fan 6 is driven by its FanGroup, fans 8 and 2 by the fanThread.
+   FanControlConfig config;
+   config.thermalZones = { { 1, { 2 }, { 6 } } };
+
+   MockUiUpdater uiUpdater;
+   FanControl fanCntrl(subSystemIds, fanIds, FanIdMemAddresses, &uiUpdater, config);
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fanCntrl.initialize());
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fanCntrl.getTempMonitor().submit(subSystemIds[1], 70.0f));
+
+   const auto expectedPwmc{ static_cast<int>(FanPwmcTables::getDutyCycle(70.0f) * FanConstants::FAN_PWMC_PROPORTIONALITY.at(6)) };
+   auto getPwmc = [](const UiUpdater::FanData& fanData, int fanId)
+   {
+      const auto end{ fanData.fans.begin() + fanData.numFans };
+      const auto fanItr{ std::find_if(fanData.fans.begin(), end, [fanId](const UiUpdater::FanPwmc& fan) { return fan.fanId == fanId; }) };
+      return (end == fanItr) ? -1 : fanItr->pwmc;
+   };
+
+   auto haveZoneFan = [&]()
+   {
+      uiUpdater.fanDataBuffer.update();
+      const auto& fanData{ uiUpdater.fanDataBuffer.getReadBuffer() };
+      return (expectedPwmc == getPwmc(fanData, 6)) && (70.0f == fanData.temp);
+   };
+   for (int x{ 0 }; (x < 200) && !haveZoneFan(); ++x)
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+
+   const auto& fanData{ uiUpdater.fanDataBuffer.getReadBuffer() };
+   // The zone fan is reported alongside the fanThread's fans.
+   ASSERT_EQ(fanIds.size(), fanData.numFans);
+   ASSERT_EQ(70.0f, fanData.temp);
+   ASSERT_EQ(expectedPwmc, getPwmc(fanData, 6));
+   for (int x{ 0 }; x < 3; ++x)
+   {
+      ASSERT_EQ(mockRegisters[x], static_cast<uint32_t>(getPwmc(fanData, fanIds[x])));
+   }
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "FanGroup.h"
+#include "FanConstants.h"
+#include "FanPwmcTables.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+   // Registers are written by the group thread, after notifyNewMaxTemp returns.
+   uint32_t waitForRegister(const uint32_t& reg, uint32_t expected)
+   {
+      for (int x{ 0 }; (x < 100) && (expected != *static_cast<const volatile uint32_t*>(&reg)); ++x)
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      return *static_cast<const volatile uint32_t*>(&reg);
+   }
+}
+
+TEST(FanGroupUT, DrivesOnlyItsFans)
+{
+   std::vector<int> fanIds{ 1, 2, 3, 4 };
+   uint32_t         mockRegisters[4]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+   for (int x{ 0 }; x < 4; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+   FanRegisters fr{ FanIdMemAddresses };
+
+   FanGroup groupA{ { 1, { 1 }, { 1, 2 } } };
+   FanGroup groupB{ { 2, { 2 }, { 3, 4 } } };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, groupA.initialize(fr));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, groupB.initialize(fr));
+   ASSERT_EQ(1, groupA.getZoneId());
+
+   auto pwmc = [](int fanId, float temp)
+   {
+      return FanPwmcTables::findPwmcRow(fanId)->at(static_cast<size_t>(FanPwmcTables::getDutyCycle(temp) - FanPwmcTables::DC_MIN));
+   };
+
+   const auto initialTemp{ static_cast<float>(FanConstants::INITIAL_FAN_DUTY_CYCLE) };
+   ASSERT_EQ(pwmc(1, initialTemp), mockRegisters[0]);
+   ASSERT_EQ(pwmc(4, initialTemp), mockRegisters[3]);
+
+   groupA.notifyNewMaxTemp(70.0f);
+   groupB.notifyNewMaxTemp(45.0f);
+
+   ASSERT_EQ(pwmc(1, 70.0f), waitForRegister(mockRegisters[0], pwmc(1, 70.0f)));
+   ASSERT_EQ(pwmc(2, 70.0f), waitForRegister(mockRegisters[1], pwmc(2, 70.0f)));
+   ASSERT_EQ(pwmc(3, 45.0f), waitForRegister(mockRegisters[2], pwmc(3, 45.0f)));
+   ASSERT_EQ(pwmc(4, 45.0f), waitForRegister(mockRegisters[3], pwmc(4, 45.0f)));
+
+   groupA.stop();
+   groupB.stop();
+   ASSERT_LE(2u, groupA.getActuations());
+}
+
+TEST(FanGroupUT, RegisterRefreshUnderSteadyLoad)
+{
+   std::vector<int> fanIds{ 1 };
+   uint32_t         mockRegisters[1]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses{ { fanIds[0], reinterpret_cast<uint64_t>(&(mockRegisters[0])) } };
+   FanRegisters fr{ FanIdMemAddresses };
+
+   FanGroup group{ { 1, { 1 }, { 1 } }, nullptr, 50 };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, group.initialize(fr));
+
+   const auto expected{ FanPwmcTables::findPwmcRow(1)->at(static_cast<size_t>(FanPwmcTables::getDutyCycle(70.0f) - FanPwmcTables::DC_MIN)) };
+   volatile uint32_t& reg{ mockRegisters[0] };
+
+   // Same duty cycle every time, so every write after the first is elided.
+   auto notifyFor = [&group, &reg, expected](int ms)
+   {
+      for (int x{ 0 }; (x < ms) && (expected != reg); ++x)
+      {
+         group.notifyNewMaxTemp(70.0f);
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+   };
+
+   notifyFor(200);
+   ASSERT_EQ(expected, reg);
+
+   // The register loses its value; only the forced refresh restores it.
+   reg = 0;
+   notifyFor(500);
+   ASSERT_EQ(expected, reg);
+
+   group.stop();
+}
+
+TEST(FanGroupUT, UnknownFan)
+{
+   uint32_t mockRegisters[1]{ 0 };
+   std::unordered_map<int, uint64_t> FanIdMemAddresses{ { 1, reinterpret_cast<uint64_t>(&(mockRegisters[0])) } };
+   FanRegisters fr{ FanIdMemAddresses };
+
+   FanGroup group{ { 1, { 1 }, { 1, 2 } } };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::UNKNOWN_FAN_ID, group.initialize(fr));
+}
\ No newline at end of file
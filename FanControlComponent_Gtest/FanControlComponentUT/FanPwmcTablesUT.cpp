@@ -0,0 +1,34 @@
+#include "gtest/gtest.h"
+#include "FanPwmcTables.h"
+
+#include <cmath>
+#include <limits>
+
+TEST(FanPwmcTablesUT, DutyCycleMatchesTempToDutyCycle)
+{
+   // At every table step the lookup equals the rounded runtime calculation.
+   for (size_t step{ 0 }; step < FanPwmcTables::NUM_TEMP_STEPS; ++step)
+   {
+      const auto temp{ TempToDutyCycle::TEMP_MIN + (static_cast<float>(step) / FanPwmcTables::TEMP_STEPS_PER_DEGREE) };
+      ASSERT_EQ(static_cast<int>(std::round(TempToDutyCycle::getDutyCycle(temp))), FanPwmcTables::getDutyCycle(temp)) << "temp=" << temp;
+   }
+
+   ASSERT_EQ(95, FanPwmcTables::getDutyCycle(71.94f));
+   ASSERT_EQ(FanPwmcTables::DC_MIN, FanPwmcTables::getDutyCycle(-40.0f));
+   ASSERT_EQ(FanPwmcTables::DC_MAX, FanPwmcTables::getDutyCycle(150.0f));
+   ASSERT_EQ(FanPwmcTables::DC_MAX, FanPwmcTables::getDutyCycle(std::numeric_limits<float>::quiet_NaN()));
+}
+
+TEST(FanPwmcTablesUT, PwmcRows)
+{
+   for (const auto& [fanId, multiplier] : FanConstants::FAN_PWMC_PROPORTIONALITY_TABLE)
+   {
+      const auto row{ FanPwmcTables::findPwmcRow(fanId) };
+      ASSERT_NE(nullptr, row);
+      for (int dc{ FanPwmcTables::DC_MIN }; dc <= FanPwmcTables::DC_MAX; ++dc)
+      {
+         ASSERT_EQ(static_cast<uint32_t>(dc * multiplier), (*row)[dc - FanPwmcTables::DC_MIN]);
+      }
+   }
+   ASSERT_EQ(nullptr, FanPwmcTables::findPwmcRow(99));
+}
@@ -46,4 +46,81 @@ TEST(FanRegistersUT, ReadWriteClear)
       ASSERT_EQ(0, mockRegisters[x]);
       ASSERT_EQ(0, fr.readRegister(fanIds[x]));
    }
-}
\ No newline at end of file
+}
+
+TEST(FanRegistersUT, ShadowWriteElision)
+{
+   uint32_t mockRegisters[2]{ 0 };
+   std::unordered_map<int, uint64_t> FanIdMemAddresses
+   {
+        { 1, reinterpret_cast<uint64_t>(&(mockRegisters[0])) }
+      , { 2, reinterpret_cast<uint64_t>(&(mockRegisters[1])) }
+   };
+
+   FanRegisters fr{ FanIdMemAddresses };
+
+   fr.writeRegister(1, 40);
+   fr.writeRegister(1, 40);
+   fr.writeRegister(1, 40);
+   ASSERT_EQ(1, fr.getWriteStats().written);
+   ASSERT_EQ(2, fr.getWriteStats().elided);
+
+   // Register lost its value behind our back: elided until forced or refreshed.
+   mockRegisters[0] = 7;
+   fr.writeRegister(1, 40);
+   ASSERT_EQ(7, mockRegisters[0]);
+
+   fr.refresh();
+   ASSERT_EQ(40, mockRegisters[0]);
+   ASSERT_EQ(0, mockRegisters[1]); // Never written, not refreshed.
+   ASSERT_EQ(2, fr.getWriteStats().written);
+
+   mockRegisters[0] = 7;
+   fr.writeRegister(1, 40, true);
+   ASSERT_EQ(40, mockRegisters[0]);
+   ASSERT_EQ(3, fr.getWriteStats().written);
+   ASSERT_EQ(3, fr.getWriteStats().elided);
+}
+
+
+TEST(FanRegistersUT, WriteRegistersBatch)
+{
+   std::vector<int> fanIds{ 8, 6, 2, 4, 20, 18, 14, 16, 10, 12 };
+   uint32_t         mockRegisters[10]{ 0 };
+
+   std::unordered_map<int, uint64_t> FanIdMemAddresses;
+
+   for (int x{ 0 }; x < 10; ++x)
+   {
+      FanIdMemAddresses[fanIds[x]] = reinterpret_cast<uint64_t>(&(mockRegisters[x]));
+   }
+
+   FanRegisters fr{ FanIdMemAddresses };
+
+   std::vector<FanRegisters::FanWrite> writes;
+   for (int x{ 9 }; x >= 0; --x)
+   {
+      writes.push_back({ fanIds[x], static_cast<uint32_t>(x + 100) });
+   }
+   writes.push_back({ 99, 1 });          // Unknown fan, ignored.
+   writes.push_back({ fanIds[3], 42 });  // Last write to a fan wins.
+
+   fr.writeRegisters(writes);
+
+   for (int x{ 0 }; x < 10; ++x)
+   {
+      ASSERT_EQ((3 == x) ? 42u : static_cast<uint32_t>(x + 100), mockRegisters[x]);
+   }
+   ASSERT_EQ(10, fr.getWriteStats().written);
+   ASSERT_EQ(0, fr.getWriteStats().elided);
+
+   // Unchanged values are elided, unless forced.
+   fr.writeRegisters(std::span<const FanRegisters::FanWrite>(writes.data(), 2));
+   ASSERT_EQ(10, fr.getWriteStats().written);
+   ASSERT_EQ(2, fr.getWriteStats().elided);
+
+   mockRegisters[9] = 0;
+   fr.writeRegisters(std::span<const FanRegisters::FanWrite>(writes.data(), 1), true);
+   ASSERT_EQ(109u, mockRegisters[9]);
+   ASSERT_EQ(11, fr.getWriteStats().written);
+}
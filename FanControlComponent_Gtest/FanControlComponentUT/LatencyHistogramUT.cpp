@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "LatencyHistogram.h"
+#include "LatencyRecorder.h"
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST(LatencyHistogramUT, Empty)
+{
+   LatencyHistogram histogram;
+
+   ASSERT_EQ(0u, histogram.getCount());
+   ASSERT_EQ(0u, histogram.getMin());
+   ASSERT_EQ(0u, histogram.getMax());
+   ASSERT_EQ(0u, histogram.getMean());
+   ASSERT_EQ(0u, histogram.getPercentile(99.0));
+}
+
+TEST(LatencyHistogramUT, PercentilesWithinPrecision)
+{
+   LatencyHistogram histogram;
+
+   // 1us .. 1000us, one sample each.
+   for (uint64_t us{ 1 }; us <= 1000; ++us)
+   {
+      histogram.record(us * 1000);
+   }
+
+   ASSERT_EQ(1000u, histogram.getCount());
+   ASSERT_EQ(1'000u, histogram.getMin());
+   ASSERT_EQ(1'000'000u, histogram.getMax());
+   ASSERT_EQ(500'500u, histogram.getMean());
+
+   for (const auto percentile : { 50.0, 90.0, 99.0, 99.9 })
+   {
+      const auto expected{ static_cast<double>(percentile * 10'000.0) };
+      const auto actual{ static_cast<double>(histogram.getPercentile(percentile)) };
+      ASSERT_NEAR(expected, actual, expected / 64.0) << "percentile=" << percentile;
+   }
+   ASSERT_EQ(histogram.getMax(), histogram.getPercentile(100.0));
+}
+
+TEST(LatencyHistogramUT, SmallValuesAreExact)
+{
+   LatencyHistogram histogram;
+
+   for (uint64_t ns{ 0 }; ns < 128; ++ns)
+   {
+      histogram.record(ns);
+   }
+
+   ASSERT_EQ(0u, histogram.getPercentile(0.0));
+   ASSERT_EQ(63u, histogram.getPercentile(50.0));
+   ASSERT_EQ(127u, histogram.getPercentile(100.0));
+}
+
+TEST(LatencyHistogramUT, LargeValuesAreClamped)
+{
+   LatencyHistogram histogram;
+
+   histogram.record(UINT64_MAX);
+
+   ASSERT_EQ(LatencyHistogram::MAX_VALUE_NS, histogram.getMax());
+   ASSERT_EQ(LatencyHistogram::MAX_VALUE_NS, histogram.getPercentile(50.0));
+}
+
+TEST(LatencyHistogramUT, ConcurrentRecordAndReset)
+{
+   constexpr int NUM_THREADS{ 4 };
+   constexpr int NUM_SAMPLES{ 100'000 };
+
+   LatencyHistogram histogram;
+   std::vector<std::thread> threads;
+
+   for (int t{ 0 }; t < NUM_THREADS; ++t)
+   {
+      threads.emplace_back([&histogram]()
+      {
+         for (int x{ 0 }; x < NUM_SAMPLES; ++x)
+         {
+            histogram.record(static_cast<uint64_t>(x));
+         }
+      });
+   }
+   for (auto& thread : threads)
+   {
+      thread.join();
+   }
+
+   ASSERT_EQ(static_cast<uint64_t>(NUM_THREADS * NUM_SAMPLES), histogram.getCount());
+   ASSERT_EQ(static_cast<uint64_t>(NUM_SAMPLES - 1), histogram.getMax());
+
+   histogram.reset();
+   ASSERT_EQ(0u, histogram.getCount());
+   ASSERT_EQ(0u, histogram.getPercentile(50.0));
+}
+
+TEST(LatencyHistogramUT, RecorderStagesAndDump)
+{
+   LatencyRecorder recorder;
+
+   // Clock skew between sender and receiver is recorded as zero.
+   recorder.record(LatencyStage::SENSOR_TO_INGEST, 2'000, 1'000);
+   recorder.record(LatencyStage::INGEST_TO_PROCESS, 1'000, 5'000);
+
+   // Untraced samples are not recorded.
+   recorder.recordFanWrite(SampleTrace());
+
+   SampleTrace trace;
+   trace.sampleTimeNs  = SampleTrace::nowNs() - 1'000'000;
+   trace.ingestTimeNs  = trace.sampleTimeNs + 100;
+   trace.processTimeNs = trace.sampleTimeNs + 200;
+   trace.notifyTimeNs  = trace.sampleTimeNs + 500;
+   recorder.recordFanWrite(trace);
+
+   ASSERT_EQ(0u, recorder.getHistogram(LatencyStage::SENSOR_TO_INGEST).getMax());
+   ASSERT_EQ(4'000u, recorder.getHistogram(LatencyStage::INGEST_TO_PROCESS).getMax());
+   ASSERT_EQ(300u, recorder.getHistogram(LatencyStage::PROCESS_TO_NOTIFY).getMax());
+   ASSERT_EQ(1u, recorder.getHistogram(LatencyStage::NOTIFY_TO_WRITE).getCount());
+   ASSERT_LE(1'000'000u, recorder.getHistogram(LatencyStage::END_TO_END).getMax());
+
+   std::ostringstream os;
+   recorder.dump(os);
+   ASSERT_NE(std::string::npos, os.str().find("PROCESS_TO_NOTIFY: count=1 "));
+   ASSERT_NE(std::string::npos, os.str().find("END_TO_END: count=1 "));
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include "ListenerDispatcher.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+   class CountingListener final : public TempMonitorListener
+   {
+      const std::chrono::milliseconds delay;
+   public:
+      std::atomic<float> lastTemp{ 0.0f };
+      std::atomic<int>   calls{ 0 };
+
+      explicit CountingListener(std::chrono::milliseconds callbackDelay = std::chrono::milliseconds(0))
+         : delay(callbackDelay)
+      {};
+
+      void notifyNewMaxTemp(float temp)
+      {
+         std::this_thread::sleep_for(delay);
+         lastTemp = temp;
+         ++calls;
+      };
+
+      float waitForTemp(float expected)
+      {
+         for (int x{ 0 }; (x < 1000) && (expected != lastTemp); ++x)
+         {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         }
+         return lastTemp;
+      };
+   };
+};
+
+TEST(ListenerDispatcherUT, AddRemove)
+{
+   ListenerDispatcher dispatcher;
+   CountingListener   listener;
+
+   ASSERT_TRUE(dispatcher.add(listener));
+   ASSERT_FALSE(dispatcher.add(listener));
+   ASSERT_TRUE(dispatcher.remove(listener));
+   ASSERT_FALSE(dispatcher.remove(listener));
+
+   // Not called once removed.
+   dispatcher.publish(50.0f);
+   std::this_thread::sleep_for(std::chrono::milliseconds(10));
+   ASSERT_EQ(0, listener.calls);
+}
+
+TEST(ListenerDispatcherUT, SlowListenerSkipsIntermediateValues)
+{
+   ListenerDispatcher dispatcher;
+   CountingListener   fast;
+   CountingListener   slow{ std::chrono::milliseconds(20) };
+
+   ASSERT_TRUE(dispatcher.add(slow));
+   ASSERT_TRUE(dispatcher.add(fast));
+
+   // publish never waits on a listener.
+   const auto start{ std::chrono::steady_clock::now() };
+   for (int x{ 1 }; x <= 100; ++x)
+   {
+      dispatcher.publish(static_cast<float>(x));
+   }
+   ASSERT_GT(std::chrono::milliseconds(20), std::chrono::steady_clock::now() - start);
+
+   ASSERT_EQ(100.0f, fast.waitForTemp(100.0f));
+   ASSERT_EQ(100.0f, slow.waitForTemp(100.0f));
+   ASSERT_GT(10, slow.calls);
+
+   ASSERT_TRUE(dispatcher.remove(slow));
+   ASSERT_TRUE(dispatcher.remove(fast));
+}
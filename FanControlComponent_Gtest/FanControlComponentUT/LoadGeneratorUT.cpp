@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+#include "LoadGenerator.h"
+#include "TempMonitor.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+   class MaxTempListener final : public TempMonitorListener
+   {
+      std::atomic<float> curTemp{ 0 };
+   public:
+      void notifyNewMaxTemp(float temp) { curTemp = temp; };
+
+      float waitForTemp(float expected)
+      {
+         for (int x{ 0 }; (x < 500) && (expected != curTemp); ++x)
+         {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         }
+         return curTemp;
+      };
+   };
+
+   // Records every temp the generator produces, per subsystem id.
+   struct RecordingSink
+   {
+      std::mutex                                     mux;
+      std::unordered_map<int, std::vector<float>>    temps;
+
+      LoadGenerator::SampleSink get()
+      {
+         return [this](std::span<const int> ssIds, std::span<const float> ssTemps)
+         {
+            const std::lock_guard<std::mutex> lock(mux);
+            for (size_t idx{ 0 }; idx < ssIds.size(); ++idx)
+            {
+               temps[ssIds[idx]].push_back(ssTemps[idx]);
+            }
+         };
+      }
+   };
+
+   LoadGeneratorConfig makeConfig(size_t numSubSystems, uint32_t periodMs, SimulatedSubSystem::Waveform waveform)
+   {
+      LoadGeneratorConfig config;
+      for (size_t idx{ 0 }; idx < numSubSystems; ++idx)
+      {
+         SimulatedSubSystem subSystem;
+         subSystem.subSystemId  = static_cast<int>(idx) + 1;
+         subSystem.periodMs     = periodMs;
+         subSystem.waveform     = waveform;
+         subSystem.wavePeriodMs = 100;
+         subSystem.noise        = 0.5f;
+         config.subSystems.push_back(subSystem);
+      }
+      return config;
+   }
+}
+
+TEST(LoadGeneratorUT, InvalidConfig)
+{
+   RecordingSink sink;
+
+   auto config{ makeConfig(10, 10, SimulatedSubSystem::Waveform::SINE) };
+   config.subSystems[3].periodMs = 0;
+   LoadGenerator badPeriod{ config, sink.get() };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::LOAD_GENERATOR_INVALID_CONFIG, badPeriod.initialize());
+   ASSERT_EQ(GeneralConstants::ReturnCodes::LOAD_GENERATOR_INVALID_CONFIG, badPeriod.start());
+
+   config = makeConfig(10, 10, SimulatedSubSystem::Waveform::SINE);
+   config.numThreads = 0;
+   LoadGenerator noThreads{ config, sink.get() };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::LOAD_GENERATOR_INVALID_CONFIG, noThreads.initialize());
+
+   LoadGenerator noSink{ makeConfig(10, 10, SimulatedSubSystem::Waveform::SINE), LoadGenerator::SampleSink{} };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::LOAD_GENERATOR_INVALID_CONFIG, noSink.initialize());
+}
+
+TEST(LoadGeneratorUT, DrivesThousandsOfSubSystems)
+{
+   constexpr size_t   NUM_SUBSYSTEMS{ 5'000 };
+   constexpr uint32_t PERIOD_MS{ 20 };
+   constexpr int      RUN_MS{ 300 };
+
+   auto config{ makeConfig(NUM_SUBSYSTEMS, PERIOD_MS, SimulatedSubSystem::Waveform::SINE) };
+   config.numThreads = 2;
+
+   RecordingSink sink;
+   LoadGenerator generator{ config, sink.get() };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, generator.initialize());
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, generator.start());
+   std::this_thread::sleep_for(std::chrono::milliseconds(RUN_MS));
+   generator.stop();
+
+   // Every subsystem sends at its own rate, within the waveform's bounds.
+   ASSERT_EQ(NUM_SUBSYSTEMS, sink.temps.size());
+   size_t total{ 0 };
+   for (const auto& [ssid, temps] : sink.temps)
+   {
+      ASSERT_LE(RUN_MS / PERIOD_MS / 2, temps.size()) << "ssid=[" << ssid << "]";
+      ASSERT_GE((RUN_MS / PERIOD_MS) + 2, temps.size()) << "ssid=[" << ssid << "]";
+      for (auto temp : temps)
+      {
+         ASSERT_LE(30.0f - 5.5f, temp);
+         ASSERT_GE(30.0f + 5.5f, temp);
+      }
+      total += temps.size();
+   }
+
+   const auto stats{ generator.getStats() };
+   ASSERT_EQ(total, stats.samplesGenerated);
+   ASSERT_EQ(total, stats.samplesSent);
+   ASSERT_EQ(0, stats.sendFailures);
+}
+
+TEST(LoadGeneratorUT, SameSeedSameTemps)
+{
+   const auto config{ makeConfig(100, 5, SimulatedSubSystem::Waveform::RANDOM_WALK) };
+
+   RecordingSink first;
+   RecordingSink second;
+   for (auto sink : { &first, &second })
+   {
+      LoadGenerator generator{ config, sink->get() };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, generator.initialize());
+      generator.start();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+   }
+
+   // Temps only depend on the seed and the tick they were due on, not on
+   // when the engine thread woke up.
+   for (const auto& [ssid, temps] : first.temps)
+   {
+      const auto& otherTemps{ second.temps[ssid] };
+      const auto  common{ std::min(temps.size(), otherTemps.size()) };
+      ASSERT_LT(0, common);
+      ASSERT_TRUE(std::equal(temps.begin(), temps.begin() + common, otherTemps.begin())) << "ssid=[" << ssid << "]";
+   }
+}
+
+TEST(LoadGeneratorUT, SendsToTempMonitor)
+{
+   constexpr size_t NUM_SUBSYSTEMS{ 1'000 };
+
+   std::vector<int> ssIds;
+   auto config{ makeConfig(NUM_SUBSYSTEMS, 10, SimulatedSubSystem::Waveform::RANDOM_WALK) };
+   for (auto& subSystem : config.subSystems)
+   {
+      // Constant temps, the max is the last subsystem's.
+      subSystem.baseTemp  = static_cast<float>(subSystem.subSystemId) / 10.0f;
+      subSystem.amplitude = 0.0f;
+      ssIds.push_back(subSystem.subSystemId);
+   }
+   const auto maxTemp{ config.subSystems.back().baseTemp };
+
+   for (auto sendMode : { LoadGeneratorConfig::SendMode::BATCH, LoadGeneratorConfig::SendMode::STREAMING })
+   {
+      TempMonitor     tm{ ssIds };
+      MaxTempListener listener;
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(listener));
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+      config.sendMode = sendMode;
+      LoadGenerator generator{ config, grpc::CreateChannel(GeneralConstants::GRPC_SERVER_ADDRESS, grpc::InsecureChannelCredentials()) };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, generator.initialize());
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, generator.start());
+
+      ASSERT_EQ(maxTemp, listener.waitForTemp(maxTemp));
+
+      // First temps are staggered over one period, give every subsystem time to send.
+      std::this_thread::sleep_for(std::chrono::milliseconds(30));
+      generator.stop();
+
+      const auto stats{ generator.getStats() };
+      ASSERT_LE(NUM_SUBSYSTEMS, stats.samplesSent);
+      ASSERT_EQ(0, stats.sendFailures);
+
+      tm.unregisterListener(listener);
+   }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "MaxTempTracker.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST(MaxTempTrackerUT, ctor)
+{
+   ASSERT_NO_THROW(
+   {
+      MaxTempTracker tracker{ 10 };
+      ASSERT_EQ(10, tracker.getSize());
+      ASSERT_FALSE(tracker.hasMax());
+      ASSERT_FALSE(tracker.isSet(0));
+   });
+}
+
+TEST(MaxTempTrackerUT, MaxFollowsUpdates)
+{
+   MaxTempTracker tracker{ 5 };
+
+   tracker.update(0, 37.48f);
+   ASSERT_TRUE(tracker.hasMax());
+   ASSERT_EQ(37.48f, tracker.getMax());
+
+   tracker.update(1, 40.0f);
+   ASSERT_EQ(40.0f, tracker.getMax());
+
+   // Lowering the max slot exposes the next highest.
+   tracker.update(1, 37.0f);
+   ASSERT_EQ(37.48f, tracker.getMax());
+
+   // Zero and negative temps are valid temps.
+   tracker.update(0, -5.0f);
+   tracker.update(1, 0.0f);
+   ASSERT_EQ(0.0f, tracker.getMax());
+}
+
+TEST(MaxTempTrackerUT, AddSlot)
+{
+   MaxTempTracker tracker{ 3 };
+   tracker.update(2, 30.0f);
+
+   // Grows past the initial number of leaves, existing temps are kept.
+   for (size_t x{ 3 }; x < 20; ++x)
+   {
+      ASSERT_EQ(x, tracker.addSlot());
+   }
+   ASSERT_EQ(20, tracker.getSize());
+   ASSERT_EQ(30.0f, tracker.getMax());
+
+   tracker.update(19, 75.0f);
+   ASSERT_EQ(75.0f, tracker.getMax());
+   ASSERT_EQ(30.0f, tracker.get(2));
+}
+
+TEST(MaxTempTrackerUT, MatchesLinearScan)
+{
+   const size_t NUM_SLOTS{ 1000 };
+   MaxTempTracker tracker{ NUM_SLOTS };
+   std::vector<float> temps(NUM_SLOTS, 0.0f);
+   for (size_t x{ 0 }; x < NUM_SLOTS; ++x)
+   {
+      tracker.update(x, 0.0f);
+   }
+
+   std::mt19937 rng{ 1234 };
+   std::uniform_int_distribution<size_t> slotDist(0, NUM_SLOTS - 1);
+   std::uniform_real_distribution<float> tempDist(20.0f, 80.0f);
+
+   for (int x{ 0 }; x < 10000; ++x)
+   {
+      const auto slot{ slotDist(rng) };
+      temps[slot] = tempDist(rng);
+      tracker.update(slot, temps[slot]);
+      ASSERT_EQ(*std::max_element(temps.begin(), temps.end()), tracker.getMax());
+   }
+}
@@ -0,0 +1,250 @@
+#include "gtest/gtest.h"
+#include "MpscRingBuffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST(MpscRingBufferUT, ctor)
+{
+   ASSERT_NO_THROW(
+   {
+      MpscRingBuffer<int> ring{ 100 };
+      ASSERT_EQ(128, ring.getCapacity());
+      ASSERT_TRUE(ring.empty());
+      ASSERT_EQ(0, ring.size());
+   });
+}
+
+TEST(MpscRingBufferUT, PushPopFifo)
+{
+   MpscRingBuffer<int> ring{ 8 };
+
+   for (int x{ 0 }; x < 8; ++x)
+   {
+      ASSERT_TRUE(ring.tryPush(x));
+   }
+
+   // Full
+   ASSERT_FALSE(ring.tryPush(99));
+   ASSERT_EQ(8, ring.size());
+
+   int value{ -1 };
+   for (int x{ 0 }; x < 8; ++x)
+   {
+      ASSERT_TRUE(ring.tryPop(value));
+      ASSERT_EQ(x, value);
+   }
+
+   ASSERT_FALSE(ring.tryPop(value));
+   ASSERT_TRUE(ring.empty());
+
+   // Slots are re-usable on the next lap.
+   ASSERT_TRUE(ring.tryPush(42));
+   ASSERT_TRUE(ring.tryPop(value));
+   ASSERT_EQ(42, value);
+}
+
+TEST(MpscRingBufferUT, MultipleProducers)
+{
+   const int NUM_PRODUCERS{ 4 };
+   const int ITEMS_PER_PRODUCER{ 10000 };
+
+   MpscRingBuffer<std::pair<int, int>> ring{ 256 };
+
+   std::vector<std::thread> producers;
+   for (int p{ 0 }; p < NUM_PRODUCERS; ++p)
+   {
+      producers.emplace_back([&ring, p, ITEMS_PER_PRODUCER]()
+      {
+         for (int x{ 0 }; x < ITEMS_PER_PRODUCER; ++x)
+         {
+            while (!ring.tryPush(std::make_pair(p, x)))
+            {
+               std::this_thread::yield();
+            }
+         }
+      });
+   }
+
+   // Items from one producer must come out in the order they went in.
+   std::vector<int> nextExpected(NUM_PRODUCERS, 0);
+   int received{ 0 };
+   std::pair<int, int> item;
+   while (received < (NUM_PRODUCERS * ITEMS_PER_PRODUCER))
+   {
+      if (ring.tryPop(item))
+      {
+         ASSERT_EQ(nextExpected[item.first], item.second);
+         ++nextExpected[item.first];
+         ++received;
+      }
+   }
+
+   for (auto& producer : producers)
+   {
+      producer.join();
+   }
+
+   ASSERT_TRUE(ring.empty());
+}
+
+TEST(MpscRingBufferUT, PushBatch)
+{
+   MpscRingBuffer<int> ring{ 8 };
+
+   const int batch[]{ 1, 2, 3, 4, 5 };
+   ASSERT_TRUE(ring.tryPushBatch(batch, 5));
+   ASSERT_EQ(5, ring.size());
+
+   // All or nothing: 5 more do not fit, 3 do.
+   ASSERT_FALSE(ring.tryPushBatch(batch, 5));
+   ASSERT_EQ(5, ring.size());
+   ASSERT_TRUE(ring.tryPushBatch(batch, 3));
+
+   // Larger than the ring.
+   const std::vector<int> tooBig(9, 0);
+   ASSERT_FALSE(ring.tryPushBatch(tooBig.data(), tooBig.size()));
+
+   int value{ -1 };
+   for (int expected : { 1, 2, 3, 4, 5, 1, 2, 3 })
+   {
+      ASSERT_TRUE(ring.tryPop(value));
+      ASSERT_EQ(expected, value);
+   }
+   ASSERT_TRUE(ring.empty());
+
+   // Batch wrapping around the end of the ring.
+   ASSERT_TRUE(ring.tryPushBatch(batch, 5));
+   for (int expected : { 1, 2, 3, 4, 5 })
+   {
+      ASSERT_TRUE(ring.tryPop(value));
+      ASSERT_EQ(expected, value);
+   }
+}
+
+TEST(MpscRingBufferUT, MultipleBatchProducers)
+{
+   const int NUM_PRODUCERS{ 4 };
+   const int BATCHES_PER_PRODUCER{ 2000 };
+   const int BATCH_SIZE{ 5 };
+
+   MpscRingBuffer<std::pair<int, int>> ring{ 64 };
+
+   std::vector<std::thread> producers;
+   for (int p{ 0 }; p < NUM_PRODUCERS; ++p)
+   {
+      producers.emplace_back([&ring, p, BATCHES_PER_PRODUCER, BATCH_SIZE]()
+      {
+         std::pair<int, int> batch[BATCH_SIZE];
+         for (int b{ 0 }; b < BATCHES_PER_PRODUCER; ++b)
+         {
+            for (int x{ 0 }; x < BATCH_SIZE; ++x)
+            {
+               batch[x] = std::make_pair(p, (b * BATCH_SIZE) + x);
+            }
+            while (!ring.tryPushBatch(batch, BATCH_SIZE))
+            {
+               std::this_thread::yield();
+            }
+         }
+      });
+   }
+
+   // Batches from one producer come out in the order they went in.
+   std::vector<int> nextExpected(NUM_PRODUCERS, 0);
+   int received{ 0 };
+   std::pair<int, int> item;
+   while (received < (NUM_PRODUCERS * BATCHES_PER_PRODUCER * BATCH_SIZE))
+   {
+      if (ring.tryPop(item))
+      {
+         ASSERT_EQ(nextExpected[item.first], item.second);
+         ++nextExpected[item.first];
+         ++received;
+      }
+   }
+
+   for (auto& producer : producers)
+   {
+      producer.join();
+   }
+
+   ASSERT_TRUE(ring.empty());
+}
+
+TEST(MpscRingBufferUT, PushEvictOldest)
+{
+   MpscRingBuffer<int> ring{ 4 };
+
+   for (int x{ 0 }; x < 4; ++x)
+   {
+      ASSERT_EQ(0, ring.pushEvictOldest(x));
+   }
+
+   // Full, each push evicts the oldest element.
+   ASSERT_EQ(1, ring.pushEvictOldest(4));
+   ASSERT_EQ(1, ring.pushEvictOldest(5));
+
+   const int batch[]{ 6, 7, 8 };
+   ASSERT_EQ(3, ring.pushBatchEvictOldest(batch, 3));
+
+   int value{ -1 };
+   for (int expected : { 5, 6, 7, 8 })
+   {
+      ASSERT_TRUE(ring.tryPop(value));
+      ASSERT_EQ(expected, value);
+   }
+   ASSERT_TRUE(ring.empty());
+}
+
+
+TEST(MpscRingBufferUT, ConcurrentEvictOldest)
+{
+   const int NUM_ROUNDS{ 10 };
+   const int NUM_PRODUCERS{ 8 };
+   const int PUSHES_PER_PRODUCER{ 50000 };
+   const int BATCH_SIZE{ 3 };
+
+   for (int round{ 0 }; round < NUM_ROUNDS; ++round)
+   {
+      // Small ring, always full: single and batch producers evict (pop)
+      // concurrently with each other, so slots are freed out of order.
+      MpscRingBuffer<int> ring{ 8 };
+
+      std::atomic<uint64_t> evicted{ 0 };
+      std::vector<std::thread> producers;
+      for (int p{ 0 }; p < NUM_PRODUCERS; ++p)
+      {
+         producers.emplace_back([&, p]()
+         {
+            const int batch[BATCH_SIZE]{ p, p, p };
+            uint64_t count{ 0 };
+            for (int x{ 0 }; x < PUSHES_PER_PRODUCER; ++x)
+            {
+               count += (0 == (p % 2)) ? ring.pushEvictOldest(p) : ring.pushBatchEvictOldest(batch, BATCH_SIZE);
+            }
+            evicted += count;
+         });
+      }
+
+      for (auto& producer : producers)
+      {
+         producer.join();
+      }
+
+      uint64_t remaining{ 0 };
+      int item{ 0 };
+      while (ring.tryPop(item))
+      {
+         ++remaining;
+      }
+
+      // Every element was either evicted or is still queued, none got stuck.
+      const uint64_t pushed{ (NUM_PRODUCERS / 2) * PUSHES_PER_PRODUCER * (1 + BATCH_SIZE) };
+      ASSERT_EQ(pushed, remaining + evicted);
+      ASSERT_TRUE(ring.empty());
+      ASSERT_EQ(0, ring.size());
+   }
+}
\ No newline at end of file
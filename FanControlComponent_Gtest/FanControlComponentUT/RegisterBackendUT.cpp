@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "RegisterBackend.h"
+#include "MappedRegisterBackend.h"
+#include "FanRegisters.h"
+#include "FanActuationPlan.h"
+#include "FanConstants.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+TEST(RegisterBackendUT, MemoryBackendRecordsWrites)
+{
+   auto backend{ std::make_shared<MemoryRegisterBackend>() };
+   FanRegisters fr{ FanConstants::FAN_REGISTER_ADDRESSES, backend };
+
+   ASSERT_EQ(FanConstants::FAN_REGISTER_ADDRESSES.size(), backend->size());
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fr.checkFanIds({ 1, 2, 21 }));
+
+   fr.writeRegister(1, 123);
+   fr.writeRegister(21, 456);
+
+   ASSERT_EQ(123, backend->peek(FanConstants::FAN_REGISTER_ADDRESSES.at(1)));
+   ASSERT_EQ(456, backend->peek(FanConstants::FAN_REGISTER_ADDRESSES.at(21)));
+   ASSERT_EQ(0, backend->peek(FanConstants::FAN_REGISTER_ADDRESSES.at(2)));
+   ASSERT_EQ(123, fr.readRegister(1));
+}
+
+TEST(RegisterBackendUT, MappedBackendNotOpen)
+{
+   MappedRegisterBackend backend{ "unused", 0x1000, 4096 };
+
+   ASSERT_FALSE(backend.isOpen());
+   ASSERT_EQ(nullptr, backend.resolve(0x1000));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <unistd.h>
+
+namespace
+{
+   std::vector<uint32_t> readWords(const std::string& path, size_t offset, size_t count)
+   {
+      std::vector<uint32_t> rVal(count, 0);
+      std::ifstream file(path, std::ios::binary);
+      file.seekg(static_cast<std::streamoff>(offset));
+      file.read(reinterpret_cast<char*>(rVal.data()), static_cast<std::streamsize>(count * sizeof(uint32_t)));
+      return rVal;
+   }
+}
+
+TEST(RegisterBackendUT, MappedBackendFile)
+{
+   const std::string path{ "/tmp/RegisterBackendUT_" + std::to_string(::getpid()) };
+   constexpr uint64_t BASE{ 0xB200'F000 };
+   constexpr size_t   FILE_OFFSET{ 100 }; // Not page aligned.
+
+   {
+      auto backend{ std::make_shared<MappedRegisterBackend>(path, BASE, 4096, FILE_OFFSET, true) };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, backend->open());
+
+      ASSERT_EQ(nullptr, backend->resolve(BASE - 4));
+      ASSERT_EQ(nullptr, backend->resolve(BASE + 4096));
+      ASSERT_EQ(nullptr, backend->resolve(BASE + 2));
+      ASSERT_NE(nullptr, backend->resolve(BASE + 4092));
+
+      FanRegisters fr{ FanConstants::FAN_REGISTER_ADDRESSES, backend };
+      std::vector<int> fanIds{ 1, 2, 21 };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fr.checkFanIds(fanIds));
+
+      FanActuationPlan plan;
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, plan.compile(fanIds, fr));
+      plan.apply(50);
+   }
+
+   // FAN_REGISTER_ADDRESSES: fan 1 at BASE + 0xB38, fans are 4 bytes apart.
+   auto words{ readWords(path, FILE_OFFSET + 0xB38, 21) };
+   ASSERT_EQ(50u * FanConstants::FAN_PWMC_PROPORTIONALITY.at(1), words[0]);
+   ASSERT_EQ(50u * FanConstants::FAN_PWMC_PROPORTIONALITY.at(2), words[1]);
+   ASSERT_EQ(0u, words[2]);
+   ASSERT_EQ(50u * FanConstants::FAN_PWMC_PROPORTIONALITY.at(21), words[20]);
+
+   std::remove(path.c_str());
+}
+
+TEST(RegisterBackendUT, MappedBackendAddressOutsideRegion)
+{
+   const std::string path{ "/tmp/RegisterBackendUT_small_" + std::to_string(::getpid()) };
+
+   auto backend{ std::make_shared<MappedRegisterBackend>(path, 0xB200'FB38, 8, 0, true) };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, backend->open());
+
+   FanRegisters fr{ FanConstants::FAN_REGISTER_ADDRESSES, backend };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, fr.checkFanIds({ 1, 2 }));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::NO_FAN_REGISTER, fr.checkFanIds({ 1, 3 }));
+
+   fr.writeRegister(3, 10); // No register, ignored.
+   ASSERT_EQ(0, fr.readRegister(3));
+
+   std::remove(path.c_str());
+}
+
+TEST(RegisterBackendUT, MappedBackendMissingFile)
+{
+   MappedRegisterBackend backend{ "/nonexistent/RegisterBackendUT", 0, 4096 };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::REGISTER_BACKEND_OPEN_FAILED, backend.open());
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "gtest/gtest.h"
+#include "SharedTempTable.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+   struct Sample
+   {
+      int      subSysId{ 0 };
+      float    temp{ 0.0f };
+      int64_t  sampleTimeNs{ 0 };
+      uint64_t sequenceNum{ 0 };
+   };
+
+   std::vector<Sample> pollAll(SharedTempTable& table)
+   {
+      std::vector<Sample> rVal;
+      table.poll([&rVal](int subSysId, float temp, int64_t sampleTimeNs, uint64_t sequenceNum)
+      {
+         rVal.push_back({ subSysId, temp, sampleTimeNs, sequenceNum });
+      });
+      return rVal;
+   }
+}
+
+TEST(SharedTempTableUT, NotOpen)
+{
+   SharedTempTable table{ "/SharedTempTableUT_unused" };
+
+   ASSERT_FALSE(table.isOpen());
+   ASSERT_EQ(0, table.getSize());
+   ASSERT_FALSE(table.publish(0, 1, 30.0f));
+   ASSERT_TRUE(pollAll(table).empty());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <unistd.h>
+
+namespace
+{
+   std::string tableName(const std::string& test)
+   {
+      return "/SharedTempTableUT_" + test + "_" + std::to_string(::getpid());
+   }
+}
+
+TEST(SharedTempTableUT, OpenMissingTable)
+{
+   SharedTempTable writer{ tableName("missing") };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SHARED_TEMP_TABLE_OPEN_FAILED, writer.open());
+   ASSERT_FALSE(writer.isOpen());
+}
+
+TEST(SharedTempTableUT, PublishPoll)
+{
+   const auto name{ tableName("publish") };
+   SharedTempTable reader{ name };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, reader.create(4));
+   ASSERT_EQ(4, reader.getSize());
+   ASSERT_TRUE(pollAll(reader).empty());
+
+   // The writer has a mapping of its own, as it would in another process.
+   SharedTempTable writer{ name };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, writer.open());
+   ASSERT_EQ(4, writer.getSize());
+
+   ASSERT_TRUE(writer.publish(0, 10, 30.0f));
+   ASSERT_TRUE(writer.publish(3, 13, 45.5f, 1234, 7));
+   ASSERT_FALSE(writer.publish(4, 14, 50.0f));
+
+   auto samples{ pollAll(reader) };
+   ASSERT_EQ(2, samples.size());
+   ASSERT_EQ(10, samples[0].subSysId);
+   ASSERT_EQ(30.0f, samples[0].temp);
+   ASSERT_EQ(0, samples[0].sampleTimeNs);
+   ASSERT_EQ(13, samples[1].subSysId);
+   ASSERT_EQ(45.5f, samples[1].temp);
+   ASSERT_EQ(1234, samples[1].sampleTimeNs);
+   ASSERT_EQ(7, samples[1].sequenceNum);
+
+   // Nothing new; then only the latest temp of a slot is seen.
+   ASSERT_TRUE(pollAll(reader).empty());
+   writer.publish(0, 10, 31.0f);
+   writer.publish(0, 10, 32.0f);
+   samples = pollAll(reader);
+   ASSERT_EQ(1, samples.size());
+   ASSERT_EQ(32.0f, samples[0].temp);
+}
+
+TEST(SharedTempTableUT, CreateReplacesStaleTable)
+{
+   const auto name{ tableName("stale") };
+   SharedTempTable reader{ name };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, reader.create(2));
+
+   SharedTempTable writer{ name };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, writer.open());
+   writer.publish(1, 5, 40.0f);
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, reader.create(8));
+   ASSERT_TRUE(pollAll(reader).empty());
+
+   SharedTempTable newWriter{ name };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, newWriter.open());
+   ASSERT_EQ(8, newWriter.getSize());
+
+   // The reader removes the table on close.
+   reader.close();
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SHARED_TEMP_TABLE_OPEN_FAILED, SharedTempTable{ name }.open());
+}
+
+TEST(SharedTempTableUT, WriterWakesReader)
+{
+   const auto name{ tableName("wake") };
+   SharedTempTable reader{ name };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, reader.create(2));
+
+   SharedTempTable writer{ name };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, writer.open());
+
+   std::atomic<float> received{ 0.0f };
+   std::thread readerThread([&]()
+   {
+      const auto start{ std::chrono::steady_clock::now() };
+      while ((0.0f == received) && ((std::chrono::steady_clock::now() - start) < std::chrono::seconds(5)))
+      {
+         auto onSample = [&](int, float temp, int64_t, uint64_t) { received = temp; };
+         if (0 != reader.poll(onSample))
+         {
+            continue;
+         }
+
+         const auto key{ reader.prepareWait() };
+         if (0 != reader.poll(onSample))
+         {
+            reader.cancelWait();
+         }
+         else
+         {
+            reader.commitWait(key, 10'000);
+         }
+      }
+   });
+
+   std::this_thread::sleep_for(std::chrono::milliseconds(20));
+   const auto published{ std::chrono::steady_clock::now() };
+   writer.publish(1, 2, 55.0f);
+   readerThread.join();
+
+   ASSERT_EQ(55.0f, received);
+   // Woken by the writer, not by the 10s wait timeout.
+   ASSERT_LT(std::chrono::steady_clock::now() - published, std::chrono::seconds(5));
+}
+
+TEST(SharedTempTableUT, ConcurrentWriters)
+{
+   const int NUM_WRITERS{ 4 };
+   const int WRITES_PER_WRITER{ 20000 };
+
+   const auto name{ tableName("concurrent") };
+   SharedTempTable reader{ name };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, reader.create(NUM_WRITERS));
+
+   // Every writer publishes temp == sequenceNum, so a torn read shows up as a mismatch.
+   std::atomic<bool> torn{ false };
+   std::atomic<int>  done{ 0 };
+   std::vector<std::thread> writers;
+   for (int w{ 0 }; w < NUM_WRITERS; ++w)
+   {
+      writers.emplace_back([&, w]()
+      {
+         SharedTempTable writer{ name };
+         if (GeneralConstants::ReturnCodes::SUCCESS == writer.open())
+         {
+            for (int x{ 1 }; x <= WRITES_PER_WRITER; ++x)
+            {
+               writer.publish(static_cast<size_t>(w), w, static_cast<float>(x), x, static_cast<uint64_t>(x));
+            }
+         }
+         ++done;
+      });
+   }
+
+   std::vector<float> last(NUM_WRITERS, 0.0f);
+   auto check = [&](int subSysId, float temp, int64_t sampleTimeNs, uint64_t sequenceNum)
+   {
+      if ((temp != static_cast<float>(sequenceNum)) || (sampleTimeNs != static_cast<int64_t>(sequenceNum)) ||
+          (temp < last[subSysId]))
+      {
+         torn = true;
+      }
+      last[subSysId] = temp;
+   };
+
+   while (NUM_WRITERS != done)
+   {
+      reader.poll(check);
+   }
+   reader.poll(check);
+
+   for (auto& writer : writers)
+   {
+      writer.join();
+   }
+
+   ASSERT_FALSE(torn);
+   for (auto temp : last)
+   {
+      ASSERT_EQ(static_cast<float>(WRITES_PER_WRITER), temp);
+   }
+}
+
+#endif
\ No newline at end of file
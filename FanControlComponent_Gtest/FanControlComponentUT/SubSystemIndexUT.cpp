@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include "SubSystemIndex.h"
+
+#include <climits>
+#include <vector>
+
+TEST(SubSystemIndexUT, DenseIds)
+{
+   SubSystemIndex index{ { 10, 11, 12, 13, 14 } };
+
+   ASSERT_TRUE(index.isDense());
+   ASSERT_EQ(5, index.getSize());
+   ASSERT_EQ(0, index.find(10));
+   ASSERT_EQ(4, index.find(14));
+   ASSERT_EQ(SubSystemIndex::NOT_FOUND, index.find(9));
+   ASSERT_EQ(SubSystemIndex::NOT_FOUND, index.find(15));
+   ASSERT_EQ(SubSystemIndex::NOT_FOUND, index.find(INT_MIN));
+   ASSERT_EQ(SubSystemIndex::NOT_FOUND, index.find(INT_MAX));
+}
+
+TEST(SubSystemIndexUT, SparseIds)
+{
+   const std::vector<int> ids{ INT_MIN, -7, 0, 1000, 123456789, INT_MAX };
+   SubSystemIndex index{ ids };
+
+   ASSERT_FALSE(index.isDense());
+   ASSERT_EQ(ids.size(), index.getSize());
+   for (size_t idx{ 0 }; idx < ids.size(); ++idx)
+   {
+      ASSERT_EQ(idx, index.find(ids[idx]));
+   }
+   ASSERT_EQ(SubSystemIndex::NOT_FOUND, index.find(1));
+   ASSERT_EQ(SubSystemIndex::NOT_FOUND, index.find(-8));
+   ASSERT_FALSE(index.contains(999));
+}
+
+TEST(SubSystemIndexUT, DuplicateIdsKeepFirstSlot)
+{
+   SubSystemIndex dense{ { 3, 1, 3, 2 } };
+   ASSERT_EQ(3, dense.getSize());
+   ASSERT_EQ(0, dense.find(3));
+   ASSERT_EQ(1, dense.find(1));
+   ASSERT_EQ(2, dense.find(2));
+
+   SubSystemIndex sparse{ { 5000000, 1, 5000000, 2 } };
+   ASSERT_FALSE(sparse.isDense());
+   ASSERT_EQ(3, sparse.getSize());
+   ASSERT_EQ(0, sparse.find(5000000));
+   ASSERT_EQ(2, sparse.find(2));
+}
+
+TEST(SubSystemIndexUT, NoIds)
+{
+   SubSystemIndex index{ std::vector<int>{} };
+   ASSERT_EQ(0, index.getSize());
+   ASSERT_FALSE(index.contains(0));
+}
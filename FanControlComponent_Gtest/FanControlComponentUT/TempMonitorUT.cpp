@@ -2,15 +2,24 @@
 #include "TempMonitor.h"
 #include "SubSystem.h"
 
+#include <mutex>
+#include <vector>
+
 namespace
 {
    class GenericListener final : public TempMonitorListener
    {
-      float curTemp{ 0 };
+      std::atomic<float> curTemp{ 0 };
+      std::mutex         historyMux;
+      std::vector<float> history;
    public:
       GenericListener(){};
       void notifyNewMaxTemp(float temp)
       { 
+         {
+            const std::lock_guard<std::mutex> lock(historyMux);
+            history.push_back(temp);
+         }
          curTemp = temp;
       };
 
@@ -18,6 +27,24 @@ namespace
       {
          return curTemp;
       };
+
+      // Every temp notified so far, oldest first.
+      std::vector<float> getHistory()
+      {
+         const std::lock_guard<std::mutex> lock(historyMux);
+         return history;
+      };
+
+      // Temps are processed on the TempMonitor thread, after the RPC has
+      // returned. Give it a moment to catch up before reading.
+      float waitForTemp(float expected)
+      {
+         for (int x{ 0 }; (x < 100) && (expected != curTemp); ++x)
+         {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         }
+         return curTemp;
+      };
    };
 };
 
@@ -68,7 +95,7 @@ TEST(TempMonitorUT, SendReceiveTemp)
    auto temp{37.48f};
    tmg.sendTemp(temp);
 
-   ASSERT_EQ(temp, gl.getCurTemp());
+   ASSERT_EQ(temp, gl.waitForTemp(temp));
 
    ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
 }
@@ -93,34 +120,529 @@ TEST(TempMonitorUT, CheckMaxTempNotification)
    // Max is testTemp
    auto testTemp{ 37.48f };
    tmg1.sendTemp(testTemp);
-   ASSERT_EQ(testTemp, gl.getCurTemp());
+   ASSERT_EQ(testTemp, gl.waitForTemp(testTemp));
 
-   // Max is testTemp
+   // A lower temp leaves the max alone and so notifies nothing, which cannot
+   // be waited for. Samples are processed in order, so a higher sentinel sent
+   // afterwards must be the next notification; then the sentinel subsystem
+   // drops back and the max is testTemp again.
    auto testTemp2{ 37.00f };
-   tmg2.sendTemp(testTemp2);
-   ASSERT_EQ(testTemp, gl.getCurTemp());
+   auto sentinelTemp{ 50.00f };
+   SubSystem tmgSentinel(channel, ssIds[9]);
+   auto checkMaxUnchanged = [&](SubSystem& tmg)
+   {
+      const auto before{ gl.getHistory().size() };
+      tmg.sendTemp(testTemp2);
+      tmgSentinel.sendTemp(sentinelTemp);
+      ASSERT_EQ(sentinelTemp, gl.waitForTemp(sentinelTemp));
+      const auto history{ gl.getHistory() };
+      ASSERT_EQ(std::vector<float>({ sentinelTemp }), std::vector<float>(history.begin() + before, history.end()));
+
+      tmgSentinel.sendTemp(testTemp2);
+      ASSERT_EQ(testTemp, gl.waitForTemp(testTemp));
+   };
 
    // Max is testTemp
-   tmg3.sendTemp(testTemp2);
-   ASSERT_EQ(testTemp, gl.getCurTemp());
+   checkMaxUnchanged(tmg2);
 
    // Max is testTemp
-   tmg4.sendTemp(testTemp2);
-   ASSERT_EQ(testTemp, gl.getCurTemp());
+   checkMaxUnchanged(tmg3);
+
+   // Max is testTemp
+   checkMaxUnchanged(tmg4);
 
    // Max is testTemp3: Overwrite ssid 2 with testTemp3
    auto testTemp3{ 40.00f };
    tmg2.sendTemp(testTemp3);
-   ASSERT_EQ(testTemp3, gl.getCurTemp());
+   ASSERT_EQ(testTemp3, gl.waitForTemp(testTemp3));
 
    // Max is testTemp again: Overwrite ssid 2 with testTemp2
    tmg2.sendTemp(testTemp2);
-   ASSERT_EQ(testTemp, gl.getCurTemp());
+   ASSERT_EQ(testTemp, gl.waitForTemp(testTemp));
 
    // New Max is testTemp4: new ssid with highest temp.
    auto testTemp4{ 75.00f };
    tmg5.sendTemp(testTemp4);
-   ASSERT_EQ(testTemp4, gl.getCurTemp());
+   ASSERT_EQ(testTemp4, gl.waitForTemp(testTemp4));
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
+}
+
+TEST(TempMonitorUT, CoalescingMaxTempNotification)
+{
+   const std::vector<int> ssIds{ 1,2,3,4,5,6,7,8,9,10 };
+   TempMonitorConfig config;
+   config.ingestionMode = TempMonitorConfig::IngestionMode::COALESCING;
+   TempMonitor tm{ ssIds, config };
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   SubSystem tmg1(channel, ssIds[0]);
+   SubSystem tmg2(channel, ssIds[1]);
+   SubSystem tmgUnknown(channel, 99);
+
+   GenericListener gl;
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(gl));
+
+   auto testTemp{ 37.48f };
+   tmg1.sendTemp(testTemp);
+   ASSERT_EQ(testTemp, gl.waitForTemp(testTemp));
+
+   // Only the last sample of a burst matters.
+   for (auto temp : { 60.0f, 55.0f, 41.0f })
+   {
+      tmg2.sendTemp(temp);
+   }
+   ASSERT_EQ(41.0f, gl.waitForTemp(41.0f));
+
+   // Unknown ids still go through the ring.
+   auto testTemp2{ 75.00f };
+   tmgUnknown.sendTemp(testTemp2);
+   ASSERT_EQ(testTemp2, gl.waitForTemp(testTemp2));
 
    ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
-}
\ No newline at end of file
+}
+
+TEST(TempMonitorUT, OverflowPolicies)
+{
+   const std::vector<int> ssIds{ 1,2,3 };
+   TempMonitorSink::SubSysIdAndTemp idTemp;
+   TempMonitorSink::empty_param     noResponse;
+
+   // The tempThread is not started (no initialize), so nothing drains the ring.
+   auto fill = [&](TempMonitor& tm, int count)
+   {
+      TempMonitorSink::TempMonitorServer::Service& service{ tm };
+      grpc::Status rVal;
+      for (int x{ 0 }; x < count; ++x)
+      {
+         idTemp.set_subsysid(ssIds[x % ssIds.size()]);
+         idTemp.set_temp(static_cast<float>(x));
+         rVal = service.UpdateSubSystemTemp(nullptr, &idTemp, &noResponse);
+      }
+      return rVal;
+   };
+
+   TempMonitorConfig config;
+   config.queueCapacity = 8;
+
+   {
+      TempMonitor tm{ ssIds, config };
+      ASSERT_TRUE(fill(tm, 8).ok());
+      ASSERT_EQ(grpc::StatusCode::RESOURCE_EXHAUSTED, fill(tm, 1).error_code());
+
+      const auto stats{ tm.getQueueStats() };
+      ASSERT_EQ(8, stats.capacity);
+      ASSERT_EQ(8, stats.depth);
+      ASSERT_EQ(8, stats.peakDepth);
+      ASSERT_EQ(1, stats.rejected);
+      ASSERT_EQ(0, stats.droppedNewest + stats.droppedOldest);
+   }
+
+   config.overflowPolicy = TempMonitorConfig::OverflowPolicy::DROP_NEWEST;
+   {
+      TempMonitor tm{ ssIds, config };
+      ASSERT_TRUE(fill(tm, 10).ok());
+
+      const auto stats{ tm.getQueueStats() };
+      ASSERT_EQ(8, stats.depth);
+      ASSERT_EQ(2, stats.droppedNewest);
+      ASSERT_EQ(0, stats.rejected + stats.droppedOldest);
+   }
+
+   config.overflowPolicy = TempMonitorConfig::OverflowPolicy::DROP_OLDEST;
+   {
+      TempMonitor tm{ ssIds, config };
+      TempMonitorSink::TempMonitorServer::Service& service{ tm };
+      ASSERT_TRUE(fill(tm, 10).ok());
+
+      // A batch larger than the ring keeps its newest elements.
+      TempMonitorSink::SubSysIdsAndTemps idsTemps;
+      for (int x{ 0 }; x < 12; ++x)
+      {
+         idsTemps.add_subsysids(ssIds[0]);
+         idsTemps.add_temps(static_cast<float>(x));
+      }
+      ASSERT_TRUE(service.UpdateSubSystemTempsBatch(nullptr, &idsTemps, &noResponse).ok());
+
+      const auto stats{ tm.getQueueStats() };
+      ASSERT_EQ(8, stats.depth);
+      ASSERT_EQ(2 + 12, stats.droppedOldest);
+      ASSERT_EQ(0, stats.rejected + stats.droppedNewest);
+   }
+}
+
+TEST(TempMonitorUT, QueueWatermarks)
+{
+   const std::vector<int> ssIds{ 1,2,3 };
+   TempMonitorConfig config;
+   config.queueCapacity = 8;
+
+   {
+      config.queueLowWatermarkPct  = 90;
+      config.queueHighWatermarkPct = 80;
+      TempMonitor tm{ ssIds, config };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::TEMP_MONITOR_INVALID_CONFIG, tm.initialize());
+   }
+
+   config.queueLowWatermarkPct  = 50;
+   config.queueHighWatermarkPct = 80;
+   TempMonitor tm{ ssIds, config };
+   TempMonitorSink::TempMonitorServer::Service& service{ tm };
+
+   // Fill the ring before the tempThread starts, so its first drain sees it full.
+   TempMonitorSink::SubSysIdAndTemp idTemp;
+   TempMonitorSink::empty_param     noResponse;
+   for (int x{ 1 }; x <= 8; ++x)
+   {
+      idTemp.set_subsysid(ssIds[x % ssIds.size()]);
+      idTemp.set_temp(static_cast<float>(x));
+      ASSERT_TRUE(service.UpdateSubSystemTemp(nullptr, &idTemp, &noResponse).ok());
+   }
+
+   GenericListener gl;
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(gl));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+   ASSERT_EQ(8.0f, gl.waitForTemp(8.0f));
+
+   const auto stats{ tm.getQueueStats() };
+   ASSERT_EQ(8, stats.peakDepth);
+   ASSERT_EQ(1, stats.watermarkEvents);
+   ASSERT_EQ(0, stats.depth);
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
+}
+
+TEST(TempMonitorUT, StreamingMaxTempNotification)
+{
+   const std::vector<int> ssIds{ 1,2,3,4,5,6,7,8,9,10 };
+   TempMonitor tm{ ssIds };
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   SubSystem tmg1(channel, ssIds[0], nullptr, SubSystem::SendMode::STREAMING);
+   SubSystem tmg2(channel, ssIds[1], nullptr, SubSystem::SendMode::STREAMING);
+
+   GenericListener gl;
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(gl));
+
+   auto testTemp{ 37.48f };
+   tmg1.sendTemp(testTemp);
+   ASSERT_EQ(testTemp, gl.waitForTemp(testTemp));
+
+   // Same stream, many samples.
+   for (auto temp : { 60.0f, 55.0f, 41.0f })
+   {
+      tmg2.sendTemp(temp);
+   }
+   ASSERT_EQ(41.0f, gl.waitForTemp(41.0f));
+
+   tmg1.sendTemp(75.0f);
+   ASSERT_EQ(75.0f, gl.waitForTemp(75.0f));
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
+}
+
+TEST(TempMonitorUT, AsyncSendMaxTempNotification)
+{
+   const std::vector<int> ssIds{ 1,2,3,4,5,6,7,8,9,10 };
+   TempMonitor tm{ ssIds };
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+   // Both SubSystems share one sender (and its reaper thread).
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   auto sender{ std::make_shared<AsyncTempSender>(channel) };
+   SubSystem tmg1(channel, ssIds[0], nullptr, SubSystem::SendMode::ASYNC, sender);
+   SubSystem tmg2(channel, ssIds[1], nullptr, SubSystem::SendMode::ASYNC, sender);
+
+   GenericListener gl;
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(gl));
+
+   auto testTemp{ 37.48f };
+   tmg1.sendTemp(testTemp);
+   ASSERT_EQ(testTemp, gl.waitForTemp(testTemp));
+
+   tmg2.sendTemp(75.0f);
+   ASSERT_EQ(75.0f, gl.waitForTemp(75.0f));
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
+}
+
+TEST(TempMonitorUT, BatchMaxTempNotification)
+{
+   const std::vector<int> ssIds{ 1,2,3,4,5,6,7,8,9,10 };
+   TempMonitor tm{ ssIds };
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   SubSystem boardController(channel, ssIds[0]);
+
+   GenericListener gl;
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(gl));
+
+   ASSERT_TRUE(boardController.sendTempBatch({ 1, 2, 3 }, { 37.48f, 41.0f, 30.0f }).ok());
+   ASSERT_EQ(41.0f, gl.waitForTemp(41.0f));
+
+   // Lower ssid 2, raise ssid 3.
+   ASSERT_TRUE(boardController.sendTempBatch({ 2, 3 }, { 20.0f, 39.0f }).ok());
+   ASSERT_EQ(39.0f, gl.waitForTemp(39.0f));
+
+   // Mismatched sizes are rejected and nothing is applied.
+   auto status{ boardController.sendTempBatch({ 4, 5 }, { 75.0f }) };
+   ASSERT_EQ(grpc::StatusCode::INVALID_ARGUMENT, status.error_code());
+   ASSERT_EQ(39.0f, gl.waitForTemp(75.0f));
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
+}
+
+TEST(TempMonitorUT, AsyncServerMaxTempNotification)
+{
+   const std::vector<int> ssIds{ 1,2,3,4,5,6,7,8,9,10 };
+   TempMonitorConfig config;
+   config.serverMode          = TempMonitorConfig::ServerMode::ASYNC;
+   config.asyncPollingThreads = 2;
+   config.asyncCallsPerQueue  = 2;
+   TempMonitor tm{ ssIds, config };
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+   auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+   SubSystem tmgUnary(channel, ssIds[0]);
+   SubSystem tmgStream1(channel, ssIds[1], nullptr, SubSystem::SendMode::STREAMING);
+   SubSystem tmgStream2(channel, ssIds[2], nullptr, SubSystem::SendMode::STREAMING);
+
+   GenericListener gl;
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(gl));
+
+   tmgUnary.sendTemp(37.48f);
+   ASSERT_EQ(37.48f, gl.waitForTemp(37.48f));
+
+   // More streams than armed stream calls per queue.
+   tmgStream1.sendTemp(40.0f);
+   tmgStream2.sendTemp(45.0f);
+   ASSERT_EQ(45.0f, gl.waitForTemp(45.0f));
+
+   ASSERT_TRUE(tmgUnary.sendTempBatch({ 4, 5 }, { 30.0f, 60.0f }).ok());
+   ASSERT_EQ(60.0f, gl.waitForTemp(60.0f));
+
+   auto status{ tmgUnary.sendTempBatch({ 4, 5 }, { 75.0f }) };
+   ASSERT_EQ(grpc::StatusCode::INVALID_ARGUMENT, status.error_code());
+
+   // Unary calls are re-armed after every RPC.
+   for (auto temp : { 61.0f, 62.0f, 63.0f, 64.0f, 65.0f })
+   {
+      tmgUnary.sendTemp(temp);
+   }
+   ASSERT_EQ(65.0f, gl.waitForTemp(65.0f));
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
+}
+
+
+TEST(TempMonitorUT, ThermalZoneMaxTempNotification)
+{
+   const std::vector<int> ssIds{ 1,2,3 };
+   TempMonitorConfig config;
+   config.thermalZones = { { 10, { 1, 2 }, {} }, { 20, { 2, 3 }, {} } };
+
+   TempMonitor tm{ ssIds, config };
+   TempMonitorSink::TempMonitorServer::Service& service{ tm };
+
+   GenericListener global;
+   GenericListener zone10;
+   GenericListener zone20;
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(global));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerZoneListener(10, zone10));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerZoneListener(20, zone20));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::TEMP_MONITOR_LISTENER_REG_FAILED, tm.registerZoneListener(30, zone20));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+   TempMonitorSink::SubSysIdAndTemp idTemp;
+   TempMonitorSink::empty_param     noResponse;
+   auto send = [&](int ssId, float temp)
+   {
+      idTemp.set_subsysid(ssId);
+      idTemp.set_temp(temp);
+      ASSERT_TRUE(service.UpdateSubSystemTemp(nullptr, &idTemp, &noResponse).ok());
+   };
+
+   send(1, 30.0f);
+   send(2, 40.0f);
+   send(3, 50.0f);
+   ASSERT_EQ(50.0f, global.waitForTemp(50.0f));
+   ASSERT_EQ(40.0f, zone10.waitForTemp(40.0f));
+   ASSERT_EQ(50.0f, zone20.waitForTemp(50.0f));
+
+   // Only zone 20 contains subsystem 3.
+   send(3, 20.0f);
+   ASSERT_EQ(40.0f, zone20.waitForTemp(40.0f));
+   ASSERT_EQ(40.0f, global.waitForTemp(40.0f));
+   ASSERT_EQ(40.0f, zone10.getCurTemp());
+
+   // Subsystem 2 is in both zones.
+   send(2, 60.0f);
+   ASSERT_EQ(60.0f, zone10.waitForTemp(60.0f));
+   ASSERT_EQ(60.0f, zone20.waitForTemp(60.0f));
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterZoneListener(10, zone10));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterZoneListener(20, zone20));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(global));
+}
+
+TEST(TempMonitorUT, ThermalZoneInvalidConfig)
+{
+   const std::vector<int> ssIds{ 1,2,3 };
+   TempMonitorConfig config;
+
+   config.thermalZones = { { 10, { 1, 4 }, {} } };
+   {
+      TempMonitor tm{ ssIds, config };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::TEMP_MONITOR_INVALID_CONFIG, tm.initialize());
+   }
+
+   config.thermalZones = { { 10, { 1 }, {} }, { 10, { 2 }, {} } };
+   {
+      TempMonitor tm{ ssIds, config };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::TEMP_MONITOR_INVALID_CONFIG, tm.initialize());
+   }
+
+   config.thermalZones = { { 10, {}, {} } };
+   {
+      TempMonitor tm{ ssIds, config };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::TEMP_MONITOR_INVALID_CONFIG, tm.initialize());
+   }
+}
+
+
+TEST(TempMonitorUT, SubmitInProcess)
+{
+   const std::vector<int> ssIds{ 1,2,3,4,5 };
+   TempMonitorConfig config;
+   config.serverMode = TempMonitorConfig::ServerMode::NONE;
+   TempMonitor tm{ ssIds, config };
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+   GenericListener gl;
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(gl));
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.submit(ssIds[0], 37.48f));
+   ASSERT_EQ(37.48f, gl.waitForTemp(37.48f));
+
+   const std::vector<int>   batchIds{ 2, 3 };
+   const std::vector<float> batchTemps{ 41.0f, 30.0f };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.submit(batchIds, batchTemps));
+   ASSERT_EQ(41.0f, gl.waitForTemp(41.0f));
+
+   // Mismatched sizes are rejected and nothing is applied.
+   const std::vector<float> shortTemps{ 75.0f };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::TEMP_MONITOR_INVALID_BATCH, tm.submit(batchIds, shortTemps));
+   ASSERT_EQ(41.0f, gl.waitForTemp(75.0f));
+
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
+
+   // The tempThread is not started (no initialize), so nothing drains the ring.
+   config.serverMode    = TempMonitorConfig::ServerMode::SYNC;
+   config.queueCapacity = 8;
+   TempMonitor full{ ssIds, config };
+   for (int x{ 0 }; x < 8; ++x)
+   {
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, full.submit(ssIds[x % ssIds.size()], static_cast<float>(x)));
+   }
+   ASSERT_EQ(GeneralConstants::ReturnCodes::TEMP_MONITOR_QUEUE_FULL, full.submit(ssIds[0], 1.0f));
+   ASSERT_EQ(1, full.getQueueStats().rejected);
+}
+
+TEST(TempMonitorUT, CoalescingBatchMixedIds)
+{
+   const std::vector<int> ssIds{ 1,2,3,4,5 };
+   TempMonitorConfig config;
+   config.serverMode    = TempMonitorConfig::ServerMode::NONE;
+   config.ingestionMode = TempMonitorConfig::IngestionMode::COALESCING;
+   config.queueCapacity = 8;
+
+   // The tempThread is not started yet, so nothing drains the ring. Only
+   // unknown ids use it in COALESCING mode.
+   TempMonitor tm{ ssIds, config };
+   for (int x{ 0 }; x < 8; ++x)
+   {
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.submit(100 + x, 10.0f));
+   }
+
+   // The known ids are applied, only the unknown one is dropped.
+   const std::vector<int>   batchIds{ 1, 99, 2 };
+   const std::vector<float> batchTemps{ 60.0f, 75.0f, 45.0f };
+   size_t dropped{ 0 };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::TEMP_MONITOR_BATCH_PARTIAL, tm.submit(batchIds, batchTemps, &dropped));
+   ASSERT_EQ(1, dropped);
+
+   // A batch of known ids does not need the ring at all.
+   const std::vector<int>   knownIds{ 3, 4 };
+   const std::vector<float> knownTemps{ 20.0f, 30.0f };
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.submit(knownIds, knownTemps, &dropped));
+   ASSERT_EQ(0, dropped);
+
+   GenericListener gl;
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(gl));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+   ASSERT_EQ(60.0f, gl.waitForTemp(60.0f));
+   ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
+
+   // In QUEUE mode the batch goes into the ring whole, or not at all.
+   config.ingestionMode = TempMonitorConfig::IngestionMode::QUEUE;
+   TempMonitor queued{ ssIds, config };
+   for (int x{ 0 }; x < 8; ++x)
+   {
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, queued.submit(ssIds[0], 10.0f));
+   }
+   ASSERT_EQ(GeneralConstants::ReturnCodes::TEMP_MONITOR_QUEUE_FULL, queued.submit(batchIds, batchTemps, &dropped));
+   ASSERT_EQ(batchIds.size(), dropped);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <unistd.h>
+
+TEST(TempMonitorUT, SharedTableMaxTempNotification)
+{
+   const std::vector<int> ssIds{ 1,2,3,4,5 };
+   TempMonitorConfig config;
+   config.sharedTableName  = "/TempMonitorUT_" + std::to_string(::getpid());
+   config.sharedTableSlots = ssIds.size();
+
+   for (auto wait : { TempMonitorConfig::SharedTableWait::FUTEX, TempMonitorConfig::SharedTableWait::POLL })
+   {
+      config.sharedTableWait = wait;
+      TempMonitor tm{ ssIds, config };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.initialize());
+
+      GenericListener gl;
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.registerListener(gl));
+
+      SharedTempTable sensors{ config.sharedTableName };
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, sensors.open());
+
+      ASSERT_TRUE(sensors.publish(0, ssIds[0], 37.48f));
+      ASSERT_EQ(37.48f, gl.waitForTemp(37.48f));
+
+      ASSERT_TRUE(sensors.publish(1, ssIds[1], 41.0f, SampleTrace::nowNs(), 1));
+      ASSERT_EQ(41.0f, gl.waitForTemp(41.0f));
+
+      // Side by side with the gRPC server.
+      auto channel{ grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials()) };
+      SubSystem tmg(channel, ssIds[2]);
+      tmg.sendTemp(60.0f);
+      ASSERT_EQ(60.0f, gl.waitForTemp(60.0f));
+
+      ASSERT_TRUE(sensors.publish(2, ssIds[3], 75.0f));
+      ASSERT_EQ(75.0f, gl.waitForTemp(75.0f));
+
+      ASSERT_EQ(GeneralConstants::ReturnCodes::SUCCESS, tm.unregisterListener(gl));
+   }
+}
+
+#endif
\ No newline at end of file
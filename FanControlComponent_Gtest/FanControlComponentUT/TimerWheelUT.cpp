@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "TimerWheel.h"
+
+#include <random>
+#include <vector>
+
+TEST(TimerWheelUT, ctor)
+{
+   ASSERT_NO_THROW(
+   {
+      TimerWheel wheel(10, 5);
+      ASSERT_EQ(10, wheel.getCapacity());
+      ASSERT_EQ(5, wheel.getNow());
+      ASSERT_EQ(0, wheel.getNumScheduled());
+   });
+}
+
+TEST(TimerWheelUT, ScheduleChecksId)
+{
+   TimerWheel wheel{ 2 };
+
+   ASSERT_TRUE(wheel.schedule(0, 10));
+   ASSERT_FALSE(wheel.schedule(0, 20)); // Already armed.
+   ASSERT_FALSE(wheel.schedule(2, 10)); // Out of range.
+   ASSERT_EQ(1, wheel.getNumScheduled());
+}
+
+TEST(TimerWheelUT, ExpiresOnTheirTickAcrossLevels)
+{
+   constexpr size_t   NUM_TIMERS{ 10'000 };
+   constexpr uint64_t START_TICK{ 1'000'123 }; // Not aligned to any level.
+
+   std::mt19937 rng{ 42 };
+   std::uniform_int_distribution<uint64_t> deltaDist(1, 1ull << 20); // Levels 0 to 2.
+
+   TimerWheel            wheel{ NUM_TIMERS, START_TICK };
+   std::vector<uint64_t> expiries(NUM_TIMERS);
+   for (TimerWheel::TimerId id{ 0 }; id < NUM_TIMERS; ++id)
+   {
+      expiries[id] = START_TICK + deltaDist(rng);
+      ASSERT_TRUE(wheel.schedule(id, expiries[id]));
+   }
+
+   size_t   numExpired{ 0 };
+   uint64_t lastTick{ 0 };
+   bool     wrongTick{ false };
+   bool     outOfOrder{ false };
+
+   wheel.advance(START_TICK + (1ull << 20), [&](TimerWheel::TimerId id)
+   {
+      wrongTick  |= (expiries[id] != wheel.getNow());
+      outOfOrder |= (wheel.getNow() < lastTick);
+      lastTick = wheel.getNow();
+      ++numExpired;
+   });
+
+   ASSERT_FALSE(wrongTick);
+   ASSERT_FALSE(outOfOrder);
+   ASSERT_EQ(NUM_TIMERS, numExpired);
+   ASSERT_EQ(0, wheel.getNumScheduled());
+}
+
+TEST(TimerWheelUT, TopLevelTimer)
+{
+   TimerWheel wheel{ 1, 77 };
+   const uint64_t expiry{ 77 + (1ull << 24) + 1234 };
+
+   ASSERT_TRUE(wheel.schedule(0, expiry));
+
+   uint64_t expiredAt{ 0 };
+   wheel.advance(expiry - 1, [&](TimerWheel::TimerId) { expiredAt = wheel.getNow(); });
+   ASSERT_EQ(0, expiredAt);
+
+   wheel.advance(expiry + 10, [&](TimerWheel::TimerId) { expiredAt = wheel.getNow(); });
+   ASSERT_EQ(expiry, expiredAt);
+}
+
+TEST(TimerWheelUT, RescheduleFromCallback)
+{
+   constexpr uint64_t PERIOD{ 7 };
+   TimerWheel wheel{ 1 };
+
+   ASSERT_TRUE(wheel.schedule(0, PERIOD));
+
+   size_t numExpired{ 0 };
+   wheel.advance(1000, [&](TimerWheel::TimerId id)
+   {
+      ++numExpired;
+      ASSERT_TRUE(wheel.schedule(id, wheel.getNow() + PERIOD));
+   });
+
+   ASSERT_EQ(1000 / PERIOD, numExpired);
+   ASSERT_EQ(1, wheel.getNumScheduled());
+}
+
+TEST(TimerWheelUT, PastExpiryFiresOnNextTick)
+{
+   TimerWheel wheel{ 1, 100 };
+   ASSERT_TRUE(wheel.schedule(0, 50));
+
+   uint64_t expiredAt{ 0 };
+   wheel.advance(200, [&](TimerWheel::TimerId) { expiredAt = wheel.getNow(); });
+   ASSERT_EQ(101, expiredAt);
+}
\ No newline at end of file
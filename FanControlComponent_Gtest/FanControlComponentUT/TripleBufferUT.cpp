@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "TripleBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+TEST(TripleBufferUT, LatestValueWins)
+{
+   TripleBuffer<int> buffer;
+
+   ASSERT_FALSE(buffer.update());
+   ASSERT_EQ(0, buffer.getReadBuffer());
+
+   buffer.getWriteBuffer() = 1;
+   buffer.publish();
+   buffer.getWriteBuffer() = 2;
+   buffer.publish();
+
+   // Only the latest published value is handed over, once.
+   ASSERT_TRUE(buffer.update());
+   ASSERT_EQ(2, buffer.getReadBuffer());
+   ASSERT_FALSE(buffer.update());
+   ASSERT_EQ(2, buffer.getReadBuffer());
+
+   buffer.getWriteBuffer() = 3;
+   buffer.publish();
+   ASSERT_TRUE(buffer.update());
+   ASSERT_EQ(3, buffer.getReadBuffer());
+}
+
+TEST(TripleBufferUT, ConcurrentReaderSeesWholeValuesInOrder)
+{
+   constexpr int    NUM_VALUES{ 200'000 };
+   constexpr size_t VALUE_SIZE{ 16 };
+
+   using Value = std::array<int, VALUE_SIZE>;
+   TripleBuffer<Value> buffer;
+   std::atomic<bool>   done{ false };
+
+   std::thread writer([&]()
+   {
+      for (int value{ 1 }; value <= NUM_VALUES; ++value)
+      {
+         buffer.getWriteBuffer().fill(value);
+         buffer.publish();
+      }
+      done.store(true);
+   });
+
+   int  lastSeen{ 0 };
+   bool torn{ false };
+   bool outOfOrder{ false };
+   for (;;)
+   {
+      const auto writerDone{ done.load() };
+      if (buffer.update())
+      {
+         const auto& value{ buffer.getReadBuffer() };
+         for (auto element : value)
+         {
+            torn |= (element != value[0]);
+         }
+         outOfOrder |= (value[0] <= lastSeen);
+         lastSeen = value[0];
+      }
+      else if (writerDone)
+      {
+         break;
+      }
+   }
+   writer.join();
+
+   ASSERT_FALSE(torn);
+   ASSERT_FALSE(outOfOrder);
+   ASSERT_EQ(NUM_VALUES, lastSeen);
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+#include "UiFanDataMerger.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+   class RecordingUiUpdater final : public UiUpdater
+   {
+   public:
+      std::vector<UiUpdater::FanData> updates;
+
+      void updateSubSystemTemp(int, float) override {}
+      void updateFanData(const UiUpdater::FanData& fandata) override
+      {
+         updates.push_back(fandata);
+      }
+   };
+
+   UiUpdater::FanData makeFanData(float temp, const std::vector<UiUpdater::FanPwmc>& fans)
+   {
+      UiUpdater::FanData rVal;
+      rVal.temp      = temp;
+      rVal.dutyCycle = temp / 2;
+      rVal.numFans   = fans.size();
+      std::copy(fans.begin(), fans.end(), rVal.fans.begin());
+      return rVal;
+   }
+}
+
+TEST(UiFanDataMergerUT, MergesRegions)
+{
+   RecordingUiUpdater ui;
+   UiFanDataMerger    merger{ ui };
+
+   auto global{ merger.addRegion(2, true) };
+   auto zone1{ merger.addRegion(1) };
+   auto zone2{ merger.addRegion(2) };
+
+   // Regions that have not reported yet contribute no fans.
+   zone2->updateFanData(makeFanData(90.0f, { { 5, 50 }, { 7, 70 } }));
+   ASSERT_EQ(1, ui.updates.size());
+   ASSERT_EQ(0.0f, ui.updates.back().temp);
+   ASSERT_EQ(2, ui.updates.back().numFans);
+   ASSERT_EQ(5, ui.updates.back().fans[0].fanId);
+
+   global->updateFanData(makeFanData(60.0f, { { 1, 10 }, { 2, 20 } }));
+   zone1->updateFanData(makeFanData(80.0f, { { 3, 30 } }));
+
+   // In region order; the temp and duty cycle are the summary region's.
+   const auto& merged{ ui.updates.back() };
+   ASSERT_EQ(3, ui.updates.size());
+   ASSERT_EQ(60.0f, merged.temp);
+   ASSERT_EQ(30.0f, merged.dutyCycle);
+   ASSERT_EQ(5, merged.numFans);
+
+   const std::vector<int> fanIds{ 1, 2, 3, 5, 7 };
+   for (size_t idx{ 0 }; idx < fanIds.size(); ++idx)
+   {
+      ASSERT_EQ(fanIds[idx], merged.fans[idx].fanId);
+      ASSERT_EQ(fanIds[idx] * 10, merged.fans[idx].pwmc);
+   }
+
+   // A region update replaces only that region's fans.
+   zone1->updateFanData(makeFanData(85.0f, { { 3, 35 } }));
+   ASSERT_EQ(5, ui.updates.back().numFans);
+   ASSERT_EQ(35, ui.updates.back().fans[2].pwmc);
+   ASSERT_EQ(20, ui.updates.back().fans[1].pwmc);
+   ASSERT_EQ(50, ui.updates.back().fans[3].pwmc);
+}
+
+TEST(UiFanDataMergerUT, CappedAtMaxFans)
+{
+   RecordingUiUpdater ui;
+   UiFanDataMerger    merger{ ui };
+
+   auto first{ merger.addRegion(UiUpdater::FanData::MAX_FANS - 1) };
+   auto second{ merger.addRegion(2) };
+
+   // A region reporting more fans than it reserved is truncated.
+   second->updateFanData(makeFanData(50.0f, { { 1, 10 }, { 2, 20 } }));
+   ASSERT_EQ(1, ui.updates.back().numFans);
+
+   std::vector<UiUpdater::FanPwmc> fans(UiUpdater::FanData::MAX_FANS);
+   first->updateFanData(makeFanData(50.0f, fans));
+   ASSERT_EQ(UiUpdater::FanData::MAX_FANS, ui.updates.back().numFans);
+   ASSERT_EQ(1, ui.updates.back().fans[UiUpdater::FanData::MAX_FANS - 1].fanId);
+}
\ No newline at end of file
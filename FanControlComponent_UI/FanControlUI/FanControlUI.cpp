@@ -115,17 +115,17 @@ void FanControlUI::stopSubSystems()
 void FanControlUI::updateSubSystemTemp(int ssid, float temp)
 {
    --ssid;
-   QMutexLocker locker(&fanDataMux);
+   QMutexLocker locker(&subSysDataMux);
    if( ssid < localSubSystemTemps.size())
    {
       localSubSystemTemps[ssid] = temp;
    }
 }
 
-void FanControlUI::updateFanData(UiUpdater::FanData& fandata)
+void FanControlUI::updateFanData(const UiUpdater::FanData& fandata)
 {
-   QMutexLocker locker(&fanDataMux);
-   localFanData = std::move(fandata);
+   fanDataBuffer.getWriteBuffer() = fandata;
+   fanDataBuffer.publish();
 }
 
 void FanControlUI::updateDisplay()
@@ -143,7 +143,7 @@ void FanControlUI::updateSubSysTempsDisplay()
 {
    std::vector<float> data;
    {
-      QMutexLocker locker(&fanDataMux);
+      QMutexLocker locker(&subSysDataMux);
       data = localSubSystemTemps;
    }
 
@@ -166,27 +166,28 @@ void FanControlUI::updateSubSysTempsDisplay()
 
 void FanControlUI::updatefanDataDisplay()
 {
-   UiUpdater::FanData data;
+   if( !fanDataBuffer.update() )
    {
-      QMutexLocker locker(&fanDataMux);
-      data = std::move(localFanData);
+      return; // No new fan data since the last refresh.
    }
+   const auto& data{ fanDataBuffer.getReadBuffer() };
 
    ui.numDutyCycle->display(data.dutyCycle);
    ui.numHighTemp->display(data.temp);
 
-   for( auto fan : data.fans )
+   for( size_t idx{ 0 }; idx < data.numFans; ++idx )
    {
+      const auto& fan{ data.fans[idx] };
       QString lcdName = "numPwmc";
-      if (10 > fan.first)
+      if (10 > fan.fanId)
       {
          lcdName += "0";
       }
-      lcdName += QString::number(fan.first);
+      lcdName += QString::number(fan.fanId);
       auto lcdObj = FanControlUI::findChild<QLCDNumber*>(lcdName);
       if(lcdObj)
       {
-         lcdObj->display(fan.second);
+         lcdObj->display(fan.pwmc);
       }
    }
 }
@@ -5,6 +5,7 @@
 #include "ui_FanControlUI.h"
 
 #include "FanControl.h"
+#include "TripleBuffer.h"
 #include "UiUpdater.h"
 #include "SubSystem.h"
 
@@ -14,9 +15,8 @@ class FanControlUI final : public QMainWindow, public UiUpdater
    std::vector<int>   subSystemIds; // List of SubSystem Ids
    std::vector<int>   fanIds;       // List of FanIds
 
-   QMutex fanDataMux;
    QMutex subSysDataMux;
-   UiUpdater::FanData localFanData;        // InBound fan data from FanControl
+   TripleBuffer<UiUpdater::FanData> fanDataBuffer; // InBound fan data from FanControl, lock free
    std::vector<float> localSubSystemTemps; // InBound temps from SubSystems
 
    std::vector<std::unique_ptr<SubSystem>> subSystems;        // Mock SubSystems
@@ -48,7 +48,7 @@ public:
     void initialize();
 
     void updateSubSystemTemp(int ssid, float temp);
-    void updateFanData(UiUpdater::FanData& fandata);
+    void updateFanData(const UiUpdater::FanData& fandata);
 
 private:
     Ui::FanControlUIClass ui;
@@ -21,6 +21,13 @@ rmdir x64 /s /q
 
 cd %ORIGINAL_DIR%
 
+cd .\FanControlComponent_Bench
+rmdir x64 /s /q
+cd FanControlComponentBench
+rmdir x64 /s /q
+
+cd %ORIGINAL_DIR%
+
 cd .\FanControlComponent_UI
 rmdir x64 /s /q
 cd FanControlUI